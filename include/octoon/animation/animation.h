@@ -90,12 +90,12 @@ namespace octoon::animation
 		explicit Animation(std::string_view _name) noexcept
 			: name(_name)
 		{
-			state.finish = false
+			state.finish = false;
 		}
 
 		void setName(std::string_view _name) noexcept
 		{
-			this->name = name;
+			this->name = _name;
 		}
 
 		void addClip(AnimationClip<_Elem, _Time>&& clip) noexcept
@@ -12,6 +12,7 @@ namespace octoon::animation
 	public:
 		std::string name;
 		std::unordered_map<std::string, AnimationCurve<_Elem, _Time>> curves;
+		std::unordered_map<std::string, AnimationCurve<math::Quaternion, _Time>> rotations;
 		bool finish;
 		_Time timeLength;
 
@@ -36,33 +37,37 @@ namespace octoon::animation
 		void setCurve(const char* _name, AnimationCurve<_Elem, _Time>&& curve) noexcept
 		{
 			this->curves[_name] = std::move(curve);
-			timeLength = 0;
-			for (auto& it : this->curves)
-				timeLength = std::max(it.second.timeLength, timeLength);
+			this->updateTimeLength();
 		}
 
 		void setCurve(const char* _name, const AnimationCurve<_Elem, _Time>& curve) noexcept
 		{
 			this->curves[_name] = curve;
-			timeLength = 0;
-			for (auto& it : this->curves)
-				timeLength = std::max(it.second.timeLength, timeLength);
+			this->updateTimeLength();
 		}
 
 		void setCurve(const std::string& _name, AnimationCurve<_Elem, _Time>&& curve) noexcept
 		{
 			this->curves[_name] = std::move(curve);
-			timeLength = 0;
-			for (auto& it : this->curves)
-				timeLength = std::max(it.second.timeLength, timeLength);
+			this->updateTimeLength();
 		}
 
 		void setCurve(const std::string& _name, const AnimationCurve<_Elem, _Time>& curve) noexcept
 		{
 			this->curves[_name] = curve;
-			timeLength = 0;
-			for (auto& it : this->curves)
-				timeLength = std::max(it.second.timeLength, timeLength);
+			this->updateTimeLength();
+		}
+
+		void setCurve(const std::string& _name, AnimationCurve<math::Quaternion, _Time>&& curve) noexcept
+		{
+			this->rotations[_name] = std::move(curve);
+			this->updateTimeLength();
+		}
+
+		void setCurve(const std::string& _name, const AnimationCurve<math::Quaternion, _Time>& curve) noexcept
+		{
+			this->rotations[_name] = curve;
+			this->updateTimeLength();
 		}
 
 		AnimationCurve<_Elem, _Time>& getCurve(const char* _name) noexcept
@@ -85,14 +90,19 @@ namespace octoon::animation
 			return this->curves[_name];
 		}
 
+		AnimationCurve<math::Quaternion, _Time>& getRotationCurve(const std::string& _name) noexcept
+		{
+			return this->rotations[_name];
+		}
+
 		bool empty() const noexcept
 		{
-			return this->curves.empty();
+			return this->curves.empty() && this->rotations.empty();
 		}
 
 		std::size_t size() const noexcept
 		{
-			return this->curves.size();
+			return this->curves.size() + this->rotations.size();
 		}
 
 		void evaluate(const _Time& delta) noexcept
@@ -104,6 +114,12 @@ namespace octoon::animation
 				it.second.evaluate(delta);
 				this->finish &= it.second.finish;
 			}
+
+			for (auto& it : this->rotations)
+			{
+				it.second.evaluate(delta);
+				this->finish &= it.second.finish;
+			}
 		}
 
 		void setTime(const _Time& time) noexcept
@@ -111,10 +127,26 @@ namespace octoon::animation
 			for (auto& it : this->curves)
 				it.second.setTime(time);
 
+			for (auto& it : this->rotations)
+				it.second.setTime(time);
+
 			this->finish = true;
 
 			for (auto& it : this->curves)
 				this->finish &= it.second.finish;
+
+			for (auto& it : this->rotations)
+				this->finish &= it.second.finish;
+		}
+
+	private:
+		void updateTimeLength() noexcept
+		{
+			timeLength = 0;
+			for (auto& it : this->curves)
+				timeLength = std::max(it.second.timeLength, timeLength);
+			for (auto& it : this->rotations)
+				timeLength = std::max(it.second.timeLength, timeLength);
 		}
 	};
 
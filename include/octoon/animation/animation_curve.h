@@ -2,9 +2,34 @@
 #define OCTOON_ANIMATION_CURVE_H_
 
 #include <octoon/animation/keyframe.h>
+#include <octoon/math/quat.h>
+
+#include <algorithm>
 
 namespace octoon::animation
 {
+	template<typename _Elem, typename _Time>
+	inline _Elem interpolate(const _Elem& a, const _Elem& b, const _Time& t) noexcept
+	{
+		return a * (1.0f - t) + b * t;
+	}
+
+	// Rotation keys blend on the shortest arc. Nearly equal keys use a normalized lerp, where slerp loses precision anyway.
+	template<typename T, typename _Time>
+	inline math::detail::Quaternion<T> interpolate(const math::detail::Quaternion<T>& a, const math::detail::Quaternion<T>& b, const _Time& t) noexcept
+	{
+		auto cosOmega = math::dot(a, b);
+		if (std::abs(cosOmega) < 0.9995f)
+			return math::slerp(a, b, static_cast<T>(t));
+
+		auto sign = cosOmega < 0.0f ? -1.0f : 1.0f;
+		return math::normalize(math::detail::Quaternion<T>(
+			a.x + (b.x * sign - a.x) * t,
+			a.y + (b.y * sign - a.y) * t,
+			a.z + (b.z * sign - a.z) * t,
+			a.w + (b.w * sign - a.w) * t));
+	}
+
 	enum class AnimationMode
 	{
 		Once,
@@ -53,7 +78,10 @@ namespace octoon::animation
 		explicit AnimationCurve(const Keyframes& frames_, const std::shared_ptr<Interpolator<_Time>>& interpolator_ = nullptr) noexcept
 			: interpolator(interpolator_)
 			, finish(false)
+			, negative(false)
 			, timeLength(0)
+			, preWrapMode(AnimationMode::Default)
+			, postWrapMode(AnimationMode::Default)
 		{
 			this->assign(frames_);
 		}
@@ -78,8 +106,8 @@ namespace octoon::animation
 
 		void insert(Keyframe<_Elem, _Time>&& frame_) noexcept
 		{
-			frames.emplace_back(std::move(frame_));
-			this->sort();
+			auto it = std::upper_bound(frames.begin(), frames.end(), frame_.time, [](const _Time& time, const Keyframe<_Elem, _Time>& a) { return time < a.time; });
+			frames.insert(it, std::move(frame_));
 			this->time = frames.front().time;
 			this->timeLength = frames.back().time;
 			this->value = frames.front().value;
@@ -87,8 +115,8 @@ namespace octoon::animation
 
 		void insert(const Keyframe<_Elem, _Time>& frame_) noexcept
 		{
-			frames.emplace_back(frame_);				
-			this->sort();
+			auto it = std::upper_bound(frames.begin(), frames.end(), frame_.time, [](const _Time& time, const Keyframe<_Elem, _Time>& a) { return time < a.time; });
+			frames.insert(it, frame_);
 			this->time = frames.front().time;
 			this->timeLength = frames.back().time;
 			this->value = frames.front().value;
@@ -96,7 +124,9 @@ namespace octoon::animation
 
 		void sort() noexcept
 		{
-			std::sort(frames.begin(), frames.end(), [](const Keyframe<_Elem, _Time>& a, const Keyframe<_Elem, _Time>& b) { return a.time < b.time; });
+			auto compare = [](const Keyframe<_Elem, _Time>& a, const Keyframe<_Elem, _Time>& b) { return a.time < b.time; };
+			if (!std::is_sorted(frames.begin(), frames.end(), compare))
+				std::sort(frames.begin(), frames.end(), compare);
 		}
 
 		bool empty() const noexcept
@@ -139,28 +169,39 @@ namespace octoon::animation
 			}
 			else
 			{
-				auto it = std::upper_bound(frames.begin(), frames.end(), this->time,
-					[](const _Time& time, const Keyframe<_Elem, _Time>& a)
-				{
-					return time <= a.time;
-				}
-				);
-
-				auto& a = *(it - 1);
-				auto& b = *(it);
-				auto t = (this->time - a.time) / (b.time - a.time);
-
-				if (b.interpolator)
-					t = b.interpolator->interpolator(t);
-				else if (interpolator)
-					t = interpolator->interpolator(t);
-
 				this->finish = false;
-				this->value = a.value * (1.0f - t) + b.value * t;
+				this->value = this->sample(this->time);
 			}
 
 			return this->value;
 		}
+
+		// Value of the curve at an absolute time, without touching the playback state.
+		_Elem sample(const _Time& _time) const noexcept
+		{
+			if (_time <= frames.front().time)
+				return frames.front().value;
+			if (_time >= frames.back().time)
+				return frames.back().value;
+
+			auto it = std::upper_bound(frames.begin(), frames.end(), _time,
+				[](const _Time& time, const Keyframe<_Elem, _Time>& a)
+			{
+				return time <= a.time;
+			}
+			);
+
+			auto& a = *(it - 1);
+			auto& b = *(it);
+			auto t = (_time - a.time) / (b.time - a.time);
+
+			if (b.interpolator)
+				t = b.interpolator->interpolator(t);
+			else if (interpolator)
+				t = interpolator->interpolator(t);
+
+			return interpolate(a.value, b.value, t);
+		}
 	private:
 		void updateAnimationMode(AnimationMode mode) noexcept
 		{
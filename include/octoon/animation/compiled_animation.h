@@ -0,0 +1,453 @@
+#ifndef OCTOON_COMPILED_ANIMATION_H_
+#define OCTOON_COMPILED_ANIMATION_H_
+
+#include <octoon/animation/animation.h>
+#include <octoon/animation/path_interpolator.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <iterator>
+#include <map>
+#include <string_view>
+#include <tuple>
+
+namespace octoon::animation
+{
+	enum class AnimationBinding : std::uint8_t
+	{
+		LocalPositionX,
+		LocalPositionY,
+		LocalPositionZ,
+		LocalScaleX,
+		LocalScaleY,
+		LocalScaleZ,
+		LocalRotationX,
+		LocalRotationY,
+		LocalRotationZ,
+		LocalRotationW,
+		LocalEulerAnglesRawX,
+		LocalEulerAnglesRawY,
+		LocalEulerAnglesRawZ,
+		TransformMove,
+		LocalRotation,
+		Message,
+		RangeSize
+	};
+
+	inline AnimationBinding parseAnimationBinding(std::string_view name) noexcept
+	{
+		constexpr std::string_view names[] =
+		{
+			"LocalPosition.x",
+			"LocalPosition.y",
+			"LocalPosition.z",
+			"LocalScale.x",
+			"LocalScale.y",
+			"LocalScale.z",
+			"LocalRotation.x",
+			"LocalRotation.y",
+			"LocalRotation.z",
+			"LocalRotation.w",
+			"LocalEulerAnglesRaw.x",
+			"LocalEulerAnglesRaw.y",
+			"LocalEulerAnglesRaw.z",
+			"Transform:move",
+			"LocalRotation",
+		};
+
+		for (std::size_t i = 0; i < std::size(names); i++)
+		{
+			if (names[i] == name)
+				return static_cast<AnimationBinding>(i);
+		}
+
+		return AnimationBinding::Message;
+	}
+
+	// Flat form of an Animation for playback. Curve names are resolved once to a binding per channel and the clip index
+	// stays the slot of the target (the bone for avatars). Keys of every channel are packed into one array per value type,
+	// Bezier keys share one PathInterpolator per distinct handle set, and each channel resumes its key search from the
+	// segment of the previous evaluation. The pre and post wrap modes of each curve are kept per channel: Loop and PingPong
+	// fold the time back into the keyed range and keep their clip from finishing, the other modes hold the end keys.
+	template<typename _Elem = float, typename _Time = float>
+	class CompiledAnimation final
+	{
+	public:
+		enum class KeyInterpolation : std::uint8_t
+		{
+			Linear,
+			Path,
+			Custom
+		};
+
+		template<typename T>
+		struct Key
+		{
+			_Time time;
+			T value;
+			std::uint32_t interpolator;
+			KeyInterpolation interpolation;
+		};
+
+		struct Channel
+		{
+			AnimationBinding binding;
+			std::uint32_t name;
+			std::uint32_t first;
+			std::uint32_t count;
+			std::uint32_t cursor;
+			AnimationMode preWrapMode;
+			AnimationMode postWrapMode;
+		};
+
+		struct Clip
+		{
+			bool finish;
+			bool repeat;
+			std::uint32_t first;
+			std::uint32_t count;
+			std::uint32_t rotationFirst;
+			std::uint32_t rotationCount;
+			std::uint32_t bindings;
+			_Time timeLength;
+		};
+
+		AnimatorStateInfo<_Time> state;
+
+		std::vector<Clip> clips;
+		std::vector<Channel> channels;
+		std::vector<Key<_Elem>> keys;
+		std::vector<_Elem> values;
+		std::vector<Channel> rotationChannels;
+		std::vector<Key<math::Quaternion>> rotationKeys;
+		std::vector<math::Quaternion> rotations;
+		std::vector<std::string> names;
+		std::vector<PathInterpolator<_Time>> paths;
+		std::vector<std::shared_ptr<Interpolator<_Time>>> interpolators;
+
+		CompiledAnimation() noexcept
+		{
+			state.finish = false;
+			state.time = 0;
+			state.timeLength = 0;
+		}
+
+		explicit CompiledAnimation(const Animation<_Elem, _Time>& animation) noexcept
+			: CompiledAnimation()
+		{
+			this->compile(animation);
+		}
+
+		void compile(const Animation<_Elem, _Time>& animation) noexcept
+		{
+			this->clear();
+
+			std::size_t numChannels = 0;
+			std::size_t numKeys = 0;
+			std::size_t numRotationChannels = 0;
+			std::size_t numRotationKeys = 0;
+
+			for (auto& clip : animation.clips)
+			{
+				for (auto& curve : clip.curves)
+				{
+					if (!curve.second.empty())
+					{
+						numChannels++;
+						numKeys += curve.second.frames.size();
+					}
+				}
+
+				for (auto& curve : clip.rotations)
+				{
+					if (!curve.second.empty())
+					{
+						numRotationChannels++;
+						numRotationKeys += curve.second.frames.size();
+					}
+				}
+			}
+
+			this->clips.reserve(animation.clips.size());
+			this->channels.reserve(numChannels);
+			this->keys.reserve(numKeys);
+			this->values.reserve(numChannels);
+			this->rotationChannels.reserve(numRotationChannels);
+			this->rotationKeys.reserve(numRotationKeys);
+			this->rotations.reserve(numRotationChannels);
+
+			std::map<std::tuple<_Time, _Time, _Time, _Time>, std::uint32_t> pathTable;
+
+			for (auto& clip : animation.clips)
+			{
+				Clip compiled;
+				compiled.finish = false;
+				compiled.repeat = false;
+				compiled.first = static_cast<std::uint32_t>(this->channels.size());
+				compiled.count = 0;
+				compiled.rotationFirst = static_cast<std::uint32_t>(this->rotationChannels.size());
+				compiled.rotationCount = 0;
+				compiled.bindings = 0;
+				compiled.timeLength = 0;
+
+				for (auto& curve : clip.curves)
+				{
+					if (curve.second.empty())
+						continue;
+
+					auto channel = this->compileChannel(curve.first, curve.second, this->keys, pathTable);
+					if (channel.binding == AnimationBinding::Message)
+					{
+						channel.name = static_cast<std::uint32_t>(this->names.size());
+						this->names.push_back(curve.first);
+					}
+
+					compiled.count++;
+					compiled.repeat |= isRepeating(channel.postWrapMode);
+					compiled.bindings |= 1u << static_cast<std::uint32_t>(channel.binding);
+					compiled.timeLength = std::max(compiled.timeLength, curve.second.frames.back().time);
+
+					this->channels.push_back(channel);
+					this->values.push_back(curve.second.frames.front().value);
+				}
+
+				for (auto& curve : clip.rotations)
+				{
+					if (curve.second.empty())
+						continue;
+
+					auto channel = this->compileChannel(curve.first, curve.second, this->rotationKeys, pathTable);
+					channel.binding = AnimationBinding::LocalRotation;
+
+					compiled.rotationCount++;
+					compiled.repeat |= isRepeating(channel.postWrapMode);
+					compiled.bindings |= 1u << static_cast<std::uint32_t>(channel.binding);
+					compiled.timeLength = std::max(compiled.timeLength, curve.second.frames.back().time);
+
+					this->rotationChannels.push_back(channel);
+					this->rotations.push_back(curve.second.frames.front().value);
+				}
+
+				this->state.timeLength = std::max(this->state.timeLength, compiled.timeLength);
+				this->clips.push_back(compiled);
+			}
+
+			this->setTime(0);
+		}
+
+		void clear() noexcept
+		{
+			this->state.finish = false;
+			this->state.time = 0;
+			this->state.timeLength = 0;
+			this->clips.clear();
+			this->channels.clear();
+			this->keys.clear();
+			this->values.clear();
+			this->rotationChannels.clear();
+			this->rotationKeys.clear();
+			this->rotations.clear();
+			this->names.clear();
+			this->paths.clear();
+			this->interpolators.clear();
+		}
+
+		bool empty() const noexcept
+		{
+			return this->channels.empty() && this->rotationChannels.empty();
+		}
+
+		bool hasBinding(const Clip& clip, AnimationBinding binding) const noexcept
+		{
+			return (clip.bindings & (1u << static_cast<std::uint32_t>(binding))) != 0;
+		}
+
+		void setTime(const _Time& time) noexcept
+		{
+			this->update(time);
+		}
+
+		void evaluate(const _Time& delta) noexcept
+		{
+			this->update(this->state.time + delta);
+		}
+
+	private:
+		template<typename T>
+		Channel compileChannel(const std::string& name, const AnimationCurve<T, _Time>& curve, std::vector<Key<T>>& output, std::map<std::tuple<_Time, _Time, _Time, _Time>, std::uint32_t>& pathTable) noexcept
+		{
+			Channel channel;
+			channel.binding = parseAnimationBinding(name);
+			channel.name = 0;
+			channel.first = static_cast<std::uint32_t>(output.size());
+			channel.count = static_cast<std::uint32_t>(curve.frames.size());
+			channel.cursor = 0;
+			channel.preWrapMode = curve.preWrapMode;
+			channel.postWrapMode = curve.postWrapMode;
+
+			for (auto& frame : curve.frames)
+			{
+				Key<T> key;
+				key.time = frame.time;
+				key.value = frame.value;
+				key.interpolator = 0;
+				key.interpolation = KeyInterpolation::Linear;
+
+				auto& interpolator = frame.interpolator ? frame.interpolator : curve.interpolator;
+				if (interpolator)
+				{
+					auto path = dynamic_cast<const PathInterpolator<_Time>*>(interpolator.get());
+					if (path)
+					{
+						_Time xa, xb, ya, yb;
+						path->getControlPoints(xa, xb, ya, yb);
+
+						auto it = pathTable.emplace(std::make_tuple(xa, xb, ya, yb), static_cast<std::uint32_t>(this->paths.size()));
+						if (it.second)
+							this->paths.push_back(*path);
+
+						key.interpolator = it.first->second;
+						key.interpolation = KeyInterpolation::Path;
+					}
+					else
+					{
+						key.interpolator = static_cast<std::uint32_t>(this->interpolators.size());
+						key.interpolation = KeyInterpolation::Custom;
+						this->interpolators.push_back(interpolator);
+					}
+				}
+
+				output.push_back(key);
+			}
+
+			return channel;
+		}
+
+		static bool isRepeating(AnimationMode mode) noexcept
+		{
+			return mode == AnimationMode::Loop || mode == AnimationMode::PingPong;
+		}
+
+		// Folds a time outside [start, end] back into it for the repeating modes, the others are clamped by the sampling.
+		static _Time wrap(AnimationMode mode, _Time time, _Time start, _Time end) noexcept
+		{
+			auto length = end - start;
+			if (length <= 0)
+				return time;
+
+			switch (mode)
+			{
+			case AnimationMode::Loop:
+			{
+				auto offset = std::fmod(time - start, length);
+				return start + (offset < 0 ? offset + length : offset);
+			}
+			case AnimationMode::PingPong:
+			{
+				auto offset = std::fmod(time - start, length * 2);
+				if (offset < 0)
+					offset += length * 2;
+				return start + (offset > length ? length * 2 - offset : offset);
+			}
+			default:
+				return time;
+			}
+		}
+
+		// Moves the cursor to the segment [cursor, cursor + 1) holding time, walking a few keys before falling back to a binary search.
+		template<typename T>
+		static std::uint32_t seek(const Key<T>* frames, std::uint32_t count, std::uint32_t cursor, _Time time) noexcept
+		{
+			constexpr std::uint32_t maxSteps = 4;
+
+			if (cursor + 1 >= count)
+				cursor = count - 2;
+
+			for (std::uint32_t step = 0; step < maxSteps; step++)
+			{
+				if (time < frames[cursor].time)
+				{
+					if (cursor == 0)
+						return cursor;
+					cursor--;
+				}
+				else if (cursor + 2 < count && time >= frames[cursor + 1].time)
+				{
+					cursor++;
+				}
+				else
+				{
+					return cursor;
+				}
+			}
+
+			auto it = std::upper_bound(frames, frames + count, time, [](const _Time& t, const Key<T>& key) { return t < key.time; });
+			auto index = static_cast<std::uint32_t>(it - frames);
+			return std::min(index > 0 ? index - 1 : 0, count - 2);
+		}
+
+		template<typename T>
+		T sample(Channel& channel, const std::vector<Key<T>>& input, _Time time) const noexcept
+		{
+			auto frames = input.data() + channel.first;
+			if (channel.count == 1)
+				return frames[0].value;
+
+			if (time > frames[channel.count - 1].time)
+				time = wrap(channel.postWrapMode, time, frames[0].time, frames[channel.count - 1].time);
+			else if (time < frames[0].time)
+				time = wrap(channel.preWrapMode, time, frames[0].time, frames[channel.count - 1].time);
+
+			channel.cursor = seek(frames, channel.count, channel.cursor, time);
+
+			auto& a = frames[channel.cursor];
+			auto& b = frames[channel.cursor + 1];
+
+			if (time <= a.time)
+				return a.value;
+			if (time >= b.time)
+				return b.value;
+
+			auto t = (time - a.time) / (b.time - a.time);
+
+			switch (b.interpolation)
+			{
+			case KeyInterpolation::Path:
+				t = this->paths[b.interpolator].interpolator(t);
+				break;
+			case KeyInterpolation::Custom:
+				t = this->interpolators[b.interpolator]->interpolator(t);
+				break;
+			default:
+				break;
+			}
+
+			return interpolate(a.value, b.value, t);
+		}
+
+		void update(_Time time) noexcept
+		{
+			auto last = this->state.time;
+
+			this->state.time = time;
+			this->state.finish = true;
+
+			for (auto& clip : this->clips)
+			{
+				for (std::uint32_t i = clip.first; i < clip.first + clip.count; i++)
+					this->values[i] = this->sample(this->channels[i], this->keys, time);
+
+				for (std::uint32_t i = clip.rotationFirst; i < clip.rotationFirst + clip.rotationCount; i++)
+					this->rotations[i] = this->sample(this->rotationChannels[i], this->rotationKeys, time);
+
+				// A clip only counts as finished once its last key has been applied, so the final pose is not skipped. Clips
+				// with a looping channel never finish.
+				clip.finish = !clip.repeat && last >= clip.timeLength && time >= clip.timeLength;
+				this->state.finish &= clip.finish;
+			}
+		}
+	};
+}
+
+#endif
@@ -3,66 +3,134 @@
 
 #include <octoon/animation/interpolator.h>
 
+#include <algorithm>
+#include <cmath>
+
 namespace octoon::animation
 {
+	// Cubic Bezier easing from (0, 0) to (1, 1) through the handles (xa, ya) and (xb, yb), the form used by VMD/PMM keys.
+	// The curve parameter is tabulated at evenly spaced x when the handles are set, evaluation refines the tabulated
+	// guess with two Newton steps so it costs the same for every key instead of bisecting until it converges.
 	template<typename T = float>
 	class PathInterpolator final : public Interpolator<T>
 	{
 	public:
-		PathInterpolator() noexcept = default;
-		PathInterpolator(T ip[4]) noexcept : xa(ip[0]), xb(ip[1]), ya(ip[2]), yb(ip[3]) {};
-		PathInterpolator(T xa_, T xb_, T ya_, T yb_) noexcept : xa(xa_), xb(xb_), ya(ya_), yb(yb_) {};
+		static constexpr std::size_t TableSize = 16;
+		static constexpr std::size_t MaxIterations = 8;
+
+		PathInterpolator() noexcept : PathInterpolator(0.25f, 0.75f, 0.25f, 0.75f) {};
+		PathInterpolator(T ip[4]) noexcept : PathInterpolator(ip[0], ip[1], ip[2], ip[3]) {};
+		PathInterpolator(T xa_, T xb_, T ya_, T yb_) noexcept : xa(xa_), xb(xb_), ya(ya_), yb(yb_) { this->build(); };
 		virtual ~PathInterpolator() noexcept = default;
 
 		T evalX(T t) const noexcept
 		{
-			T x11 = xa * t;
-			T x12 = xa + (xb - xa) * t;
-			T x13 = xb + (1.0f - xb) * t;
-
-			T x21 = x11 + (x12 - x11) * t;
-			T x22 = x12 + (x13 - x12) * t;
-
-			return x21 + (x22 - x21) * t;
+			return eval(xa, xb, t);
 		}
 
 		T evalY(T t) const noexcept
 		{
-			T y11 = ya * t;
-			T y12 = ya + (yb - ya) * t;
-			T y13 = yb + (1.0f - yb) * t;
-
-			T y21 = y11 + (y12 - y11) * t;
-			T y22 = y12 + (y13 - y12) * t;
+			return eval(ya, yb, t);
+		}
 
-			return y21 + (y22 - y21) * t;
+		void getControlPoints(T& xa_, T& xb_, T& ya_, T& yb_) const noexcept
+		{
+			xa_ = xa;
+			xb_ = xb;
+			ya_ = ya;
+			yb_ = yb;
 		}
 
 		T interpolator(T time) const noexcept override
 		{
-			T min = 0.0f;
-			T max = 1.0f;
+			if (time <= 0.0f)
+				return 0.0f;
+			if (time >= 1.0f)
+				return 1.0f;
 
-			T t = 0.5f;
-			T x = this->evalX(t);
+			auto x = time * TableSize;
+			auto index = std::min(static_cast<std::size_t>(x), TableSize - 1);
+			auto min = table[index];
+			auto max = table[index + 1];
+			auto t = min + (max - min) * (x - index);
 
-			while (std::fabs(x - time) > math::EPSILON_E4)
+			// Newton steps kept inside the tabulated bracket, falling back to bisection where the slope vanishes.
+			for (std::size_t i = 0; i < MaxIterations; i++)
 			{
-				if (x < time)
+				auto error = evalX(t) - time;
+				if (std::fabs(error) < static_cast<T>(1e-6))
+					break;
+
+				if (error < 0.0f)
 					min = t;
 				else
 					max = t;
 
-				t = (min + max) * 0.5f;
-				x = evalX(t);
+				auto slope = derivative(xa, xb, t);
+				auto next = slope > static_cast<T>(1e-6) ? t - error / slope : min - 1.0f;
+				t = (next > min && next < max) ? next : (min + max) * 0.5f;
 			}
 
 			return this->evalY(t);
 		}
 
+		static T eval(T a, T b, T t) noexcept
+		{
+			T x11 = a * t;
+			T x12 = a + (b - a) * t;
+			T x13 = b + (1.0f - b) * t;
+
+			T x21 = x11 + (x12 - x11) * t;
+			T x22 = x12 + (x13 - x12) * t;
+
+			return x21 + (x22 - x21) * t;
+		}
+
+		static T derivative(T a, T b, T t) noexcept
+		{
+			T s = 1.0f - t;
+			return 3.0f * (s * s * a + 2.0f * s * t * (b - a) + t * t * (1.0f - b));
+		}
+
+		friend bool operator==(const PathInterpolator& a, const PathInterpolator& b) noexcept
+		{
+			return a.xa == b.xa && a.xb == b.xb && a.ya == b.ya && a.yb == b.yb;
+		}
+
+		friend bool operator!=(const PathInterpolator& a, const PathInterpolator& b) noexcept
+		{
+			return !(a == b);
+		}
+
+	private:
+		void build() noexcept
+		{
+			table[0] = 0.0f;
+			table[TableSize] = 1.0f;
+
+			for (std::size_t i = 1; i < TableSize; i++)
+			{
+				T time = static_cast<T>(i) / TableSize;
+				T min = 0.0f;
+				T max = 1.0f;
+
+				for (std::size_t n = 0; n < 24; n++)
+				{
+					T t = (min + max) * 0.5f;
+					if (evalX(t) < time)
+						min = t;
+					else
+						max = t;
+				}
+
+				table[i] = (min + max) * 0.5f;
+			}
+		}
+
 	private:
 		T xa, xb, ya, yb;
+		T table[TableSize + 1];
 	};
 }
 
-#endif
\ No newline at end of file
+#endif
@@ -0,0 +1,60 @@
+#ifndef OCTOON_POSE_BUFFER_H_
+#define OCTOON_POSE_BUFFER_H_
+
+#include <octoon/math/math.h>
+#include <octoon/io/iostream.h>
+
+namespace octoon::animation
+{
+	// Final local bone transforms sampled at a fixed frame rate, as baked by AnimatorComponent.
+	// Each bone takes 12 bytes per frame: the rotation as the smallest three components in 48 bits and the translation
+	// as half floats relative to the first frame, so playback only decodes and blends two frames per bone.
+	class OCTOON_EXPORT PoseBuffer final
+	{
+	public:
+		struct Pose
+		{
+			std::uint16_t rotation[3];
+			std::uint16_t translate[3];
+		};
+
+		PoseBuffer() noexcept;
+		PoseBuffer(std::size_t numBones, float frameRate) noexcept;
+		~PoseBuffer() noexcept;
+
+		void reset(std::size_t numBones, float frameRate) noexcept;
+		void clear() noexcept;
+
+		bool empty() const noexcept;
+
+		std::size_t getNumBones() const noexcept;
+		std::size_t getNumFrames() const noexcept;
+
+		float getFrameRate() const noexcept;
+		float getTimeLength() const noexcept;
+
+		// Appends one frame, both arrays hold getNumBones() elements.
+		void addFrame(const math::float3* translates, const math::Quaternion* rotations) noexcept;
+
+		// Blends the two frames around the time, clamped to the baked range.
+		void sample(float time, math::float3* translates, math::Quaternion* rotations) const noexcept;
+
+		void load(io::istream& stream) noexcept(false);
+		void save(io::ostream& stream) const noexcept(false);
+
+		static void encode(const math::Quaternion& rotation, std::uint16_t packed[3]) noexcept;
+		static math::Quaternion decode(const std::uint16_t packed[3]) noexcept;
+
+		static std::uint16_t encode(float value) noexcept;
+		static float decode(std::uint16_t value) noexcept;
+
+	private:
+		float frameRate_;
+		std::size_t numBones_;
+
+		math::float3s base_;
+		std::vector<Pose> poses_;
+	};
+}
+
+#endif
@@ -2,6 +2,10 @@
 #define OCTOON_ANIMATOR_COMPONENT_H_
 
 #include <octoon/animation_component.h>
+#include <octoon/transform_hierarchy.h>
+#include <octoon/solver_schedule.h>
+#include <octoon/animation/compiled_animation.h>
+#include <octoon/animation/pose_buffer.h>
 
 namespace octoon
 {
@@ -40,16 +44,42 @@ namespace octoon
 		const animation::Animation<float>& getAnimation() const noexcept;
 		const animation::AnimatorStateInfo<float>& getCurrentAnimatorStateInfo() const noexcept override;
 
+		// Records the final local pose of every avatar bone, after IK and rotation links, at a fixed frame rate.
+		// While a pose buffer matching the avatar is set, playback reads it instead of the curves and the IK solvers of the avatar stay inactive.
+		void bake(float frameRate = 30.0f) noexcept;
+		bool isBaked() const noexcept;
+
+		void setPoseBuffer(animation::PoseBuffer&& poses) noexcept;
+		void setPoseBuffer(const animation::PoseBuffer& poses) noexcept;
+		const animation::PoseBuffer& getPoseBuffer() const noexcept;
+		void clearPoseBuffer() noexcept;
+
 		GameComponentPtr clone() const noexcept;
 
+		GameAccessFlags getReadAccess() const noexcept override;
+		GameAccessFlags getWriteAccess() const noexcept override;
+		void getLinkedObjects(GameObjectRaws& objects) const noexcept override;
+
 	private:
 		void onActivate() except;
 		void onDeactivate() noexcept;
 
 		void onFixedUpdate() noexcept;
+		void onLateUpdate() noexcept;
 
 	private:
+		bool hasEulerBinding(const animation::CompiledAnimation<float>::Clip& clip) const noexcept;
+
+		void updateClipBones() noexcept;
+
+		void setSolverActive(bool active) noexcept;
+		void setSolverScheduled(bool scheduled) noexcept;
+
+		void updateWriteAccess() const noexcept;
+
 		void updateAvatar(float delta = 0.0f) noexcept;
+		void updateAvatarCurves() noexcept;
+		void updateAvatarPoses() noexcept;
 		void updateAnimation(float delta = 0.0f) noexcept;
 
 	private:
@@ -60,8 +90,29 @@ namespace octoon
 		bool enableAnimOnVisableOnly_;
 
 		animation::Animation<float> animation_;
+		animation::CompiledAnimation<float> compiled_;
 		math::float3s bindpose_;
 
+		// Avatar bone driven by each clip, found by name since motions only hold the animated bones in their own order.
+		std::vector<std::size_t> clipBones_;
+
+		TransformHierarchy hierarchy_;
+
+		// IK solvers of the avatar, taken over from their own late update while the animator is active.
+		CCDSolverSchedule solvers_;
+
+		// Solvers that were active until a pose buffer replaced them.
+		std::vector<std::weak_ptr<CCDSolverComponent>> suspendedSolvers_;
+
+		animation::PoseBuffer poses_;
+		animation::AnimatorStateInfo<float> posesState_;
+		math::float3s posesTranslate_;
+		math::Quaternions posesRotation_;
+
+		// Physics when kinematic bodies hang from the driven objects, refreshed once the hierarchy revision moves on.
+		mutable GameAccessFlags writeAccess_;
+		mutable std::size_t writeAccessRevision_;
+
 		GameObjects avatar_;
 	};
 }
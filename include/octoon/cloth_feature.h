@@ -28,7 +28,7 @@ namespace octoon
 		ClothFeature() except;
 		virtual ~ClothFeature() noexcept;
 
-		bool fetchResulting() const { return needUpdate_; }
+		bool fetchResulting() const { return fixedSteps_ > 0; }
 
 	public:
 		void onActivate() except override;
@@ -51,8 +51,8 @@ namespace octoon
 		ClothFeature& operator=(const ClothFeature&) = delete;
 
 	private:
-		bool needUpdate_;
 		float timeInterval_;
+		std::uint32_t fixedSteps_;
 		std::uint32_t iterationCounts_;
 
 		nv::cloth::Solver* solver_;
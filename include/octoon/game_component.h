@@ -25,7 +25,7 @@ namespace octoon
 		const GameScene* getGameScene() const noexcept;
 
 		template<typename T, typename = std::enable_if_t<std::is_base_of<GameComponent, T>::value>>
-		std::shared_ptr<T> getComponent() const noexcept { return std::dynamic_pointer_cast<T>(this->getComponent(T::RTTI)); }
+		std::shared_ptr<T> getComponent() const noexcept { return std::static_pointer_cast<T>(this->getComponent(T::RTTI)); }
 		GameComponentPtr getComponent(const runtime::Rtti* type) const noexcept;
 		GameComponentPtr getComponent(const runtime::Rtti& type) const noexcept;
 
@@ -35,7 +35,7 @@ namespace octoon
 		void getComponents(const runtime::Rtti& type, GameComponents& components) const noexcept;
 
 		template<typename T, typename = std::enable_if_t<std::is_base_of<GameComponent, T>::value>>
-		std::shared_ptr<T> getComponentInChildren() const noexcept { return std::dynamic_pointer_cast<T>(this->getComponentInChildren(T::RTTI)); }
+		std::shared_ptr<T> getComponentInChildren() const noexcept { return std::static_pointer_cast<T>(this->getComponentInChildren(T::RTTI)); }
 		GameComponentPtr getComponentInChildren(const runtime::Rtti* type) const noexcept;
 		GameComponentPtr getComponentInChildren(const runtime::Rtti& type) const noexcept;
 
@@ -76,6 +76,13 @@ namespace octoon
 
 		virtual GameComponentPtr clone() const noexcept = 0;
 
+		// What the update callbacks touch, so that GameObjectManager can update independent object trees in parallel.
+		// Trees of the objects returned by getLinkedObjects() are updated together with the tree of this object, the
+		// default of GameAccess::All keeps the component on the main thread in its original order.
+		virtual GameAccessFlags getReadAccess() const noexcept;
+		virtual GameAccessFlags getWriteAccess() const noexcept;
+		virtual void getLinkedObjects(GameObjectRaws& objects) const noexcept;
+
 	protected:
 		void addComponentDispatch(GameDispatchTypes type) noexcept;
 		void removeComponentDispatch(GameDispatchTypes type) noexcept;
@@ -7,6 +7,7 @@
 
 #include <any>
 #include <functional>
+#include <unordered_map>
 
 namespace octoon
 {
@@ -54,7 +55,7 @@ namespace octoon
 		void addComponent(GameComponents&& component) except;
 
 		template<typename T, typename = std::enable_if_t<std::is_base_of<GameComponent, T>::value>>
-		std::shared_ptr<T> getComponent() const noexcept { return std::dynamic_pointer_cast<T>(this->getComponent(T::RTTI)); }
+		std::shared_ptr<T> getComponent() const noexcept { return std::static_pointer_cast<T>(this->getComponent(T::RTTI)); }
 		GameComponentPtr getComponent(const runtime::Rtti* type) const noexcept;
 		GameComponentPtr getComponent(const runtime::Rtti& type) const noexcept;
 
@@ -64,7 +65,7 @@ namespace octoon
 		void getComponents(const runtime::Rtti& type, GameComponents& components) const noexcept;
 
 		template<typename T, typename = std::enable_if_t<std::is_base_of<GameComponent, T>::value>>
-		std::shared_ptr<T> getComponentInChildren() const noexcept { return std::dynamic_pointer_cast<T>(this->getComponentInChildren(T::RTTI)); }
+		std::shared_ptr<T> getComponentInChildren() const noexcept { return std::static_pointer_cast<T>(this->getComponentInChildren(T::RTTI)); }
 		GameComponentPtr getComponentInChildren(const runtime::Rtti* type) const noexcept;
 		GameComponentPtr getComponentInChildren(const runtime::Rtti& type) const noexcept;
 
@@ -109,6 +110,10 @@ namespace octoon
 		void removeComponentDispatch(GameDispatchTypes type, const GameComponent* component) noexcept;
 		void removeComponentDispatchs(const GameComponent* component) noexcept;
 
+	private:
+		void indexComponent(const GameComponentPtr& component) noexcept;
+		void rebuildComponentIndex() noexcept;
+
 	private:
 		friend class GameObjectManager;
 		friend class TransformComponent;
@@ -128,6 +133,8 @@ namespace octoon
 		void onUpdate() except;
 		void onLateUpdate() except;
 
+		void getDispatchAccess(GameDispatchTypes type, GameAccessFlags& reads, GameAccessFlags& writes, GameObjectRaws& objects) const noexcept;
+
 	private:
 		GameObject(const GameObject& copy) noexcept = delete;
 		GameObject& operator=(const GameObject& copy) noexcept = delete;
@@ -145,6 +152,12 @@ namespace octoon
 
 		GameComponents components_;
 		std::vector<GameComponentRaws> dispatchComponents_;
+
+		// First component of every type in the RTTI chain of the attached components, so lookups never scan components_.
+		// The hottest types also get a fixed slot that is checked before hashing.
+		static constexpr std::size_t HotComponentSlots = 3;
+		GameComponentPtr hotComponents_[HotComponentSlots];
+		std::unordered_map<const runtime::Rtti*, GameComponentPtr> componentIndex_;
 		std::map<std::string, runtime::signal<void(const std::any&)>, std::less<>> dispatchEvents_;
 	};
 }
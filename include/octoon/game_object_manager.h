@@ -2,7 +2,9 @@
 #define OCTOON_GAME_OBJECT_MANAGER_H_
 
 #include <stack>
+#include <atomic>
 #include <mutex>
+#include <unordered_map>
 #include <octoon/game_object.h>
 #include <octoon/runtime/singleton.h>
 
@@ -19,6 +21,15 @@ namespace octoon
 
 		const GameObjectRaws& instances() const noexcept;
 
+		// Updates object trees whose components declare no conflicting access on the worker threads of runtime::JobSystem.
+		// Objects touching physics or the scene, and objects in conflict with each other, keep the order of the serial update.
+		void setParallelDispatch(bool enable) noexcept;
+		bool getParallelDispatch() const noexcept;
+
+		// Changes whenever an object is moved to another parent or gains or loses a component. Components caching what
+		// hangs below the objects they drive compare it to the revision of their cache instead of walking the children.
+		std::size_t getHierarchyRevision() const noexcept;
+
 		void onFixedUpdate() except;
 		void onUpdate() except;
 		void onLateUpdate() except;
@@ -35,16 +46,46 @@ namespace octoon
 		void _instanceObject(GameObject* entity, std::size_t& instanceID) noexcept;
 		void _unsetObject(GameObject* entity) noexcept;
 		void _activeObject(GameObject* entity, bool active) noexcept;
+		void _changeHierarchy() noexcept;
+
+	private:
+		struct DispatchGroup
+		{
+			std::size_t node;
+			GameAccessFlags reads;
+			GameAccessFlags writes;
+			std::vector<std::size_t> actors;
+			GameObjectRaws objects;
+		};
+
+		void dispatch(GameDispatchTypes type) except;
+		void dispatch(GameObject* actor, GameDispatchTypes type) except;
+
+		void buildDispatchNodes(GameDispatchTypes type, std::size_t count) noexcept;
+		void dispatchGroups(GameDispatchTypes type) except;
 
 	private:
 		bool hasEmptyActors_;
+		bool parallelDispatch_;
 
 		GameObjectRaws instanceLists_;
 		GameObjectRaws activeActors_;
 
+		std::atomic<std::size_t> hierarchyRevision_;
+
 		std::mutex lock_;
+		std::mutex activeLock_;
 		std::stack<std::size_t> emptyLists_;
 
+		std::vector<DispatchGroup> dispatchGroups_;
+		std::vector<std::size_t> dispatchNodes_;
+		std::vector<GameAccessFlags> dispatchReads_;
+		std::vector<GameAccessFlags> dispatchWrites_;
+		std::vector<std::size_t> dispatchParents_;
+		std::vector<std::size_t> dispatchGroupIndices_;
+		std::unordered_map<const GameObject*, std::size_t> dispatchRoots_;
+		GameObjectRaws dispatchLinks_;
+
 		std::vector<GameComponentRaws> dispatchComponents_;
 		std::map<std::string, runtime::signal<void(const std::any&)>, std::less<>> dispatchEvents_;
 	};
@@ -61,6 +61,24 @@ namespace octoon
 	};
 
 	typedef std::uint8_t GameDispatchTypes;
+
+	// Shared state touched by the update callbacks of a component, besides the object trees it updates.
+	struct GameAccess
+	{
+		enum Type
+		{
+			None = 0,
+			Scene = 1 << 0,
+			Physics = 1 << 1,
+			Audio = 1 << 2,
+			Input = 1 << 3,
+			Render = 1 << 4,
+			MainThread = 1 << 5,
+			All = 0xFF,
+		};
+	};
+
+	typedef std::uint8_t GameAccessFlags;
 }
 
 #endif
\ No newline at end of file
@@ -3,6 +3,7 @@
 
 #include <octoon/mesh/mesh.h>
 #include <octoon/material/material.h>
+#include <octoon/model/skinning.h>
 #include <octoon/video/render_object.h>
 
 namespace octoon::geometry
@@ -35,6 +36,9 @@ namespace octoon::geometry
 		void setMaterials(const std::vector<std::shared_ptr<material::Material>>& materials) noexcept;
 		const std::vector<std::shared_ptr<material::Material>>& getMaterials() const noexcept;
 
+		void setSkinningData(const std::shared_ptr<skelecton::SkinningData>& data) noexcept;
+		const std::shared_ptr<skelecton::SkinningData>& getSkinningData() const noexcept;
+
 	private:
 		bool isCastShadow_;
 		bool isReceiveShadow_;
@@ -42,6 +46,8 @@ namespace octoon::geometry
 
 		std::shared_ptr<mesh::Mesh> mesh_;
 		std::vector<std::shared_ptr<material::Material>> materials_;
+
+		std::shared_ptr<skelecton::SkinningData> skinningData_;
 	};
 }
 
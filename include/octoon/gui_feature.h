@@ -24,6 +24,10 @@ namespace octoon
 		void setFramebufferScale(std::uint32_t w, std::uint32_t h) noexcept;
 		void getFramebufferScale(std::uint32_t& w, std::uint32_t& h) noexcept;
 
+		// Shows the zones of runtime::Profiler for the last frame, enabling the profiler as well.
+		void setProfilerVisible(bool visible) noexcept;
+		bool getProfilerVisible() const noexcept;
+
 	private:
 		void onActivate() except override;
 		void onDeactivate() noexcept override;
@@ -42,6 +46,8 @@ namespace octoon
 		std::uint32_t framebuffer_w_;
 		std::uint32_t framebuffer_h_;
 
+		bool profilerVisible_;
+
 		std::unique_ptr<imgui::System> system_;
 	};
 }
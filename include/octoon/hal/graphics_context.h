@@ -21,6 +21,21 @@ namespace octoon
 			GraphicsSwapchainPtr _swapchain;
 		};
 
+		// Commands a context received since it was created, only counted by contexts of the null device.
+		struct GraphicsContextStatistics
+		{
+			std::uint64_t drawCalls;
+			std::uint64_t vertices;
+			std::uint64_t instances;
+			std::uint64_t pipelineChanges;
+			std::uint64_t descriptorSetChanges;
+			std::uint64_t vertexBufferChanges;
+			std::uint64_t indexBufferChanges;
+			std::uint64_t framebufferChanges;
+			std::uint64_t clears;
+			std::uint64_t presents;
+		};
+
 		class OCTOON_EXPORT GraphicsContext : public GraphicsChild
 		{
 			OctoonDeclareSubInterface(GraphicsContext, GraphicsChild)
@@ -73,8 +88,13 @@ namespace octoon
 			virtual void drawIndirect(const GraphicsDataPtr& data, std::size_t offset, std::uint32_t drawCount, std::uint32_t stride) noexcept = 0;
 			virtual void drawIndexedIndirect(const GraphicsDataPtr& data, std::size_t offset, std::uint32_t drawCount, std::uint32_t stride) noexcept = 0;
 
+			virtual void dispatch(std::uint32_t groupCountX, std::uint32_t groupCountY, std::uint32_t groupCountZ) noexcept = 0;
+
 			virtual void present() noexcept = 0;
 
+			// Null for the contexts that do not keep statistics.
+			virtual const GraphicsContextStatistics* getStatistics() const noexcept;
+
 		private:
 			GraphicsContext(const GraphicsContext&) noexcept = delete;
 			GraphicsContext& operator=(const GraphicsContext&) noexcept = delete;
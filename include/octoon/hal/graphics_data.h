@@ -43,6 +43,9 @@ namespace octoon
 			virtual bool map(std::ptrdiff_t offset, std::ptrdiff_t count, void** data) noexcept = 0;
 			virtual void unmap() noexcept = 0;
 
+			// Makes writes to [offset, offset + count) of the mapped range visible to the device when mapped with FlushExplicitBit.
+			virtual std::ptrdiff_t flush(std::ptrdiff_t offset, std::ptrdiff_t count) noexcept = 0;
+
 			virtual const GraphicsDataDesc& getDataDesc() const noexcept = 0;
 
 		private:
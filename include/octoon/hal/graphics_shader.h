@@ -43,7 +43,7 @@ namespace octoon
 		class OCTOON_EXPORT GraphicsProgramDesc final
 		{
 		public:
-			GraphicsProgramDesc() noexcept = default;
+			GraphicsProgramDesc() noexcept;
 			~GraphicsProgramDesc() = default;
 
 			bool addShader(GraphicsShaderPtr shader) noexcept;
@@ -51,8 +51,15 @@ namespace octoon
 
 			const GraphicsShaders& getShaders() const noexcept;
 
+			// A binary taken from GraphicsProgram::getProgramBinary, a device that accepts it links no shaders.
+			void setProgramBinary(std::vector<std::uint8_t>&& binary, std::uint32_t format) noexcept;
+			const std::vector<std::uint8_t>& getProgramBinary() const noexcept;
+			std::uint32_t getProgramBinaryFormat() const noexcept;
+
 		private:
 			GraphicsShaders _shaders;
+			std::vector<std::uint8_t> _binary;
+			std::uint32_t _binaryFormat;
 		};
 
 		class OCTOON_EXPORT GraphicsAttribute : public runtime::RttiInterface
@@ -144,6 +151,9 @@ namespace octoon
 
 			virtual const GraphicsProgramDesc& getProgramDesc() const noexcept = 0;
 
+			// The driver's binary of the linked program, false when the device has none to give.
+			virtual bool getProgramBinary(std::vector<std::uint8_t>& binary, std::uint32_t& format) const noexcept;
+
 		private:
 			GraphicsProgram(const GraphicsProgram&) noexcept = delete;
 			GraphicsProgram& operator=(const GraphicsProgram&) noexcept = delete;
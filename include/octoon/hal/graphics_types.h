@@ -208,6 +208,7 @@ namespace octoon
 			D3D9 = 6,
 			D3D11 = 7,
 			D3D12 = 8,
+			Null = 9,
 		};
 
 		enum class GraphicsSwapInterval : std::uint8_t
@@ -753,7 +754,8 @@ namespace octoon
 				CoherentBit = 0x00000008,
 				FlushExplicitBit = 0x00000010,
 				DynamicStorageBit = 0x00000020,
-				ClientStorageBit = 0x00000040
+				ClientStorageBit = 0x00000040,
+				UnsynchronizedBit = 0x00000080
 			};
 		};
 
@@ -17,6 +17,10 @@ namespace octoon
 		void setFramebufferScale(std::uint32_t w, std::uint32_t h) noexcept;
 		void getFramebufferScale(std::uint32_t& w, std::uint32_t& h) noexcept;
 
+		// Backend created on activation. Null needs no window and records the commands, for runs without a display.
+		void setDeviceType(hal::GraphicsDeviceType type) noexcept;
+		hal::GraphicsDeviceType getDeviceType() const noexcept;
+
 		const hal::GraphicsDevicePtr& getDevice() const noexcept;
 		const hal::GraphicsSwapchainPtr& getSwapchain() const noexcept;
 		const hal::GraphicsContextPtr& getContext() const noexcept;
@@ -37,6 +41,7 @@ namespace octoon
 		std::uint32_t framebuffer_w_;
 		std::uint32_t framebuffer_h_;
 
+		hal::GraphicsDeviceType deviceType_;
 		hal::GraphicsDevicePtr device_;
 		hal::GraphicsSwapchainPtr swapchain_;
 		hal::GraphicsContextPtr context_;
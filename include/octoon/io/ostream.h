@@ -24,6 +24,7 @@ namespace octoon
 			streamsize gcount() const noexcept;
 
 			ios_base::pos_type tellg() noexcept;
+			ios_base::pos_type tellp() noexcept;
 
 			ostream& operator << (const char* str) noexcept;
 			ostream& operator << (const std::string& str) noexcept;
@@ -23,7 +23,7 @@ namespace octoon::bake
 		math::float3 v3;
 	};
 
-	class Lightmap final
+	class OCTOON_EXPORT Lightmap final
 	{
 	public:
 		Lightmap() noexcept;
@@ -158,6 +158,9 @@ namespace octoon::material
 		void setDirty(bool dirty) noexcept;
 		bool isDirty() const noexcept;
 
+		// Grows by one on every change, unlike the dirty flag it is never reset, so each consumer can keep the value it last saw.
+		std::uint64_t getRevision() const noexcept;
+
 		const std::vector<MaterialParam>& getMaterialParams() const noexcept;
 
 		std::size_t hash() const noexcept;
@@ -168,6 +171,7 @@ namespace octoon::material
 		std::string name_;
 
 		bool dirty_;
+		std::uint64_t revision_;
 
 		bool _enableScissorTest;
 		bool _enableSrgb;
@@ -35,6 +35,8 @@ namespace octoon::mesh
 		void setTangentArray(const math::float4s& array) noexcept;
 		void setTexcoordArray(const math::float2s& array, std::uint8_t n = 0) noexcept;
 		void setWeightArray(const skelecton::VertexWeights& array) noexcept;
+		void setSkinningModeArray(const skelecton::SkinningModes& array) noexcept;
+		void setSphericalDeformArray(const skelecton::SphericalDeforms& array) noexcept;
 		void setIndicesArray(const math::uint1s& array, std::size_t n = 0) noexcept;
 		void setBindposes(const math::float4x4s& array) noexcept;
 
@@ -44,6 +46,8 @@ namespace octoon::mesh
 		void setTangentArray(math::float4s&& array) noexcept;
 		void setTexcoordArray(math::float2s&& array, std::uint8_t n = 0) noexcept;
 		void setWeightArray(skelecton::VertexWeights&& array) noexcept;
+		void setSkinningModeArray(skelecton::SkinningModes&& array) noexcept;
+		void setSphericalDeformArray(skelecton::SphericalDeforms&& array) noexcept;
 		void setIndicesArray(math::uint1s&& array, std::size_t n = 0) noexcept;
 		void setBindposes(math::float4x4s&& array) noexcept;
 
@@ -53,6 +57,8 @@ namespace octoon::mesh
 		math::float4s& getColorArray() noexcept;
 		math::float2s& getTexcoordArray(std::uint8_t n = 0) noexcept;
 		skelecton::VertexWeights& getWeightArray() noexcept;
+		skelecton::SkinningModes& getSkinningModeArray() noexcept;
+		skelecton::SphericalDeforms& getSphericalDeformArray() noexcept;
 		math::uint1s& getIndicesArray(std::size_t n = 0) noexcept;
 		math::float4x4s& getBindposes() noexcept;
 
@@ -62,6 +68,8 @@ namespace octoon::mesh
 		const math::float4s& getColorArray() const noexcept;
 		const math::float2s& getTexcoordArray(std::uint8_t n = 0) const noexcept;
 		const skelecton::VertexWeights& getWeightArray() const noexcept;
+		const skelecton::SkinningModes& getSkinningModeArray() const noexcept;
+		const skelecton::SphericalDeforms& getSphericalDeformArray() const noexcept;
 		const math::uint1s& getIndicesArray(std::size_t n = 0) const noexcept;
 
 		const skelecton::Bones& getBoneArray(const skelecton::Bones& array) const noexcept;
@@ -71,6 +79,10 @@ namespace octoon::mesh
 		std::size_t getNumSubsets() const noexcept;
 		std::size_t getTexcoordNums() const noexcept;
 
+		// Call after writing positions or normals in place so that renderers re-upload them.
+		void markVertexDirty() noexcept;
+		std::uint32_t getVertexRevision() const noexcept;
+
 		void mergeVertices() noexcept;
 
 		bool mergeMeshes(const Mesh& mesh, bool force = false) noexcept;
@@ -98,6 +110,7 @@ namespace octoon::mesh
 
 	private:
 		std::string _name;
+		std::uint32_t _vertexRevision;
 
 		math::float3s _vertices;
 		math::float3s _normals;
@@ -109,6 +122,8 @@ namespace octoon::mesh
 
 		std::vector<skelecton::Bone> _bones;
 		std::vector<skelecton::VertexWeight> _weights;
+		std::vector<skelecton::SkinningMode> _skinningModes;
+		std::vector<skelecton::SphericalDeform> _sphericalDeforms;
 
 		std::vector<math::uint1s> _indices;
 		std::vector<math::BoundingBox> _boundingBoxs;
@@ -32,6 +32,8 @@ namespace octoon
 		GameComponentPtr clone() const noexcept override;
 
 	protected:
+		const std::shared_ptr<geometry::Geometry>& getGeometry() const noexcept;
+
 		virtual void onActivate() noexcept override;
 		virtual void onDeactivate() noexcept override;
 
@@ -0,0 +1,121 @@
+#ifndef OCTOON_SKELECTON_SKINNING_H_
+#define OCTOON_SKELECTON_SKINNING_H_
+
+#include <octoon/math/math.h>
+#include <octoon/runtime/platform.h>
+#include <octoon/model/vertex_weight.h>
+
+namespace octoon::skelecton
+{
+	enum class SkinningKernel : std::uint8_t
+	{
+		Auto,
+		Scalar,
+		SSE,
+		AVX2
+	};
+
+	// Structure-of-arrays copy of the skinning inputs of a mesh.
+	// Positions and normals are split per component, weights are packed as float4 and bones as four indices per vertex.
+	// Vertices that are not linear blended are batched by mode into index lists so that each kernel runs without branches.
+	struct OCTOON_EXPORT SkinningStreams
+	{
+		math::float1s positionX;
+		math::float1s positionY;
+		math::float1s positionZ;
+
+		math::float1s normalX;
+		math::float1s normalY;
+		math::float1s normalZ;
+
+		math::float4s weights;
+		std::vector<std::uint16_t> bones;
+
+		// Empty when every vertex is linear blended.
+		std::vector<std::uint32_t> linearIndices;
+		std::vector<std::uint32_t> dualQuaternionIndices;
+		std::vector<std::uint32_t> sphericalIndices;
+
+		// Per entry of sphericalIndices: the SDEF center and the precomputed rotation centers of both bones.
+		math::float3s sphericalCenters;
+		math::float3s sphericalR0;
+		math::float3s sphericalR1;
+
+		void setVertexArray(const math::float3s& array) noexcept;
+		void setNormalArray(const math::float3s& array) noexcept;
+		void setWeightArray(const VertexWeights& array) noexcept;
+		void setSkinningModeArray(const SkinningModes& modes, const SphericalDeforms& deforms) noexcept;
+
+		std::size_t getNumVertices() const noexcept;
+
+		bool isLinearOnly() const noexcept;
+
+		void clear() noexcept;
+	};
+
+	// Morph targets merged per vertex into compressed sparse rows.
+	// The deltas that move vertex i are entries [rows[i], rows[i + 1]), each tagged with the morph it belongs to,
+	// so accumulating every morph is a gather that writes each vertex exactly once.
+	// Deltas are padded to float4 so that a whole delta is a single vector load.
+	struct OCTOON_EXPORT MorphStreams
+	{
+		std::vector<std::uint32_t> rows;
+		std::vector<std::uint32_t> targets;
+		math::float4s deltas;
+
+		// The vertices moved by morph m are morphVertices[morphOffsets[m], morphOffsets[m + 1]),
+		// a pass only visits the vertices of the morphs it needs.
+		std::vector<std::uint32_t> morphOffsets;
+		std::vector<std::uint32_t> morphVertices;
+
+		// One pair of sparse vertex indices and position offsets per morph, in the order their weights are given.
+		void setMorphArray(std::size_t numVertices, const std::vector<std::pair<const math::uint1s*, const math::float3s*>>& morphs) noexcept;
+
+		std::size_t getNumMorphs() const noexcept;
+
+		bool empty() const noexcept;
+
+		void clear() noexcept;
+	};
+
+	// Inputs of a mesh that is skinned by the renderer instead of on the CPU.
+	// The streams and morphs are uploaded again whenever streamRevision changes, only the positions and normals whenever
+	// positionRevision changes (cloth, morph resets), the joints and weights whenever poseRevision changes.
+	struct OCTOON_EXPORT SkinningData
+	{
+		SkinningStreams streams;
+		MorphStreams morphs;
+
+		math::float4x4s joints;
+		math::float1s morphWeights;
+
+		std::uint32_t streamRevision;
+		std::uint32_t positionRevision;
+		std::uint32_t poseRevision;
+
+		SkinningData() noexcept;
+	};
+
+	OCTOON_EXPORT SkinningKernel detectSkinningKernel() noexcept;
+	OCTOON_EXPORT const char* getSkinningKernelName(SkinningKernel kernel) noexcept;
+
+	// Linear blend skins vertices [first, first + count) on the calling thread, whatever their skinning mode.
+	OCTOON_EXPORT void skinning(const math::float4x4* joints, const SkinningStreams& streams, math::float3* vertices, math::float3* normals, std::size_t first, std::size_t count, SkinningKernel kernel = SkinningKernel::Auto) noexcept;
+
+	// Skins all vertices with their own skinning mode, splitting the work in blocks across every available core.
+	OCTOON_EXPORT void skinning(const math::float4x4s& joints, const SkinningStreams& streams, math::float3s& vertices, math::float3s& normals, SkinningKernel kernel = SkinningKernel::Auto) noexcept;
+
+	// Adds the deltas of every morph, scaled by its weight, to the positions of the streams.
+	// Morphs with a zero weight are never visited, the vertices of the others are gathered in parallel blocks.
+	OCTOON_EXPORT void morphing(const MorphStreams& morphs, const math::float1s& weights, SkinningStreams& streams, SkinningKernel kernel = SkinningKernel::Auto) noexcept;
+
+	// Moves the streams from the weights in previous to the new weights without restoring the whole mesh.
+	// Only the vertices of morphs whose weight changed are recomputed, from their base position, so no error builds up across frames.
+	// A missing previous weight counts as zero.
+	OCTOON_EXPORT void morphing(const MorphStreams& morphs, const math::float1s& weights, const math::float1s& previous, const math::float3s& base, SkinningStreams& streams, SkinningKernel kernel = SkinningKernel::Auto) noexcept;
+
+	// CPU reference of the GPU path: the morphs are applied to the bind pose, which is then skinned.
+	OCTOON_EXPORT void skinning(const SkinningData& data, math::float3s& vertices, math::float3s& normals, SkinningKernel kernel = SkinningKernel::Auto) noexcept;
+}
+
+#endif
@@ -2,6 +2,7 @@
 #define OCTOON_SKELECTON_VERTEX_WEIGHT_H_
 
 #include <vector>
+#include <octoon/math/math.h>
 
 namespace octoon::skelecton
 {
@@ -39,8 +40,26 @@ namespace octoon::skelecton
 		};
 	}
 
+	enum class SkinningMode : std::uint8_t
+	{
+		Linear,
+		DualQuaternion,
+		Spherical
+	};
+
+	// Center and rotation points of a spherical deform (SDEF) vertex between its first two bones.
+	struct SphericalDeform
+	{
+		math::float3 center;
+		math::float3 r0;
+		math::float3 r1;
+	};
+
 	using VertexWeight = detail::VertexWeight<std::uint16_t, float>;
 	using VertexWeights = std::vector<VertexWeight>;
+
+	using SkinningModes = std::vector<SkinningMode>;
+	using SphericalDeforms = std::vector<SphericalDeform>;
 }
 
 #endif
\ No newline at end of file
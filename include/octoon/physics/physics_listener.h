@@ -3,6 +3,7 @@
 
 #include <octoon/runtime/platform.h>
 #include <octoon/physics/physics_type.h>
+#include <octoon/math/math.h>
 
 namespace octoon
 {
@@ -15,6 +16,8 @@ namespace octoon
 			virtual ~PhysicsListener() noexcept = default;
 
 			virtual void onFetchResult() noexcept;
+			// Receives the pose read by PhysicsScene::fetchActivePoses, the default forwards to onFetchResult().
+			virtual void onFetchResult(const math::float3& position, const math::Quaternion& rotation) noexcept;
 
 		private:
 			PhysicsListener(const PhysicsListener&) = delete;
@@ -2,12 +2,14 @@
 #define OCTOON_PHYSICS_SCENE_H_
 
 #include <memory>
+#include <vector>
 
 #include <octoon/runtime/platform.h>
 #include <octoon/math/math.h>
 
 #include <octoon/physics/physics_type.h>
 #include <octoon/physics/physics_rigidbody.h>
+#include <octoon/physics/physics_listener.h>
 
 namespace octoon
 {
@@ -17,8 +19,25 @@ namespace octoon
 		{
 		public:
 			math::float3 gravity;
+			std::uint32_t threadCount;
 			PhysicsSceneDesc()
-				:gravity (0.f, -9.8f, 0.f) {}
+				:gravity (0.f, -9.8f, 0.f), threadCount(4) {}
+		};
+
+		// Pose of a body that moved in the last step, read back in bulk by PhysicsScene::fetchActivePoses.
+		struct OCTOON_EXPORT PhysicsActivePose
+		{
+			PhysicsListener* listener;
+			math::float3 position;
+			math::Quaternion rotation;
+		};
+
+		// Pose written in bulk by PhysicsScene::setKinematicTargets, entries without a rigidbody are skipped.
+		struct OCTOON_EXPORT PhysicsKinematicTarget
+		{
+			PhysicsRigidbody* rigidbody;
+			math::float3 position;
+			math::Quaternion rotation;
 		};
 
         class OCTOON_EXPORT PhysicsScene
@@ -32,10 +51,19 @@ namespace octoon
 
 			virtual void addRigidbody(std::shared_ptr<PhysicsRigidbody> rigidbody) = 0;
 			virtual void removeRigidbody(std::shared_ptr<PhysicsRigidbody> rigidbody) = 0;
+			// simulate() may return before the step is done, the scene is read back once fetchResults() returned.
 			virtual void simulate(float time) = 0;
 			virtual void fetchResults() = 0;
 			virtual void fetchFinish() = 0;
 
+			// Bulk forms of fetchFinish() and PhysicsRigidbody::setPositionAndRotation, which move the poses of all bodies
+			// through one contiguous array instead of a virtual call per body. fetchActivePoses() replaces the content of poses.
+			virtual void fetchActivePoses(std::vector<PhysicsActivePose>& poses) = 0;
+			virtual void setKinematicTargets(const PhysicsKinematicTarget* targets, std::size_t count) = 0;
+
+			// Wall time in seconds from the last simulate() until its results were ready.
+			virtual float getSimulationTime() const noexcept = 0;
+
 		private:
 			PhysicsScene(const PhysicsScene&) = delete;
 			PhysicsScene& operator=(const PhysicsScene&) = delete;
@@ -19,6 +19,36 @@ namespace octoon
 		void setSolverIterationCounts(std::uint32_t iterationCounts) noexcept;
 		std::uint32_t getSolverIterationCounts() const noexcept;
 
+		// Worker threads of the simulation, takes effect when the feature is activated.
+		void setThreadCount(std::uint32_t count) noexcept;
+		std::uint32_t getThreadCount() const noexcept;
+
+		// Starts the step in onFrameBegin so that it runs next to the object updates of the frame, and fetches it in onFrame.
+		// Kinematic bodies moved during the frame then reach the simulation one step later.
+		void setAsyncSimulation(bool enable) noexcept;
+		bool getAsyncSimulation() const noexcept;
+
+		// Writes each body at its pose between the last two steps, matching the part of a step the timer has run ahead.
+		// This hides the steps at refresh rates above the fixed rate, at the cost of showing the bodies one step late.
+		void setInterpolation(bool enable) noexcept;
+		bool getInterpolation() const noexcept;
+
+		// Completes a step in flight and writes the bodies back to their objects, onFrame calls it when nobody did before.
+		void fetchResults() except;
+
+		// Poses written by the objects are collected here and passed to the scene in one call before the next step. The slot
+		// returned by addKinematicTarget stays valid while getKinematicGeneration() is unchanged, so that a body moved again
+		// within the same frame overwrites its entry instead of adding another one.
+		std::size_t addKinematicTarget(const physics::PhysicsKinematicTarget& target) noexcept;
+		physics::PhysicsKinematicTarget& getKinematicTarget(std::size_t slot) noexcept;
+		std::uint32_t getKinematicGeneration() const noexcept;
+
+		// Seconds of the last frame: the steps from simulate() until their results, how long the main thread blocked on
+		// them, and the part of the steps that ran behind other work.
+		float getSimulationTime() const noexcept;
+		float getWaitTime() const noexcept;
+		float getHiddenTime() const noexcept;
+
 	public:
 		void onActivate() except override;
 		void onDeactivate() noexcept override;
@@ -30,23 +60,45 @@ namespace octoon
 		void onFrameEnd() noexcept override;
 
 		void onFixedUpdate(const std::any& data) noexcept;
+		void onInterpolate(const std::any& data) noexcept;
 
 	public:
 		std::shared_ptr<physics::PhysicsContext> getContext();
 		std::shared_ptr<physics::PhysicsScene> getScene();
 
+	private:
+		void step() except;
+		void simulateSteps() except;
+
+		void flushKinematicTargets() noexcept;
+		void fetchActivePoses(bool stepped) noexcept;
+
 	private:
 		PhysicsFeature(const PhysicsFeature&) = delete;
 		PhysicsFeature& operator=(const PhysicsFeature&) = delete;
 
     private:
-		bool needUpdate_;
+		bool needFetch_;
+		bool asyncSimulation_;
+		bool interpolation_;
+
+		std::uint32_t fixedSteps_;
+		float alpha_;
 
 		float timeInterval_;
 		std::uint32_t iterationCounts_;
+		std::uint32_t threadCount_;
+
+		float simulationTime_;
+		float waitTime_;
 
 		math::float3 gravity_;
 
+		std::uint32_t kinematicGeneration_;
+		std::vector<physics::PhysicsKinematicTarget> kinematicTargets_;
+		std::vector<physics::PhysicsActivePose> activePoses_;
+		std::vector<physics::PhysicsActivePose> previousPoses_;
+
 		std::shared_ptr<physics::PhysicsContext> physics_context;
 		std::shared_ptr<physics::PhysicsScene> physics_scene;
     };
@@ -50,8 +50,10 @@ namespace octoon
 		std::uint16_t getGroupMask() const noexcept;
 		RigidbodySleepMode getSleepMode() const noexcept;
 
+		// Moves the body to the pose, the poses of all bodies are written to the scene together before the next step.
 		void rotation(const math::Quaternion& quat) noexcept;
 		void movePosition(const math::float3& position) noexcept;
+		void movePositionAndRotation(const math::float3& position, const math::Quaternion& quat) noexcept;
 
 		void clearForce() noexcept;
 		void clearTorque() noexcept;
@@ -70,12 +72,14 @@ namespace octoon
         void onDetachComponent(const GameComponentPtr& component) noexcept;
 
 		void onFetchResult() noexcept override;
+		void onFetchResult(const math::float3& position, const math::Quaternion& rotation) noexcept override;
 
 		void onLayerChangeAfter() noexcept;
 		void onMoveAfter() noexcept;
 
 	private:
 		void setupRigidbody(class ColliderComponent& collder) noexcept;
+		void updateKinematicTarget() noexcept;
 
     private:
         bool isKinematic_;
@@ -97,6 +101,9 @@ namespace octoon
 		math::float3 position_;
 		math::Quaternion rotation_;
 
+		std::size_t kinematicSlot_;
+		std::uint32_t kinematicGeneration_;
+
         RigidbodySleepMode sleepMode_;
 
 		std::shared_ptr<physics::PhysicsRigidbody> rigidbody_;
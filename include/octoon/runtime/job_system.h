@@ -0,0 +1,110 @@
+#ifndef OCTOON_JOB_SYSTEM_H_
+#define OCTOON_JOB_SYSTEM_H_
+
+#include <octoon/runtime/platform.h>
+#include <octoon/runtime/singleton.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace octoon
+{
+	namespace runtime
+	{
+		// Completion counter of a set of jobs. The first exception thrown by one of them is kept and rethrown by JobSystem::wait.
+		class OCTOON_EXPORT JobGroup final
+		{
+		public:
+			JobGroup() noexcept;
+			~JobGroup() noexcept;
+
+			bool done() const noexcept;
+
+		private:
+			friend class JobSystem;
+
+			JobGroup(const JobGroup&) = delete;
+			JobGroup& operator=(const JobGroup&) = delete;
+
+		private:
+			std::atomic<std::size_t> pending_;
+
+			std::mutex lock_;
+			std::exception_ptr exception_;
+		};
+
+		// Pool of worker threads with one job deque each. A worker runs the newest job of its own deque and steals the oldest
+		// job of another worker once it runs dry. Threads waiting on a group execute pending jobs instead of blocking, so jobs
+		// may submit and wait on nested groups. The workers are started by the first submit.
+		class OCTOON_EXPORT JobSystem final
+		{
+			OctoonDeclareSingleton(JobSystem)
+		public:
+			typedef std::function<void()> Job;
+			typedef std::function<void(std::size_t begin, std::size_t end)> RangeJob;
+
+			JobSystem() noexcept;
+			~JobSystem() noexcept;
+
+			// Number of worker threads besides the caller, 0 picks one less than the hardware threads.
+			// Must not be changed while jobs are pending.
+			void setThreadCount(std::size_t count) noexcept;
+			std::size_t getThreadCount() const noexcept;
+
+			void submit(JobGroup& group, Job&& job) noexcept;
+			void wait(JobGroup& group) noexcept(false);
+
+			// Splits [0, count) into ranges of at least grain elements and returns once all of them ran.
+			void parallelFor(std::size_t count, std::size_t grain, const RangeJob& job) noexcept(false);
+
+		private:
+			struct Task
+			{
+				Job job;
+				JobGroup* group;
+			};
+
+			struct Worker
+			{
+				std::mutex lock;
+				std::deque<Task> tasks;
+				std::thread thread;
+			};
+
+			void start() noexcept;
+			void stop() noexcept;
+
+			void run(std::size_t index) noexcept;
+			void execute(Task& task) noexcept;
+
+			bool pop(std::size_t index, Task& task) noexcept;
+			bool steal(std::size_t index, Task& task) noexcept;
+
+		private:
+			JobSystem(const JobSystem&) = delete;
+			JobSystem& operator=(const JobSystem&) = delete;
+
+		private:
+			std::size_t threadCount_;
+			std::vector<std::unique_ptr<Worker>> workers_;
+
+			std::mutex startLock_;
+			std::atomic<bool> started_;
+			std::atomic<std::size_t> next_;
+			std::atomic<std::size_t> pending_;
+
+			bool quit_;
+			std::mutex sleepLock_;
+			std::condition_variable wake_;
+		};
+	}
+}
+
+#endif
@@ -0,0 +1,118 @@
+#ifndef OCTOON_PROFILER_H_
+#define OCTOON_PROFILER_H_
+
+#include <octoon/runtime/platform.h>
+#include <octoon/runtime/singleton.h>
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string_view>
+#include <vector>
+
+namespace octoon
+{
+	namespace runtime
+	{
+		// One timed scope. Names are kept as pointers, so they have to outlive the profiler: string literals or RTTI names.
+		struct ProfileEvent
+		{
+			const char* name;
+			std::uint64_t begin;
+			std::uint64_t end;
+			std::uint32_t thread;
+			std::uint32_t depth;
+		};
+
+		// Collects the zones of all threads. Each thread writes to a ring buffer of its own without locking, endFrame()
+		// copies what the threads wrote since the last frame. A thread that writes more than a ring between two frames, or
+		// wraps its ring while endFrame() copies it, loses its oldest events. Zones record nothing while the profiler is disabled.
+		class OCTOON_EXPORT Profiler final
+		{
+			OctoonDeclareSingleton(Profiler)
+		public:
+			Profiler() noexcept;
+			~Profiler() noexcept;
+
+			void setEnable(bool enable) noexcept;
+			bool getEnable() const noexcept;
+
+			// Frame boundaries, driven by GameServer::update. Events of threads still inside a zone appear once it closed.
+			void beginFrame() noexcept;
+			void endFrame() noexcept;
+
+			// Events of the last frame in the order of their threads, and its length in milliseconds.
+			const std::vector<ProfileEvent>& getFrameEvents() const noexcept;
+			double getFrameTime() const noexcept;
+
+			// Keeps the events of every frame until they are saved as Chrome trace JSON, readable by chrome://tracing or Perfetto.
+			void setCapture(bool enable) noexcept;
+			bool getCapture() const noexcept;
+			bool saveTrace(std::string_view path) const noexcept;
+
+			// Nanoseconds on the steady clock, the unit of ProfileEvent::begin and end.
+			static std::uint64_t now() noexcept;
+
+		private:
+			friend class ProfileZone;
+
+			static constexpr std::size_t BufferSize = 1 << 14;
+
+			struct Buffer
+			{
+				std::unique_ptr<ProfileEvent[]> events;
+				std::atomic<std::uint64_t> head;
+				std::uint64_t tail;
+				std::uint32_t thread;
+				std::uint32_t depth;
+			};
+
+			Buffer* getThreadBuffer() noexcept;
+
+		private:
+			Profiler(const Profiler&) = delete;
+			Profiler& operator=(const Profiler&) = delete;
+
+		private:
+			std::atomic<bool> enable_;
+			bool capture_;
+
+			std::uint64_t frameBegin_;
+			std::uint64_t frameEnd_;
+			std::uint64_t captureBegin_;
+
+			std::mutex lock_;
+			std::vector<std::unique_ptr<Buffer>> buffers_;
+
+			std::vector<ProfileEvent> frameEvents_;
+			std::vector<ProfileEvent> captureEvents_;
+		};
+
+		class OCTOON_EXPORT ProfileZone final
+		{
+		public:
+			explicit ProfileZone(const char* name) noexcept;
+			~ProfileZone() noexcept;
+
+		private:
+			ProfileZone(const ProfileZone&) = delete;
+			ProfileZone& operator=(const ProfileZone&) = delete;
+
+		private:
+			const char* name_;
+			std::uint64_t begin_;
+		};
+	}
+}
+
+#define OCTOON_PROFILE_CONCAT_(a, b) a##b
+#define OCTOON_PROFILE_CONCAT(a, b) OCTOON_PROFILE_CONCAT_(a, b)
+
+#if defined(OCTOON_FEATURE_PROFILER_ENABLE)
+#	define OCTOON_PROFILE_ZONE(name) octoon::runtime::ProfileZone OCTOON_PROFILE_CONCAT(octoonProfileZone, __LINE__)(name)
+#else
+#	define OCTOON_PROFILE_ZONE(name)
+#endif
+
+#endif
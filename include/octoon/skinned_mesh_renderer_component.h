@@ -5,6 +5,7 @@
 #include <octoon/mesh_renderer_component.h>
 #include <octoon/skinned_component.h>
 #include <octoon/cloth_component.h>
+#include <octoon/model/skinning.h>
 
 namespace octoon
 {
@@ -32,10 +33,17 @@ namespace octoon
 		void setTextureBlendEnable(bool enable) noexcept;
 		bool getTextureBlendEnable() const noexcept;
 
+		// Leaves skinning and morph accumulation to the renderer, which runs them in a compute shader where it can.
+		void setGpuSkinningEnable(bool enable) noexcept;
+		bool getGpuSkinningEnable() const noexcept;
+
 		void uploadMeshData(const mesh::MeshPtr& mesh) noexcept override;
 
 		GameComponentPtr clone() const noexcept override;
 
+		GameAccessFlags getReadAccess() const noexcept override;
+		GameAccessFlags getWriteAccess() const noexcept override;
+
 	private:
 		void onActivate() noexcept override;
 		void onDeactivate() noexcept override;
@@ -52,6 +60,8 @@ namespace octoon
 
 	private:
 		void updateMeshData() noexcept;
+		void updateStreamData() noexcept;
+		void updateMorphStreamData() noexcept;
 		void updateJointData() noexcept;
 		void updateBoneData() noexcept;
 		void updateClothBlendData() noexcept;
@@ -67,15 +77,20 @@ namespace octoon
 		bool clothEnable_;
 		bool morphEnable_;
 		bool textureEnable_;
+		bool gpuSkinningEnable_;
+		bool blendDirty_;
+		bool morphDirty_;
 
 		GameObjects transforms_;
 
-		math::float4x4s joints_;
-		hal::GraphicsDataPtr jointData_;
-
 		mesh::MeshPtr mesh_;
 		mesh::MeshPtr skinnedMesh_;
 
+		std::shared_ptr<skelecton::SkinningData> skinningData_;
+
+		// Morph weights currently baked into the CPU streams.
+		math::float1s morphWeights_;
+
 		std::vector<class ClothComponent*> clothComponents_;
 		std::vector<class SkinnedMorphComponent*> morphComponents_;
 		std::vector<class SkinnedTextureComponent*> textureComponents_;
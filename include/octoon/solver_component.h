@@ -36,7 +36,19 @@ namespace octoon
 		void setBones(const GameObjects& bones) noexcept;
 		const GameObjects& getBones() const noexcept;
 
+		// Runs the IK and rotation links once, independent of the time step.
+		void solve() noexcept;
+
+		// Leaves the solving to the owner of a CCDSolverSchedule, the solver then no longer runs from its own late update.
+		void setScheduled(bool scheduled) noexcept;
+		bool getScheduled() const noexcept;
+
 		GameComponentPtr clone() const noexcept;
+
+		GameAccessFlags getReadAccess() const noexcept override;
+		GameAccessFlags getWriteAccess() const noexcept override;
+		void getLinkedObjects(GameObjectRaws& objects) const noexcept override;
+
 	private:
 		void onActivate() noexcept override;
 		void onDeactivate() noexcept override;
@@ -44,9 +56,17 @@ namespace octoon
 		void onLateUpdate() noexcept override;
 
 	private:
+		friend class CCDSolverSchedule;
+
 		void evaluateIK() noexcept;
 		void evaluateRotationLink() noexcept;
 
+		void updateWriteAccess() const noexcept;
+
+		// One CCD step of a joint, from the directions to the end and to the target in its local space. Returns false when
+		// the joint stays as it is.
+		static bool rotateJoint(const math::Quaternion& rotation, const math::float3& localJointEnd, const math::float3& localJointTarget, const class RotationLimitComponent* limit, math::Quaternion& result) noexcept;
+
 	private:
 		CCDSolverComponent(const CCDSolverComponent&) = delete;
 		CCDSolverComponent& operator=(const CCDSolverComponent&) = delete;
@@ -57,9 +77,14 @@ namespace octoon
 		float tolerance_;
 
 		bool enableAxisLimit_;
+		bool scheduled_;
 
 		std::uint32_t maxIterations_;
 
+		// Physics when kinematic bodies hang from the bones, refreshed once the hierarchy revision moves on.
+		mutable GameAccessFlags writeAccess_;
+		mutable std::size_t writeAccessRevision_;
+
 		GameObjects bones_;
 		GameObjectPtr target_;
 	};
@@ -0,0 +1,97 @@
+#ifndef OCTOON_CCD_SOLVER_SCHEDULE_H_
+#define OCTOON_CCD_SOLVER_SCHEDULE_H_
+
+#include <octoon/solver_component.h>
+#include <octoon/rotation_limit_component.h>
+#include <octoon/transform_hierarchy.h>
+
+namespace octoon
+{
+	// Solves the CCD solvers of one avatar together. The solvers are split into levels once: a solver goes one level
+	// below every earlier solver whose chain or rotation links it reads or writes, so independent chains such as the two
+	// legs share a level while a toe waits for its leg. Each level loads the transforms of its chains, solves them in
+	// parallel on those copies and writes the joints back through one TransformHierarchy update, followed by the rotation
+	// links. A chain whose joints do not all lie above its end, or whose target moves with the chain, is solved on the
+	// components instead. Iterations, tolerances and time steps are the ones of the solvers.
+	class OCTOON_EXPORT CCDSolverSchedule final
+	{
+	public:
+		CCDSolverSchedule() noexcept;
+		explicit CCDSolverSchedule(const std::vector<std::shared_ptr<CCDSolverComponent>>& solvers) noexcept;
+		~CCDSolverSchedule() noexcept;
+
+		// Solvers in the order they would run one after another. Set them again after changing the bones of one.
+		void setSolvers(const std::vector<std::shared_ptr<CCDSolverComponent>>& solvers) noexcept;
+		const std::vector<std::shared_ptr<CCDSolverComponent>>& getSolvers() const noexcept;
+
+		void clear() noexcept;
+		bool empty() const noexcept;
+
+		// Runs every solver once like CCDSolverComponent::solve, independent of its time step and of whether it is active.
+		void solve() noexcept;
+
+		// Advances the time steps of the active solvers by delta and runs those that are due, like their late update does.
+		void update(float delta) noexcept;
+
+	private:
+		struct Chain
+		{
+			CCDSolverComponent* solver;
+			const GameObject* object;
+			const GameObject* target;
+			std::size_t numBones;
+
+			bool cached;
+			bool due;
+
+			std::shared_ptr<TransformComponent> goal;
+			std::shared_ptr<TransformComponent> parent;
+
+			// Path from the topmost joint down to the end, with the joints at the positions in links.
+			std::vector<std::shared_ptr<TransformComponent>> nodes;
+			std::vector<const GameObject*> parentObjects;
+			std::vector<std::size_t> links;
+			std::vector<std::size_t> indices;
+			std::vector<std::shared_ptr<RotationLimitComponent>> limits;
+
+			math::float3 goalTranslate;
+			math::float4x4 parentWorld;
+
+			math::float3s localTranslates;
+			math::float3s localScales;
+			math::Quaternions localRotations;
+			math::float4x4s locals;
+
+			math::float4x4s worlds;
+			math::float3s translates;
+			math::Quaternions rotations;
+
+			// Position of the first node whose world is stale, every node below it is stale as well.
+			std::size_t dirty;
+		};
+
+		bool validate() const noexcept;
+
+		void solveLevels() noexcept;
+
+		static void load(Chain& chain) noexcept;
+		static void solveChain(Chain& chain) noexcept;
+		static void updateWorlds(Chain& chain, std::size_t node) noexcept;
+
+	private:
+		CCDSolverSchedule(const CCDSolverSchedule&) = delete;
+		CCDSolverSchedule& operator=(const CCDSolverSchedule&) = delete;
+
+	private:
+		std::vector<std::shared_ptr<CCDSolverComponent>> solvers_;
+
+		std::vector<Chain> chains_;
+		std::vector<std::vector<std::size_t>> levels_;
+		std::vector<Chain*> pending_;
+
+		// Joints of the cached chains, written back together after each level.
+		TransformHierarchy hierarchy_;
+	};
+}
+
+#endif
@@ -13,12 +13,24 @@ namespace octoon
 		TimerFeature() noexcept;
 		~TimerFeature() noexcept;
 
+		// Every timeStep seconds of real time a "feature:timer:fixed" message advances the simulation by timeInterval seconds.
 		void setTimeStep(float timeStep) noexcept;
 		void setTimeInterval(float timeInterval) noexcept;
 
 		float getTimeStep() const noexcept;
 		float getTimeInterval() const noexcept;
 
+		// Upper bound of fixed steps per frame. Time beyond it is dropped, so a slow frame cannot queue ever more steps.
+		void setMaxFixedSteps(std::uint32_t count) noexcept;
+		std::uint32_t getMaxFixedSteps() const noexcept;
+
+		// Replaces the real time of a frame when above zero, so runs like the benchmarks advance the same on every machine.
+		void setFrameDelta(float delta) noexcept;
+		float getFrameDelta() const noexcept;
+
+		// Fraction of a step that has passed since the last fixed step, sent each frame as "feature:timer:interpolate".
+		float interpolation() const noexcept;
+
 		float fps() const noexcept;
 		float averageFps() const noexcept;
 
@@ -26,6 +38,7 @@ namespace octoon
 		float startTime() const noexcept;
 		float frameTime() const noexcept;
 
+		// Real time of the last frame, limited like the fixed steps and scaled by timeInterval / timeStep.
 		float delta() const noexcept;
 
 		float elapsed() const noexcept;
@@ -49,6 +62,11 @@ namespace octoon
 		float timeStep_;
 		float timeInterval_;
 
+		float delta_;
+		float frameDelta_;
+		float interpolation_;
+		std::uint32_t maxFixedSteps_;
+
 		std::unique_ptr<runtime::Timer> timer_;
 	};
 }
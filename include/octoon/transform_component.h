@@ -71,6 +71,10 @@ namespace octoon
 		void onMoveBefore() except override;
 		void onMoveAfter() except override;
 
+	private:
+		friend class TransformHierarchy;
+		void setHierarchyTransform(const math::float3& localTranslate, const math::Quaternion& localRotation, const math::float3& localScale, const math::float4x4& local, const math::float4x4& world, const math::Quaternion& rotation, const math::float3& scale) const noexcept;
+
 	private:
 		friend GameObject;
 		void updateLocalChildren() const noexcept;
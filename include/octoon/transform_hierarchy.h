@@ -0,0 +1,87 @@
+#ifndef OCTOON_TRANSFORM_HIERARCHY_H_
+#define OCTOON_TRANSFORM_HIERARCHY_H_
+
+#include <octoon/transform_component.h>
+
+namespace octoon
+{
+	// Flat store for the transforms of a set of objects that are written together every frame, such as the bones of an avatar.
+	// Local and world matrices live in arrays sorted by depth, so setters only flag the node and update() resolves every
+	// world matrix in one forward pass. The results are committed to the TransformComponents without recursing through their
+	// children, and each changed subtree receives a single onMoveBefore/onMoveAfter pair instead of one per setter.
+	// Nodes are addressed by their position in the array passed to setObjects().
+	class OCTOON_EXPORT TransformHierarchy final
+	{
+	public:
+		TransformHierarchy() noexcept;
+		explicit TransformHierarchy(const GameObjects& objects) noexcept;
+		~TransformHierarchy() noexcept;
+
+		void setObjects(const GameObjects& objects) noexcept;
+		void clear() noexcept;
+
+		bool empty() const noexcept;
+		std::size_t size() const noexcept;
+
+		void setLocalTranslate(std::size_t index, const math::float3& v) noexcept;
+		const math::float3& getLocalTranslate(std::size_t index) const noexcept;
+
+		void setLocalScale(std::size_t index, const math::float3& v) noexcept;
+		const math::float3& getLocalScale(std::size_t index) const noexcept;
+
+		void setLocalQuaternion(std::size_t index, const math::Quaternion& quat) noexcept;
+		const math::Quaternion& getLocalQuaternion(std::size_t index) const noexcept;
+
+		// World matrix as of the last update().
+		const math::float4x4& getTransform(std::size_t index) const noexcept;
+
+		// Reads back the local transforms of the components, picking up anything written to them outside of this store.
+		// The store is rebuilt when an object was moved to another parent since it was set.
+		void fetch() noexcept;
+
+		// Resolves the world matrices of the flagged nodes and their descendants and commits them.
+		void update() noexcept;
+
+	private:
+		enum Dirty : std::uint8_t
+		{
+			DirtyLocal = 1,
+			DirtyWorld = 2
+		};
+
+		void markLocal(std::size_t slot) noexcept;
+
+	private:
+		TransformHierarchy(const TransformHierarchy&) = delete;
+		TransformHierarchy& operator=(const TransformHierarchy&) = delete;
+
+	private:
+		// Every array below is indexed by slot, the position of a node in depth order. slots_ maps the caller's index to it.
+		GameObjects objects_;
+
+		std::vector<std::size_t> slots_;
+		std::vector<std::shared_ptr<TransformComponent>> transforms_;
+		std::vector<const GameObject*> parentObjects_;
+
+		// Slot of the closest ancestor inside the store, or -1. When the direct parent is not part of the store its world
+		// comes from the parent component instead, nested marks those whose parent still lies below another node of the store.
+		std::vector<std::int32_t> parents_;
+		std::vector<std::shared_ptr<TransformComponent>> externals_;
+		std::vector<std::uint8_t> nested_;
+
+		math::float3s localTranslates_;
+		math::float3s localScales_;
+		math::Quaternions localRotations_;
+		math::float4x4s locals_;
+
+		math::float3s scales_;
+		math::Quaternions rotations_;
+		math::float4x4s worlds_;
+		math::float4x4s externalWorlds_;
+
+		std::vector<std::uint8_t> dirty_;
+		bool needUpdates_;
+	};
+}
+
+#endif
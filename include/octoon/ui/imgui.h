@@ -298,6 +298,7 @@ namespace octoon::imgui
 	OCTOON_EXPORT void showStyleEditor(GuiStyle* style = nullptr) noexcept;
 	OCTOON_EXPORT void showTestWindow() noexcept;
 	OCTOON_EXPORT void showMetricsWindow(bool* isOpened = nullptr) noexcept;
+	OCTOON_EXPORT void showProfilerWindow(bool* isOpened = nullptr) noexcept;
 
 	OCTOON_EXPORT bool begin(const char* name, bool* isOpened = nullptr, GuiWindowFlags flags = 0) noexcept;
 	OCTOON_EXPORT bool begin(const char* name, bool* isOpened, const float2& size_on_first_use, float bg_alpha = -1.0f, GuiWindowFlags flags = 0) noexcept;
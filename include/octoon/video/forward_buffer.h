@@ -6,6 +6,10 @@
 
 namespace octoon::video
 {
+	// Positions and normals live in slot 0, texture coordinates in slot 1.
+	// Once a mesh is rewritten in place the slot 0 stream moves to a persistently mapped ring of frames,
+	// so only that stream is written again while the texture coordinates and indices are left untouched.
+	// Each frame of the ring is fenced by the device and only waited on when it comes round again.
 	class OCTOON_EXPORT ForwardBuffer final
 	{
 	public:
@@ -16,28 +20,45 @@ namespace octoon::video
 		void setMesh(const std::shared_ptr<mesh::Mesh>& mesh) noexcept(false);
 		const std::shared_ptr<mesh::Mesh>& getMesh() const noexcept;
 
+		void update() noexcept(false);
+
+		bool isDynamic() const noexcept;
+
 		std::size_t getNumVertices() const noexcept;
 		std::size_t getNumIndices(std::size_t n) const noexcept;
 
 		const hal::GraphicsDataPtr& getVertexBuffer() const noexcept;
+		const hal::GraphicsDataPtr& getTexcoordBuffer() const noexcept;
 		const hal::GraphicsDataPtr& getIndexBuffer(std::size_t n) const noexcept;
 
+		std::intptr_t getVertexOffset() const noexcept;
+
 	private:
 		void updateData(const std::shared_ptr<mesh::Mesh>& mesh) noexcept(false);
+		void updateVertexData(const mesh::Mesh& mesh) noexcept(false);
+
+		static void writeVertexStream(const mesh::Mesh& mesh, float* data) noexcept;
+		static void writeTexcoordStream(const mesh::Mesh& mesh, float* data) noexcept;
 
 	private:
 		ForwardBuffer(const ForwardBuffer&) = delete;
 		ForwardBuffer& operator=(const ForwardBuffer&) = delete;
 
 	private:
+		bool dynamic_;
+
 		std::uint32_t numVertices_;
-		std::uint32_t numIndices_;
+		std::uint32_t revision_;
+		std::uint32_t frame_;
+
+		std::intptr_t vertexOffset_;
 
 		hal::GraphicsDataPtr vertices_;
+		hal::GraphicsDataPtr texcoords_;
 		std::vector<hal::GraphicsDataPtr> indices_;
 
 		std::shared_ptr<mesh::Mesh> mesh_;
 	};
 }
 
-#endif
\ No newline at end of file
+#endif
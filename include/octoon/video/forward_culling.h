@@ -0,0 +1,55 @@
+#ifndef OCTOON_VIDEO_FORWARD_CULLING_H_
+#define OCTOON_VIDEO_FORWARD_CULLING_H_
+
+#include <octoon/camera/camera.h>
+#include <octoon/geometry/geometry.h>
+
+namespace octoon::video
+{
+	// Counters summed over every pass culled since the start, take the difference of two reads for one frame.
+	struct CullingStatistics
+	{
+		std::uint64_t tested;
+		std::uint64_t culled;
+		std::uint64_t skippedDraws;
+	};
+
+	// Builds the visible list of a camera pass. Geometries of other layers, hidden ones and those without a mesh are dropped,
+	// the rest are tested four at a time against the six planes of the camera's view projection, with their mesh bounds taken
+	// into world space by the geometry transform. Large lists are split across the job system. Skinned geometries and meshes
+	// without bounds always pass, their bind pose says nothing about where the vertices end up.
+	class OCTOON_EXPORT ForwardCulling final
+	{
+	public:
+		ForwardCulling() noexcept;
+		~ForwardCulling() noexcept;
+
+		// Replaces visible with the geometries of the camera's frustum, in their order in geometries.
+		void cull(const camera::Camera& camera, const std::vector<geometry::Geometry*>& geometries, std::vector<geometry::Geometry*>& visible) noexcept;
+
+		const CullingStatistics& getStatistics() const noexcept;
+
+	private:
+		struct Plane
+		{
+			float x, y, z, w;
+		};
+
+		void extractPlanes(const math::float4x4& viewProject) noexcept;
+		void testRange(std::size_t begin, std::size_t end) noexcept;
+
+	private:
+		ForwardCulling(const ForwardCulling&) = delete;
+		ForwardCulling& operator=(const ForwardCulling&) = delete;
+
+	private:
+		Plane planes_[6];
+
+		std::vector<geometry::Geometry*> candidates_;
+		std::vector<std::uint8_t> results_;
+
+		CullingStatistics statistics_;
+	};
+}
+
+#endif
@@ -12,19 +12,36 @@ namespace octoon::video
 	class OCTOON_EXPORT ForwardMaterial final
 	{
 	public:
+		// Layout of the std140 Camera uniform block read by instancing materials.
+		struct CameraBlock
+		{
+			math::float4x4 projectionMatrix;
+			math::float4x4 viewMatrix;
+			math::float4x4 viewProjMatrix;
+		};
+
 		ForwardMaterial() noexcept;
-		ForwardMaterial(const material::MaterialPtr& material, const ForwardScene& context) noexcept;
+		ForwardMaterial(const material::MaterialPtr& material, const ForwardScene& context, bool instancing = false) noexcept;
 		virtual ~ForwardMaterial() noexcept;
 
 		void setMaterial(const material::MaterialPtr& material, const ForwardScene& context) noexcept;
 		const material::MaterialPtr& getMaterial() const noexcept;
 
+		// An instancing material reads the model matrix from four per instance vectors in vertex slot 2 and the camera matrices
+		// from the Camera uniform block, so none of its uniforms change between the draws of one pass.
+		bool getInstancing() const noexcept;
+
 		const hal::GraphicsPipelinePtr& getPipeline() const noexcept;
 		const hal::GraphicsDescriptorSetPtr& getDescriptorSet() const noexcept;
 
-		void update(const camera::Camera& camera, const geometry::Geometry& geometry, const ForwardScene& context) noexcept;
+		// Writes the uniforms of the geometry drawn by the camera. Within one pass the camera and light uniforms are written
+		// once, pass 0 writes them on every call. Instancing materials take the camera matrices from cameraBuffer instead.
+		// Returns whether any uniform changed, the descriptor set must then be bound again.
+		bool update(const camera::Camera& camera, const geometry::Geometry& geometry, const ForwardScene& context, std::uint64_t pass = 0, const hal::GraphicsDataPtr& cameraBuffer = nullptr) noexcept;
 
 	private:
+		void updatePass(const camera::Camera& camera, const ForwardScene& context, const hal::GraphicsDataPtr& cameraBuffer) noexcept;
+		void updateObject(const camera::Camera& camera, const geometry::Geometry& geometry) noexcept;
 		void updateParameters(bool force = false) noexcept;
 		void updateMaterial(const material::MaterialPtr& material, const ForwardScene& context) noexcept(false);
 
@@ -39,6 +56,8 @@ namespace octoon::video
 		ForwardMaterial& operator=(const ForwardMaterial&) = delete;
 
 	private:
+		bool instancing_;
+
 		material::MaterialPtr material_;
 
 		hal::GraphicsProgramPtr program_;
@@ -56,6 +75,7 @@ namespace octoon::video
 		hal::GraphicsUniformSetPtr envMap_;
 		hal::GraphicsUniformSetPtr envMapIntensity_;
 
+		hal::GraphicsUniformSetPtr camera_;
 		hal::GraphicsUniformSetPtr viewMatrix_;
 		hal::GraphicsUniformSetPtr viewProjMatrix_;
 		hal::GraphicsUniformSetPtr normalMatrix_;
@@ -65,6 +85,10 @@ namespace octoon::video
 
 		std::vector<hal::GraphicsUniformSetPtr> directionalShadowMaps_;
 		std::vector<hal::GraphicsUniformSetPtr> directionalShadowMatrixs_;
+
+		std::uint64_t pass_;
+		std::uint64_t revision_;
+		const geometry::Geometry* geometry_;
 	};
 }
 
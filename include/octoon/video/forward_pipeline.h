@@ -6,10 +6,13 @@
 #include <octoon/geometry/geometry.h>
 #include <octoon/video/forward_buffer.h>
 #include <octoon/video/forward_material.h>
+#include <octoon/video/forward_skinning.h>
 
 #include "output.h"
 #include "pipeline.h"
 #include "forward_scene.h"
+#include "forward_culling.h"
+#include "forward_render_queue.h"
 
 namespace octoon::video
 {
@@ -29,10 +32,20 @@ namespace octoon::video
 		void render(CompiledScene& scene) noexcept;
 
 		const hal::GraphicsFramebufferPtr& getFramebuffer() const noexcept;
+		const CullingStatistics& getCullingStatistics() const noexcept;
+		const RenderQueueStatistics& getRenderQueueStatistics() const noexcept;
+		float getSkinningValidationError() const noexcept;
 
 	private:
-		bool setBuffer(ForwardScene& scene, const std::shared_ptr<mesh::Mesh>& geometry, std::size_t subset);
-		bool setProgram(ForwardScene& scene, const std::shared_ptr<material::Material>& material, const camera::Camera& camera, const geometry::Geometry& geometry);
+		void pushObject(ForwardScene& scene, const geometry::Geometry& geometry, const camera::Camera& camera, const std::shared_ptr<material::Material>& overrideMaterial) noexcept;
+		void renderQueue(ForwardScene& scene, const camera::Camera& camera) noexcept;
+		void renderFallback(ForwardScene& scene, const camera::Camera& camera) noexcept;
+		void prepareBatches() noexcept;
+		bool writeBuffer(hal::GraphicsDataPtr& buffer, hal::GraphicsDataType type, const void* data, std::size_t size) noexcept;
+
+		void setBuffer(ForwardScene& scene, const geometry::Geometry& geometry, std::size_t subset) noexcept;
+		void setVertexBuffer(std::uint32_t i, const hal::GraphicsDataPtr& data, std::intptr_t offset) noexcept;
+		void setProgram(ForwardScene& scene, ForwardMaterial& material, const camera::Camera& camera, const geometry::Geometry& geometry) noexcept;
 
 	private:
 		ForwardPipeline(const ForwardPipeline&) = delete;
@@ -45,12 +58,50 @@ namespace octoon::video
 		hal::GraphicsTexturePtr colorTexture_;
 		hal::GraphicsTexturePtr depthTexture_;
 
+		std::unique_ptr<ForwardSkinning> skinning_;
+
+		ForwardCulling culling_;
+		std::vector<geometry::Geometry*> shadowCasters_;
+
+		struct VertexBinding
+		{
+			hal::GraphicsDataPtr data;
+			std::intptr_t offset;
+		};
+
+		// Draws of the current pass and what they left bound, so repeated binds are skipped.
+		std::uint64_t pass_;
+		ForwardRenderQueue queue_;
+		RenderQueueStatistics statistics_;
+
+		hal::GraphicsPipelinePtr boundPipeline_;
+		hal::GraphicsDescriptorSetPtr boundDescriptorSet_;
+		hal::GraphicsDataPtr boundIndexBuffer_;
+		VertexBinding boundVertexBuffers_[3];
+
+		// Every draw reads its transforms from slot 2, runs of queue items that share a mesh and a material are drawn once.
+		struct Batch
+		{
+			std::size_t first;
+			std::size_t count;
+			std::size_t offset;
+			ForwardMaterial* material;
+		};
+
+		static constexpr std::size_t PassBufferCount = 4;
+
+		std::vector<Batch> batches_;
+		math::float4x4s instances_;
+		hal::GraphicsDataPtr instanceBuffers_[PassBufferCount];
+		hal::GraphicsDataPtr cameraBuffers_[PassBufferCount];
+
 		std::shared_ptr<ForwardBuffer> currentBuffer_;
 		std::shared_ptr<material::Material> depthMaterial_;
 		std::shared_ptr<material::Material> overrideMaterial_;
 
 		std::unordered_map<std::intptr_t, std::shared_ptr<ForwardBuffer>> buffers_;
 		std::unordered_map<std::intptr_t, std::shared_ptr<ForwardMaterial>> materials_;
+		std::unordered_map<std::intptr_t, std::shared_ptr<ForwardMaterial>> fallbackMaterials_;
 		std::unordered_map<std::intptr_t, std::shared_ptr<hal::GraphicsTexture>> lightTextures_;
 	};
 }
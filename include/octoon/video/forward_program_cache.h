@@ -0,0 +1,57 @@
+#ifndef OCTOON_VIDEO_FORWARD_PROGRAM_CACHE_H_
+#define OCTOON_VIDEO_FORWARD_PROGRAM_CACHE_H_
+
+#include <octoon/hal/graphics_device.h>
+#include <octoon/hal/graphics_shader.h>
+
+#include <unordered_map>
+
+namespace octoon::video
+{
+	// Counters summed over every program requested since the start.
+	struct ProgramCacheStatistics
+	{
+		std::uint64_t requests;
+		std::uint64_t compiled;
+		std::uint64_t loaded;
+		std::uint64_t saved;
+	};
+
+	// Programs of the forward materials keyed by a hash of their preprocessed sources, which carry every define, so the
+	// materials of one feature set share a single program. With a directory set the linked binaries are written to files
+	// named by that hash and later runs load them instead of compiling. A binary the driver refuses is compiled again and
+	// its file replaced. The directory must exist.
+	class OCTOON_EXPORT ForwardProgramCache final
+	{
+	public:
+		ForwardProgramCache() noexcept;
+		~ForwardProgramCache() noexcept;
+
+		void setDirectory(std::string_view path) noexcept;
+		const std::string& getDirectory() const noexcept;
+
+		hal::GraphicsProgramPtr getProgram(const hal::GraphicsDevicePtr& device, const std::string& vertexShader, const std::string& fragmentShader) noexcept;
+
+		void clear() noexcept;
+
+		const ProgramCacheStatistics& getStatistics() const noexcept;
+
+	private:
+		hal::GraphicsProgramPtr loadProgram(const hal::GraphicsDevicePtr& device, std::uint64_t hash) noexcept;
+		void saveProgram(const hal::GraphicsProgram& program, std::uint64_t hash) noexcept;
+
+		std::string getPath(std::uint64_t hash) const noexcept;
+
+	private:
+		ForwardProgramCache(const ForwardProgramCache&) = delete;
+		ForwardProgramCache& operator=(const ForwardProgramCache&) = delete;
+
+	private:
+		std::string directory_;
+		std::unordered_map<std::uint64_t, hal::GraphicsProgramPtr> programs_;
+
+		ProgramCacheStatistics statistics_;
+	};
+}
+
+#endif
@@ -0,0 +1,75 @@
+#ifndef OCTOON_VIDEO_FORWARD_RENDER_QUEUE_H_
+#define OCTOON_VIDEO_FORWARD_RENDER_QUEUE_H_
+
+#include <octoon/geometry/geometry.h>
+#include <octoon/video/forward_material.h>
+
+#include <unordered_map>
+
+namespace octoon::video
+{
+	// Counters summed over every pass drawn since the start, take the difference of two reads for one frame.
+	struct RenderQueueStatistics
+	{
+		std::uint64_t draws;
+		std::uint64_t pipelineBindsAvoided;
+		std::uint64_t descriptorSetBindsAvoided;
+		std::uint64_t vertexBufferBindsAvoided;
+		std::uint64_t indexBufferBindsAvoided;
+		std::uint64_t instancedDraws;
+		std::uint64_t instances;
+
+		// Draws made one by one with uniform matrices because the camera or instance buffer of their pass could not be written.
+		std::uint64_t fallbackDraws;
+	};
+
+	// Draws of one camera pass ordered by a 64 bit key. From the highest bits down the key holds the rank of the render
+	// order, whether the draw blends, then for opaque draws the pipeline, material and vertex buffer followed by the depth,
+	// so each state is bound once and the draws inside it go front to back. Blended draws put the inverted depth above
+	// the states and go back to front. Pipelines, materials and buffers are numbered in the order they were first pushed
+	// and sorted by a radix sort on the bytes that differ.
+	class OCTOON_EXPORT ForwardRenderQueue final
+	{
+	public:
+		struct Item
+		{
+			std::uint64_t key;
+			geometry::Geometry* geometry;
+			std::size_t subset;
+			ForwardMaterial* material;
+		};
+
+		ForwardRenderQueue() noexcept;
+		~ForwardRenderQueue() noexcept;
+
+		void clear() noexcept;
+		bool empty() const noexcept;
+
+		// Depth is any distance that grows away from the camera. A draw blends if one of the color blends of its material does.
+		void push(geometry::Geometry& geometry, std::size_t subset, ForwardMaterial& material, const hal::GraphicsData* vertexBuffer, float depth) noexcept;
+
+		// Orders the items by key, items of equal keys keep the order they were pushed in.
+		void sort() noexcept;
+
+		const std::vector<Item>& getItems() const noexcept;
+
+	private:
+		std::uint32_t getIndex(std::unordered_map<const void*, std::uint32_t>& indices, const void* state) noexcept;
+
+	private:
+		ForwardRenderQueue(const ForwardRenderQueue&) = delete;
+		ForwardRenderQueue& operator=(const ForwardRenderQueue&) = delete;
+
+	private:
+		std::vector<Item> items_;
+		std::vector<Item> sorted_;
+		std::vector<std::int32_t> orders_;
+		std::vector<std::int32_t> ranks_;
+
+		std::unordered_map<const void*, std::uint32_t> pipelines_;
+		std::unordered_map<const void*, std::uint32_t> materials_;
+		std::unordered_map<const void*, std::uint32_t> buffers_;
+	};
+}
+
+#endif
@@ -21,6 +21,10 @@ namespace octoon::video
 
 		const hal::GraphicsFramebufferPtr& getFramebuffer() const noexcept;
 
+		CullingStatistics getCullingStatistics() const noexcept;
+		const RenderQueueStatistics& getRenderQueueStatistics() const noexcept;
+		float getSkinningValidationError() const noexcept;
+
 		void render(RenderScene* scene) noexcept;
 
 	private:
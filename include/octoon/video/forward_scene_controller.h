@@ -5,6 +5,7 @@
 #include <map>
 
 #include "forward_scene.h"
+#include "forward_culling.h"
 #include "scene_controller.h"
 
 namespace octoon::video
@@ -17,9 +18,11 @@ namespace octoon::video
 		void compileScene(RenderScene* scene) noexcept override;
 		CompiledScene& getCachedScene(const RenderScene* scene) const noexcept(false);
 
+		const CullingStatistics& getCullingStatistics() const noexcept;
+
 	private:
 		void updateCamera(const RenderScene* scene, ForwardScene& out) const;
-		void updateIntersector(const RenderScene* scene, ForwardScene& out) const;
+		void updateIntersector(const RenderScene* scene, ForwardScene& out) noexcept;
 		void updateLights(const RenderScene* scene, ForwardScene& out) noexcept;
 
 	private:
@@ -28,6 +31,7 @@ namespace octoon::video
 
 	private:
 		hal::GraphicsContextPtr context_;
+		ForwardCulling culling_;
 		std::unordered_map<const RenderScene*, std::unique_ptr<ForwardScene>> sceneCache_;
 	};
 }
@@ -0,0 +1,65 @@
+#ifndef OCTOON_VIDEO_FORWARD_SKINNING_H_
+#define OCTOON_VIDEO_FORWARD_SKINNING_H_
+
+#include <octoon/geometry/geometry.h>
+#include <octoon/hal/graphics_context.h>
+#include <octoon/hal/graphics_pipeline.h>
+#include <octoon/hal/graphics_descriptor.h>
+
+#include <unordered_map>
+
+namespace octoon::video
+{
+	// Skins geometries that carry skelecton::SkinningData with a compute shader on OpenGL 4.5 devices.
+	// The weights and sparse morph deltas are uploaded once per stream revision and the bind pose once per position revision,
+	// each frame only the joints and morph weights are written. Buffers are written in place while their size holds.
+	// Devices without compute shaders, and meshes with DQ or SDEF vertices, run the CPU reference into the mesh instead.
+	class OCTOON_EXPORT ForwardSkinning final
+	{
+	public:
+		static constexpr float ValidationTolerance = 1e-4f;
+
+		ForwardSkinning(const hal::GraphicsContextPtr& context) noexcept;
+		~ForwardSkinning() noexcept;
+
+		bool isComputeSupported() const noexcept;
+
+		void update(const geometry::Geometry& geometry) noexcept(false);
+
+		// Skinned positions and normals in the slot 0 layout of ForwardBuffer, null when the geometry went through the CPU path.
+		const hal::GraphicsDataPtr& getVertexBuffer(const geometry::Geometry& geometry) const noexcept;
+
+		// Releases the buffers of skinning data that no longer exists.
+		void collect() noexcept;
+
+		// Reads the skinned vertices back from the GPU and compares them with the CPU reference, maxError receives the
+		// largest difference of any component. Runs after each stream upload when the device has debug control enabled.
+		bool validate(const geometry::Geometry& geometry, float& maxError, float tolerance = ValidationTolerance) const noexcept;
+
+		// Largest maxError of the validations run after the stream uploads, negative while none has run.
+		float getLastValidationError() const noexcept;
+
+	private:
+		struct SkinnedBuffer;
+
+		void setupPipeline() noexcept;
+
+		void updateStreams(SkinnedBuffer& buffer, const skelecton::SkinningData& data) noexcept(false);
+		void updatePositions(SkinnedBuffer& buffer, const skelecton::SkinningData& data) noexcept(false);
+		void updatePose(SkinnedBuffer& buffer, const skelecton::SkinningData& data) noexcept(false);
+
+	private:
+		ForwardSkinning(const ForwardSkinning&) = delete;
+		ForwardSkinning& operator=(const ForwardSkinning&) = delete;
+
+	private:
+		hal::GraphicsContextPtr context_;
+		hal::GraphicsPipelinePtr pipeline_;
+
+		float validationError_;
+
+		std::unordered_map<std::intptr_t, std::shared_ptr<SkinnedBuffer>> buffers_;
+	};
+}
+
+#endif
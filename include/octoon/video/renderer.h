@@ -13,6 +13,9 @@
 #include <octoon/video/forward_buffer.h>
 #include <octoon/video/forward_material.h>
 #include <octoon/video/forward_scene.h>
+#include <octoon/video/forward_culling.h>
+#include <octoon/video/forward_render_queue.h>
+#include <octoon/video/forward_program_cache.h>
 
 #include <octoon/lightmap/lightmap.h>
 
@@ -66,6 +69,22 @@ namespace octoon::video
 
 		const hal::GraphicsFramebufferPtr& getFramebuffer() const noexcept;
 
+		// Geometries tested and culled by the main and shadow passes since setup.
+		CullingStatistics getCullingStatistics() const noexcept;
+
+		// Draws of the forward passes and the binds they skipped since setup.
+		RenderQueueStatistics getRenderQueueStatistics() const noexcept;
+
+		// Largest difference between the GPU skinned vertices and the CPU reference, checked after the stream uploads on
+		// devices with debug control enabled. Negative while nothing was checked.
+		float getSkinningValidationError() const noexcept;
+
+		// Where the linked programs of the forward materials are kept between runs, empty keeps them in memory only.
+		void setProgramCacheDirectory(std::string_view path) noexcept;
+		const std::string& getProgramCacheDirectory() const noexcept;
+
+		const ProgramCacheStatistics& getProgramCacheStatistics() const noexcept;
+
 		hal::GraphicsInputLayoutPtr createInputLayout(const hal::GraphicsInputLayoutDesc& desc) noexcept;
 		hal::GraphicsDataPtr createGraphicsData(const hal::GraphicsDataDesc& desc) noexcept;
 		hal::GraphicsTexturePtr createTexture(const hal::GraphicsTextureDesc& desc) noexcept;
@@ -74,6 +93,7 @@ namespace octoon::video
 		hal::GraphicsFramebufferLayoutPtr createFramebufferLayout(const hal::GraphicsFramebufferLayoutDesc& desc) noexcept;
 		hal::GraphicsShaderPtr createShader(const hal::GraphicsShaderDesc& desc) noexcept;
 		hal::GraphicsProgramPtr createProgram(const hal::GraphicsProgramDesc& desc) noexcept;
+		hal::GraphicsProgramPtr createProgram(const std::string& vertexShader, const std::string& fragmentShader) noexcept;
 		hal::GraphicsStatePtr createRenderState(const hal::GraphicsStateDesc& desc) noexcept;
 		hal::GraphicsPipelinePtr createRenderPipeline(const hal::GraphicsPipelineDesc& desc) noexcept;
 		hal::GraphicsDescriptorSetPtr createDescriptorSet(const hal::GraphicsDescriptorSetDesc& desc) noexcept;
@@ -114,6 +134,10 @@ namespace octoon::video
 		std::unique_ptr<class RtxManager> rtxManager_;
 		std::unique_ptr<class ForwardRenderer> forwardRenderer_;
 
+		ForwardCulling culling_;
+		ForwardProgramCache programCache_;
+		std::vector<geometry::Geometry*> shadowCasters_;
+
 		std::shared_ptr<ForwardBuffer> currentBuffer_;
 		std::shared_ptr<material::Material> depthMaterial_;
 		std::shared_ptr<material::Material> overrideMaterial_;
@@ -16,8 +16,13 @@ namespace octoon
 		static bool doCanRead(const char* type) noexcept;
 
 		static animation::Animation<float> load(io::istream& stream) noexcept(false);
+		static void load(io::istream& stream, animation::Animation<float>& motion, animation::Animation<float>& morph, animation::Animation<float>& camera, animation::Animation<float>& light) noexcept(false);
 		static void save(io::ostream& stream, const animation::Animation<float>& animation) noexcept(false);
 
+		// Writes every section of a VMD file. Keys that a linear segment between their neighbours reproduces within the
+		// tolerance (in model units, radians and morph weight) are dropped, a negative tolerance keeps every key.
+		static void save(io::ostream& stream, const animation::Animation<float>& motion, const animation::Animation<float>& morph, const animation::Animation<float>& camera, const animation::Animation<float>& light, float tolerance = 0.0f) noexcept(false);
+
 	private:
 		VMDLoader(const VMDLoader&) = delete;
 		VMDLoader& operator=(const VMDLoader&) = delete;
@@ -0,0 +1,204 @@
+#include "animation_bench.h"
+#include "bench_util.h"
+
+#include <octoon/vmd_loader.h>
+#include <octoon/io/fstream.h>
+
+#include <cstring>
+#include <iconv.h>
+#include <iostream>
+#include <map>
+#include <memory>
+
+namespace octoon::bench
+{
+	static bool
+	loadMotion(const std::string& filepath, animation::Animation<float>& motion, animation::Animation<float>& morph, animation::Animation<float>& camera, animation::Animation<float>& light) noexcept
+	{
+		try
+		{
+			io::ifstream stream;
+			if (!stream.open(filepath))
+				return false;
+
+			VMDLoader::load(stream, motion, morph, camera, light);
+			return true;
+		}
+		catch (const std::exception& e)
+		{
+			std::cerr << "vmd: " << e.what() << std::endl;
+			return false;
+		}
+	}
+
+#pragma pack(push)
+#pragma pack(1)
+
+	struct LegacyMotion
+	{
+		char name[15];
+		std::uint32_t frame;
+		float location[3];
+		float rotate[4];
+		std::uint8_t interpolation[64];
+	};
+
+#pragma pack(pop)
+
+	static std::string
+	legacySjis2utf8(const std::string& sjis) noexcept
+	{
+		std::size_t inSize = sjis.size();
+		std::size_t outSize = sjis.size() * 2;
+
+		auto inbuf = std::make_unique<char[]>(inSize);
+		auto outbuf = std::make_unique<char[]>(outSize + 1);
+		char* in = inbuf.get();
+		char* out = outbuf.get();
+
+		std::memcpy(in, sjis.c_str(), inSize);
+		std::memset(out, 0, outSize + 1);
+
+		auto ic = iconv_open("utf-8", "SJIS");
+		if (ic != (iconv_t)-1)
+		{
+			iconv(ic, &in, &inSize, &out, &outSize);
+			iconv_close(ic);
+		}
+
+		return std::string(outbuf.get());
+	}
+
+	static void
+	legacyInsert(animation::AnimationCurve<float>& curve, float time, float value) noexcept
+	{
+		curve.frames.emplace_back(time, value);
+		std::sort(curve.frames.begin(), curve.frames.end(), [](const animation::Keyframe<float>& a, const animation::Keyframe<float>& b) { return a.time < b.time; });
+		curve.time = curve.frames.front().time;
+		curve.timeLength = curve.frames.back().time;
+		curve.value = curve.frames.front().value;
+	}
+
+	// The import path of the loader before the bulk rewrite: every section is read, then each bone key is inserted into seven
+	// curves of a name keyed map, sorting the whole curve after each insert and converting the header name for every new bone.
+	static bool
+	loadLegacy(const std::string& filepath, animation::Animation<float>& motion) noexcept
+	{
+		io::ifstream stream;
+		if (!stream.open(filepath))
+			return false;
+
+		char header[50];
+		if (!stream.read(header, sizeof(header)))
+			return false;
+
+		std::uint32_t numMotion = 0;
+		if (!stream.read((char*)&numMotion, sizeof(numMotion)))
+			return false;
+
+		std::vector<LegacyMotion> motions(numMotion);
+		if (numMotion > 0 && !stream.read((char*)motions.data(), sizeof(LegacyMotion) * numMotion))
+			return false;
+
+		// Morph, camera, light and self shadow records, which the old loader read and dropped.
+		for (std::size_t size : { 23, 61, 28, 9 })
+		{
+			std::uint32_t count = 0;
+			if (!stream.read((char*)&count, sizeof(count)))
+				break;
+
+			std::vector<char> records(size * count);
+			if (count > 0 && !stream.read(records.data(), records.size()))
+				return false;
+		}
+
+		std::string name(header + 30, strnlen(header + 30, 20));
+
+		std::map<std::string, animation::AnimationClip<float>> clips;
+
+		for (auto& it : motions)
+		{
+			std::string bone(it.name, strnlen(it.name, sizeof(it.name)));
+			if (clips.find(bone) == clips.end())
+				clips[bone].setName(legacySjis2utf8(name));
+
+			auto& clip = clips[bone];
+			auto time = (float)it.frame;
+			legacyInsert(clip.curves["Position.X"], time, it.location[0]);
+			legacyInsert(clip.curves["Position.Y"], time, it.location[1]);
+			legacyInsert(clip.curves["Position.Z"], time, it.location[2]);
+			legacyInsert(clip.curves["Rotation.X"], time, it.rotate[0]);
+			legacyInsert(clip.curves["Rotation.Y"], time, it.rotate[1]);
+			legacyInsert(clip.curves["Rotation.Z"], time, it.rotate[2]);
+			legacyInsert(clip.curves["Rotation.W"], time, it.rotate[3]);
+		}
+
+		motion = animation::Animation<float>();
+		motion.setName(legacySjis2utf8(name));
+		for (auto& it : clips)
+			motion.addClip(it.second);
+
+		return true;
+	}
+
+	template<typename _Elem>
+	static std::size_t
+	countKeys(const std::unordered_map<std::string, animation::AnimationCurve<_Elem>>& curves) noexcept
+	{
+		std::size_t count = 0;
+		for (auto& it : curves)
+			count += it.second.frames.size();
+		return count;
+	}
+
+	int
+	vmd(const std::string& filepath, std::size_t iterations) noexcept
+	{
+		animation::Animation<float> motion;
+		animation::Animation<float> morph;
+		animation::Animation<float> camera;
+		animation::Animation<float> light;
+
+		if (!loadMotion(filepath, motion, morph, camera, light))
+		{
+			std::cerr << "vmd: failed to load " << filepath << std::endl;
+			return 1;
+		}
+
+		std::size_t numKeys = 0;
+		for (auto& clip : motion.clips)
+			numKeys += countKeys(clip.curves) + countKeys(clip.rotations);
+
+		std::cout << "vmd: " << motion.clips.size() << " bones, " << numKeys << " bone keys, " << (morph.empty() ? 0 : morph.clips.front().size()) << " morph tracks, " << iterations << " iterations" << std::endl;
+
+		auto bulk = measure(iterations, [&]() { loadMotion(filepath, motion, morph, camera, light); });
+		std::cout << "  bulk import  " << bulk / 1000.0 << " ms" << std::endl;
+
+		animation::Animation<float> legacyMotion;
+		auto legacy = measure(std::max<std::size_t>(iterations / 10, 1), [&]() { loadLegacy(filepath, legacyMotion); });
+		std::cout << "  legacy import  " << legacy / 1000.0 << " ms" << std::endl;
+
+		// Writes the motion back next to the source, once unreduced and then with growing tolerances.
+		for (auto tolerance : { -1.0f, 0.0f, 1e-3f, 1e-2f })
+		{
+			auto path = filepath + ".export.vmd";
+
+			try
+			{
+				io::ofstream stream;
+				if (!stream.open(path))
+					return 1;
+
+				auto elapsed = measure(1, [&]() { VMDLoader::save(stream, motion, morph, camera, light, tolerance); });
+				std::cout << "  export tolerance " << tolerance << "  " << stream.tellp() << " bytes, " << elapsed / 1000.0 << " ms" << std::endl;
+			}
+			catch (const std::exception& e)
+			{
+				std::cerr << "vmd: " << e.what() << std::endl;
+				return 1;
+			}
+		}
+
+		return 0;
+	}
+}
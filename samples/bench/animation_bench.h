@@ -0,0 +1,12 @@
+#ifndef OCTOON_BENCH_ANIMATION_H_
+#define OCTOON_BENCH_ANIMATION_H_
+
+#include <string>
+
+namespace octoon::bench
+{
+	// Imports a VMD motion with the bulk loader and times it against the import path the loader had before.
+	int vmd(const std::string& filepath, std::size_t iterations) noexcept;
+}
+
+#endif
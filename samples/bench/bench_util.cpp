@@ -0,0 +1,42 @@
+#include "bench_util.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace octoon::bench
+{
+	static std::atomic<std::uint64_t> allocations(0);
+	static std::atomic<std::uint64_t> allocatedBytes(0);
+
+	std::uint64_t
+	allocationCount() noexcept
+	{
+		return allocations.load(std::memory_order_relaxed);
+	}
+
+	std::uint64_t
+	allocationBytes() noexcept
+	{
+		return allocatedBytes.load(std::memory_order_relaxed);
+	}
+}
+
+// The array, nothrow and sized forms of the default library forward to these two, so they are counted as well.
+void*
+operator new(std::size_t size)
+{
+	octoon::bench::allocations.fetch_add(1, std::memory_order_relaxed);
+	octoon::bench::allocatedBytes.fetch_add(size, std::memory_order_relaxed);
+
+	if (auto data = std::malloc(size ? size : 1))
+		return data;
+
+	throw std::bad_alloc();
+}
+
+void
+operator delete(void* data) noexcept
+{
+	std::free(data);
+}
@@ -0,0 +1,31 @@
+#ifndef OCTOON_BENCH_UTIL_H_
+#define OCTOON_BENCH_UTIL_H_
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+namespace octoon::bench
+{
+	// Average time of one call in microseconds, after a warm-up call that is not counted.
+	template<typename Function>
+	inline double
+	measure(std::size_t iterations, Function&& function) noexcept
+	{
+		function();
+
+		auto begin = std::chrono::steady_clock::now();
+		for (std::size_t i = 0; i < iterations; i++)
+			function();
+		auto end = std::chrono::steady_clock::now();
+
+		return std::chrono::duration<double, std::micro>(end - begin).count() / iterations;
+	}
+
+	// Calls of the global operator new and the bytes they requested since the start of the process, counted by the
+	// replacement in bench_util.cpp. Subtract two readings to get the allocations of a stage.
+	std::uint64_t allocationCount() noexcept;
+	std::uint64_t allocationBytes() noexcept;
+}
+
+#endif
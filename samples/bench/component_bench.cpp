@@ -0,0 +1,122 @@
+#include "component_bench.h"
+#include "bench_util.h"
+
+#include <octoon/pmx_loader.h>
+#include <octoon/transform_component.h>
+#include <octoon/solver_component.h>
+#include <octoon/rotation_limit_component.h>
+#include <octoon/rotation_link_component.h>
+
+#include <iostream>
+
+namespace octoon::bench
+{
+	// Same components as MeshLoader attaches to the bones, without the meshes and physics the lookups do not depend on.
+	static bool
+	loadBones(const std::string& filepath, GameObjects& bones) noexcept
+	{
+		PMX pmx;
+		PmxLoader loader;
+		if (!loader.doLoad(filepath, pmx) || pmx.numBones == 0)
+			return false;
+
+		bones.reserve(pmx.numBones);
+
+		for (auto& it : pmx.bones)
+		{
+			auto bone = std::make_shared<GameObject>();
+			bone->getComponent<TransformComponent>()->setTranslate(it.position);
+			bones.push_back(std::move(bone));
+		}
+
+		for (std::size_t i = 0; i < pmx.numBones; i++)
+		{
+			auto parent = pmx.bones[i].Parent;
+			if (parent < pmx.numBones && parent != i)
+				bones[i]->setParent(bones[parent]);
+		}
+
+		for (std::size_t i = 0; i < pmx.numBones; i++)
+		{
+			auto& bone = pmx.bones[i];
+			if (bone.IKLinkCount == 0 || bone.IKTargetBoneIndex >= pmx.numBones)
+				continue;
+
+			auto solver = std::make_shared<CCDSolverComponent>();
+			solver->setTarget(bones[bone.IKTargetBoneIndex]);
+
+			for (auto& link : bone.IKList)
+			{
+				if (link.BoneIndex >= pmx.numBones)
+					continue;
+
+				bones[link.BoneIndex]->addComponent<RotationLimitComponent>(-bone.IKLimitedRadian, bone.IKLimitedRadian, link.minimumRadian, link.maximumRadian);
+				solver->addBone(bones[link.BoneIndex]);
+			}
+
+			bones[i]->addComponent(std::move(solver));
+		}
+
+		return true;
+	}
+
+	// The lookup GameObject::getComponent used before the component index.
+	template<typename T>
+	static std::shared_ptr<T>
+	getComponentLegacy(const GameObject& object) noexcept
+	{
+		for (auto& it : object.getComponents())
+		{
+			if (it->isA(T::RTTI))
+				return std::dynamic_pointer_cast<T>(it);
+		}
+
+		return nullptr;
+	}
+
+	int
+	components(const std::string& filepath, std::size_t iterations) noexcept
+	{
+		GameObjects bones;
+		if (!loadBones(filepath, bones))
+		{
+			std::cerr << "components: failed to load " << filepath << std::endl;
+			return 1;
+		}
+
+		std::cout << "components: " << bones.size() << " bones, " << iterations << " iterations" << std::endl;
+
+		// The lookups of one skinning, IK and rotation link pass: a hit on the transform, hits and misses on the IK components.
+		std::size_t found = 0;
+
+		auto legacy = measure(iterations, [&]()
+		{
+			for (auto& bone : bones)
+			{
+				found += getComponentLegacy<TransformComponent>(*bone) != nullptr;
+				found += getComponentLegacy<RotationLimitComponent>(*bone) != nullptr;
+				found += getComponentLegacy<RotationLinkComponent>(*bone) != nullptr;
+				found += getComponentLegacy<CCDSolverComponent>(*bone) != nullptr;
+			}
+		});
+
+		auto indexed = measure(iterations, [&]()
+		{
+			for (auto& bone : bones)
+			{
+				found += bone->getComponent<TransformComponent>() != nullptr;
+				found += bone->getComponent<RotationLimitComponent>() != nullptr;
+				found += bone->getComponent<RotationLinkComponent>() != nullptr;
+				found += bone->getComponent<CCDSolverComponent>() != nullptr;
+			}
+		});
+
+		auto lookups = static_cast<double>(bones.size() * 4);
+
+		std::cout << "  legacy scan   " << legacy << " us, " << legacy * 1000.0 / lookups << " ns per lookup" << std::endl;
+		std::cout << "  indexed       " << indexed << " us, " << indexed * 1000.0 / lookups << " ns per lookup" << std::endl;
+		std::cout << "  (" << found << " components found)" << std::endl;
+
+		return 0;
+	}
+}
@@ -0,0 +1,12 @@
+#ifndef OCTOON_BENCH_COMPONENT_H_
+#define OCTOON_BENCH_COMPONENT_H_
+
+#include <string>
+
+namespace octoon::bench
+{
+	// Builds the bone hierarchy of a PMX model as GameObjects and times typed component lookups against the legacy linear scan.
+	int components(const std::string& filepath, std::size_t iterations) noexcept;
+}
+
+#endif
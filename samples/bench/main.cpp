@@ -0,0 +1,45 @@
+#include <iostream>
+#include <string>
+
+#include "animation_bench.h"
+#include "component_bench.h"
+#include "scene_bench.h"
+#include "skinning_bench.h"
+
+int main(int argc, char* argv[])
+{
+	if (argc < 3)
+	{
+		std::cout << "usage: octoon-bench <benchmark> <file> [iterations]" << std::endl;
+		std::cout << "  skinning <model.pmx>  legacy loop versus the SIMD skinning kernels" << std::endl;
+		std::cout << "  morphing <model.pmx>  legacy morph scatter versus the reference of the GPU skinning path" << std::endl;
+		std::cout << "  components <model.pmx>  typed component lookup on the bone hierarchy versus the legacy scan" << std::endl;
+		std::cout << "  vmd <motion.vmd>      bulk VMD import versus the legacy loader, export with key reduction" << std::endl;
+		std::cout << "  scene <model.pmx> [frames] [motion.vmd]  headless frames of a model on the null device, JSON report" << std::endl;
+		std::cout << "  objects <count> [frames]  headless frames of a grid of cubes on the null device, JSON report" << std::endl;
+		std::cout << "  lightmap <segments> [iterations]  CPU lightmap bake of a torus knot, JSON report" << std::endl;
+		return 1;
+	}
+
+	std::string name = argv[1];
+	std::string filepath = argv[2];
+	std::size_t iterations = argc > 3 ? std::stoul(argv[3]) : 100;
+
+	if (name == "skinning")
+		return octoon::bench::skinning(filepath, iterations);
+	if (name == "morphing")
+		return octoon::bench::morphing(filepath, iterations);
+	if (name == "components")
+		return octoon::bench::components(filepath, iterations);
+	if (name == "vmd")
+		return octoon::bench::vmd(filepath, iterations);
+	if (name == "scene")
+		return octoon::bench::scene(filepath, argc > 4 ? argv[4] : "", iterations);
+	if (name == "objects")
+		return octoon::bench::objects(std::stoul(filepath), iterations);
+	if (name == "lightmap")
+		return octoon::bench::lightmap(std::stoul(filepath), argc > 3 ? iterations : 1);
+
+	std::cerr << "unknown benchmark: " << name << std::endl;
+	return 1;
+}
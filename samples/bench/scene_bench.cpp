@@ -0,0 +1,425 @@
+#include "scene_bench.h"
+#include "bench_util.h"
+
+#include <octoon/game_server.h>
+#include <octoon/game_scene.h>
+#include <octoon/game_listener.h>
+#include <octoon/io_feature.h>
+#include <octoon/timer_feature.h>
+#include <octoon/game_base_features.h>
+#include <octoon/physics_feature.h>
+#include <octoon/hal_feature.h>
+#include <octoon/video_feature.h>
+#include <octoon/mesh_loader.h>
+#include <octoon/vmd_loader.h>
+#include <octoon/animator_component.h>
+#include <octoon/transform_component.h>
+#include <octoon/mesh_filter_component.h>
+#include <octoon/mesh_renderer_component.h>
+#include <octoon/skinned_mesh_renderer_component.h>
+#include <octoon/perspective_camera_component.h>
+#include <octoon/directional_light_component.h>
+#include <octoon/camera/perspective_camera.h>
+#include <octoon/light/directional_light.h>
+#include <octoon/lightmap/lightmap.h>
+#include <octoon/material/mesh_standard_material.h>
+#include <octoon/mesh/cube_mesh.h>
+#include <octoon/mesh/torusknot_mesh.h>
+#include <octoon/hal/graphics_context.h>
+#include <octoon/video/renderer.h>
+#include <octoon/video/forward_skinning.h>
+#include <octoon/io/fstream.h>
+#include <octoon/runtime/profiler.h>
+#include <octoon/runtime/rtti_factory.h>
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <map>
+
+namespace octoon::bench
+{
+	constexpr std::uint32_t FramebufferWidth = 1280;
+	constexpr std::uint32_t FramebufferHeight = 720;
+
+	class BenchListener final : public GameListener
+	{
+	public:
+		void onMessage(std::string_view message) noexcept override
+		{
+			std::cerr << message << std::endl;
+		}
+	};
+
+	// Allocation counters and the clock read together, so a stage can be reported as the difference of two samples.
+	struct Sample
+	{
+		std::chrono::steady_clock::time_point time;
+		std::uint64_t allocations;
+		std::uint64_t bytes;
+
+		static Sample now() noexcept
+		{
+			return Sample{ std::chrono::steady_clock::now(), allocationCount(), allocationBytes() };
+		}
+
+		double milliseconds(const Sample& begin) const noexcept
+		{
+			return std::chrono::duration<double, std::milli>(time - begin.time).count();
+		}
+	};
+
+	// Same features as GameApp::open, without input and GUI, rendering to the null device at a fixed step.
+	static std::unique_ptr<GameServer>
+	createServer() noexcept(false)
+	{
+		runtime::RttiFactory::instance()->open();
+
+		auto server = std::make_unique<GameServer>();
+		server->setGameListener(std::make_shared<BenchListener>());
+
+		auto timer = std::make_unique<TimerFeature>();
+		timer->setFrameDelta(1.0f / 60.0f);
+
+		auto graphics = std::make_unique<GraphicsFeature>(nullptr, FramebufferWidth, FramebufferHeight);
+		graphics->setDeviceType(hal::GraphicsDeviceType::Null);
+
+		server->addFeature(std::make_unique<IOFeature>());
+		server->addFeature(std::move(timer));
+		server->addFeature(std::make_unique<GameBaseFeature>());
+		server->addFeature(std::make_unique<PhysicsFeature>());
+		server->addFeature(std::move(graphics));
+		server->addFeature(std::make_unique<VideoFeature>(FramebufferWidth, FramebufferHeight));
+		server->setActive(true);
+
+		return server;
+	}
+
+	static GameObjectPtr
+	createCamera(const math::float3& translate) noexcept(false)
+	{
+		auto camera = GameObject::create("MainCamera");
+		camera->addComponent<PerspectiveCameraComponent>(60.0f)->setCameraType(CameraType::Main);
+		camera->getComponent<TransformComponent>()->setTranslate(translate);
+
+		auto light = GameObject::create("DirectionalLight");
+		light->addComponent<DirectionalLightComponent>();
+		light->getComponent<TransformComponent>()->setQuaternion(math::Quaternion(math::float3(0.8f, 0.4f, 0.0f)));
+		camera->addChild(std::move(light));
+
+		return camera;
+	}
+
+	static void
+	printString(std::string_view value) noexcept
+	{
+		std::cout << '"';
+		for (auto c : value)
+		{
+			if (c == '"' || c == '\\')
+				std::cout << '\\';
+			std::cout << c;
+		}
+		std::cout << '"';
+	}
+
+	// Steps the server and prints the report. Zones are keyed by their path, e.g. "GameServer::update/onFrame/VideoFeature",
+	// so zones of the same name under different parents stay apart.
+	static int
+	runFrames(std::string_view name, GameServer& server, std::size_t frames, const Sample& loadBegin, const Sample& loadEnd) noexcept(false)
+	{
+		auto profiler = runtime::Profiler::instance();
+		profiler->setEnable(true);
+
+		// The first frame compiles the materials and uploads the meshes, which is load time rather than frame time.
+		server.update();
+
+		auto graphics = server.getFeature<GraphicsFeature>();
+		auto context = graphics ? graphics->getContext() : nullptr;
+
+		hal::GraphicsContextStatistics first{};
+		if (context && context->getStatistics())
+			first = *context->getStatistics();
+
+		auto renderer = video::Renderer::instance();
+		auto firstCulling = renderer->getCullingStatistics();
+		auto firstQueue = renderer->getRenderQueueStatistics();
+
+		std::map<std::string, double> stages;
+		std::vector<runtime::ProfileEvent> events;
+		std::vector<std::string> stack;
+
+		auto begin = Sample::now();
+
+		for (std::size_t i = 0; i < frames; i++)
+		{
+			server.update();
+
+			events = profiler->getFrameEvents();
+			std::stable_sort(events.begin(), events.end(), [](const runtime::ProfileEvent& a, const runtime::ProfileEvent& b)
+			{
+				return a.thread != b.thread ? a.thread < b.thread : a.begin < b.begin;
+			});
+
+			stack.clear();
+
+			for (auto& it : events)
+			{
+				stack.resize(std::min<std::size_t>(it.depth, stack.size()));
+				stack.push_back(stack.empty() ? std::string(it.name) : stack.back() + "/" + it.name);
+				stages[stack.back()] += (it.end - it.begin) / 1e6;
+			}
+		}
+
+		auto end = Sample::now();
+
+		profiler->setEnable(false);
+
+		std::cout << "{" << std::endl;
+		std::cout << "\t\"benchmark\": "; printString(name); std::cout << "," << std::endl;
+		std::cout << "\t\"frames\": " << frames << "," << std::endl;
+		std::cout << "\t\"loadTime\": " << loadEnd.milliseconds(loadBegin) << "," << std::endl;
+		std::cout << "\t\"loadAllocations\": " << loadEnd.allocations - loadBegin.allocations << "," << std::endl;
+		std::cout << "\t\"frameTime\": " << end.milliseconds(begin) / frames << "," << std::endl;
+		std::cout << "\t\"allocationsPerFrame\": " << double(end.allocations - begin.allocations) / frames << "," << std::endl;
+		std::cout << "\t\"bytesPerFrame\": " << double(end.bytes - begin.bytes) / frames << "," << std::endl;
+
+		std::cout << "\t\"stages\": {";
+		for (auto it = stages.begin(); it != stages.end(); ++it)
+		{
+			std::cout << (it == stages.begin() ? "" : ",") << std::endl << "\t\t";
+			printString(it->first);
+			std::cout << ": " << it->second / frames;
+		}
+		std::cout << std::endl << "\t}," << std::endl;
+
+		std::cout << "\t\"device\": {";
+		if (context && context->getStatistics())
+		{
+			auto& last = *context->getStatistics();
+			auto perFrame = [&](std::uint64_t value, std::uint64_t start) { return double(value - start) / frames; };
+
+			std::cout << std::endl;
+			std::cout << "\t\t\"drawCalls\": " << perFrame(last.drawCalls, first.drawCalls) << "," << std::endl;
+			std::cout << "\t\t\"vertices\": " << perFrame(last.vertices, first.vertices) << "," << std::endl;
+			std::cout << "\t\t\"instances\": " << perFrame(last.instances, first.instances) << "," << std::endl;
+			std::cout << "\t\t\"pipelineChanges\": " << perFrame(last.pipelineChanges, first.pipelineChanges) << "," << std::endl;
+			std::cout << "\t\t\"descriptorSetChanges\": " << perFrame(last.descriptorSetChanges, first.descriptorSetChanges) << "," << std::endl;
+			std::cout << "\t\t\"vertexBufferChanges\": " << perFrame(last.vertexBufferChanges, first.vertexBufferChanges) << "," << std::endl;
+			std::cout << "\t\t\"indexBufferChanges\": " << perFrame(last.indexBufferChanges, first.indexBufferChanges) << "," << std::endl;
+			std::cout << "\t\t\"framebufferChanges\": " << perFrame(last.framebufferChanges, first.framebufferChanges) << "," << std::endl;
+			std::cout << "\t\t\"clears\": " << perFrame(last.clears, first.clears) << std::endl;
+			std::cout << "\t";
+		}
+		std::cout << "}," << std::endl;
+
+		auto lastCulling = renderer->getCullingStatistics();
+		std::cout << "\t\"culling\": {" << std::endl;
+		std::cout << "\t\t\"tested\": " << double(lastCulling.tested - firstCulling.tested) / frames << "," << std::endl;
+		std::cout << "\t\t\"culled\": " << double(lastCulling.culled - firstCulling.culled) / frames << "," << std::endl;
+		std::cout << "\t\t\"skippedDraws\": " << double(lastCulling.skippedDraws - firstCulling.skippedDraws) / frames << std::endl;
+		std::cout << "\t}," << std::endl;
+
+		auto lastQueue = renderer->getRenderQueueStatistics();
+		std::cout << "\t\"renderQueue\": {" << std::endl;
+		std::cout << "\t\t\"draws\": " << double(lastQueue.draws - firstQueue.draws) / frames << "," << std::endl;
+		std::cout << "\t\t\"pipelineBindsAvoided\": " << double(lastQueue.pipelineBindsAvoided - firstQueue.pipelineBindsAvoided) / frames << "," << std::endl;
+		std::cout << "\t\t\"descriptorSetBindsAvoided\": " << double(lastQueue.descriptorSetBindsAvoided - firstQueue.descriptorSetBindsAvoided) / frames << "," << std::endl;
+		std::cout << "\t\t\"vertexBufferBindsAvoided\": " << double(lastQueue.vertexBufferBindsAvoided - firstQueue.vertexBufferBindsAvoided) / frames << "," << std::endl;
+		std::cout << "\t\t\"indexBufferBindsAvoided\": " << double(lastQueue.indexBufferBindsAvoided - firstQueue.indexBufferBindsAvoided) / frames << "," << std::endl;
+		std::cout << "\t\t\"instancedDraws\": " << double(lastQueue.instancedDraws - firstQueue.instancedDraws) / frames << "," << std::endl;
+		std::cout << "\t\t\"instances\": " << double(lastQueue.instances - firstQueue.instances) / frames << "," << std::endl;
+		std::cout << "\t\t\"fallbackDraws\": " << double(lastQueue.fallbackDraws - firstQueue.fallbackDraws) / frames << std::endl;
+		std::cout << "\t}," << std::endl;
+
+		// Programs are built while loading, so these are totals rather than per frame.
+		auto& programs = renderer->getProgramCacheStatistics();
+		std::cout << "\t\"programs\": {" << std::endl;
+		std::cout << "\t\t\"requests\": " << programs.requests << "," << std::endl;
+		std::cout << "\t\t\"compiled\": " << programs.compiled << "," << std::endl;
+		std::cout << "\t\t\"loaded\": " << programs.loaded << "," << std::endl;
+		std::cout << "\t\t\"saved\": " << programs.saved << std::endl;
+		std::cout << "\t}," << std::endl;
+
+		// Only devices with debug control check the GPU skinning against the CPU reference, the null device never does.
+		auto skinningError = renderer->getSkinningValidationError();
+		std::cout << "\t\"skinningError\": ";
+		if (skinningError < 0.0f || !std::isfinite(skinningError))
+			std::cout << "null";
+		else
+			std::cout << skinningError;
+		std::cout << std::endl;
+		std::cout << "}" << std::endl;
+
+		if (skinningError > video::ForwardSkinning::ValidationTolerance)
+		{
+			std::cerr << name << ": GPU skinning is off the CPU reference by " << skinningError << std::endl;
+			return 1;
+		}
+
+		return 0;
+	}
+
+	int
+	scene(const std::string& model, const std::string& motion, std::size_t frames) noexcept
+	{
+		try
+		{
+			auto server = createServer();
+
+			auto loadBegin = Sample::now();
+
+			auto camera = createCamera(math::float3(0.0f, 10.0f, -40.0f));
+
+			auto object = MeshLoader::load(model);
+			if (!object)
+			{
+				std::cerr << "scene: failed to load " << model << std::endl;
+				return 1;
+			}
+
+			if (!motion.empty())
+			{
+				io::ifstream stream;
+				if (!stream.open(motion))
+				{
+					std::cerr << "scene: failed to open " << motion << std::endl;
+					return 1;
+				}
+
+				auto skinned = object->getComponent<SkinnedMeshRendererComponent>();
+				if (skinned)
+					object->addComponent<AnimatorComponent>(VMDLoader::load(stream), skinned->getTransforms());
+			}
+
+			auto loadEnd = Sample::now();
+
+			return runFrames("scene", *server, frames, loadBegin, loadEnd);
+		}
+		catch (const std::exception& e)
+		{
+			std::cerr << "scene: " << e.what() << std::endl;
+			return 1;
+		}
+	}
+
+	int
+	objects(std::size_t count, std::size_t frames) noexcept
+	{
+		try
+		{
+			auto server = createServer();
+
+			auto loadBegin = Sample::now();
+
+			auto columns = static_cast<std::size_t>(std::ceil(std::sqrt(static_cast<double>(count))));
+			auto camera = createCamera(math::float3(0.0f, columns * 1.5f, -columns * 2.0f));
+			auto mesh = std::make_shared<mesh::CubeMesh>(1.0f, 1.0f, 1.0f);
+
+			GameObjects cubes;
+			cubes.reserve(count);
+
+			for (std::size_t i = 0; i < count; i++)
+			{
+				auto x = static_cast<float>(i % columns) - columns * 0.5f;
+				auto z = static_cast<float>(i / columns) - columns * 0.5f;
+
+				auto cube = GameObject::create("Cube");
+				cube->addComponent<MeshFilterComponent>(mesh, true);
+				cube->addComponent<MeshRendererComponent>(std::make_shared<material::MeshStandardMaterial>(math::float3(x, 1.0f, z) / float(columns)));
+				cube->getComponent<TransformComponent>()->setTranslate(math::float3(x * 2.0f, 0.0f, z * 2.0f));
+				cubes.push_back(std::move(cube));
+			}
+
+			auto loadEnd = Sample::now();
+
+			return runFrames("objects", *server, frames, loadBegin, loadEnd);
+		}
+		catch (const std::exception& e)
+		{
+			std::cerr << "objects: " << e.what() << std::endl;
+			return 1;
+		}
+	}
+
+	int
+	lightmap(std::uint32_t segments, std::size_t iterations) noexcept
+	{
+		try
+		{
+			auto material = std::make_shared<material::MeshStandardMaterial>(math::float3(0.8f, 0.8f, 0.8f));
+
+			math::float4x4 transform;
+			transform.makeRotation(math::Quaternion(math::float3(0.8f, 0.4f, 0.0f)));
+
+			light::DirectionalLight light;
+			light.setColor(math::float3::One);
+			light.setIntensity(1.0f);
+			light.setTransform(transform);
+
+			camera::PerspectiveCamera camera;
+
+			double unwrap = 0, rasterize = 0, direct = 0, indirect = 0;
+			std::size_t triangles = 0;
+
+			auto begin = Sample::now();
+
+			for (std::size_t i = 0; i < iterations; i++)
+			{
+				auto t0 = Sample::now();
+
+				auto mesh = std::make_shared<mesh::TorusKnotMesh>(10.0f, 3.0f, segments, std::max<std::uint32_t>(segments / 8, 3));
+				mesh->computeLightMap(128, 128);
+				triangles = mesh->getIndicesArray().size() / 3;
+
+				auto t1 = Sample::now();
+
+				geometry::Geometry geometry;
+				geometry.setMesh(mesh);
+				geometry.setMaterial(material);
+
+				bake::Lightmap lightmap;
+				lightmap.setGeometry(geometry);
+
+				auto t2 = Sample::now();
+
+				lightmap.renderLight(light);
+
+				auto t3 = Sample::now();
+
+				lightmap.computeIndirectLightBounce(camera);
+
+				auto t4 = Sample::now();
+
+				unwrap += t1.milliseconds(t0);
+				rasterize += t2.milliseconds(t1);
+				direct += t3.milliseconds(t2);
+				indirect += t4.milliseconds(t3);
+			}
+
+			auto end = Sample::now();
+
+			std::cout << "{" << std::endl;
+			std::cout << "\t\"benchmark\": \"lightmap\"," << std::endl;
+			std::cout << "\t\"iterations\": " << iterations << "," << std::endl;
+			std::cout << "\t\"triangles\": " << triangles << "," << std::endl;
+			std::cout << "\t\"bakeTime\": " << end.milliseconds(begin) / iterations << "," << std::endl;
+			std::cout << "\t\"allocationsPerBake\": " << double(end.allocations - begin.allocations) / iterations << "," << std::endl;
+			std::cout << "\t\"bytesPerBake\": " << double(end.bytes - begin.bytes) / iterations << "," << std::endl;
+			std::cout << "\t\"stages\": {" << std::endl;
+			std::cout << "\t\t\"unwrap\": " << unwrap / iterations << "," << std::endl;
+			std::cout << "\t\t\"rasterize\": " << rasterize / iterations << "," << std::endl;
+			std::cout << "\t\t\"directLight\": " << direct / iterations << "," << std::endl;
+			std::cout << "\t\t\"indirectBounce\": " << indirect / iterations << std::endl;
+			std::cout << "\t}" << std::endl;
+			std::cout << "}" << std::endl;
+
+			return 0;
+		}
+		catch (const std::exception& e)
+		{
+			std::cerr << "lightmap: " << e.what() << std::endl;
+			return 1;
+		}
+	}
+}
@@ -0,0 +1,23 @@
+#ifndef OCTOON_BENCH_SCENE_H_
+#define OCTOON_BENCH_SCENE_H_
+
+#include <string>
+
+namespace octoon::bench
+{
+	// Runs whole frames of a scene on the null graphics device, without a window, at a fixed 60 Hz step. Each one prints
+	// a JSON report to stdout: the frame time, the average of every profiler zone, the allocations per frame and the
+	// commands the device received, so runs on different machines or revisions can be compared by a script.
+
+	// A PMX model with its physics, playing a VMD motion if one is given.
+	int scene(const std::string& model, const std::string& motion, std::size_t frames) noexcept;
+
+	// A grid of lit cubes with their own material each, the cost of many small draws.
+	int objects(std::size_t count, std::size_t frames) noexcept;
+
+	// Bakes a torus knot with the CPU lightmapper: the UV unwrap, the rasterization of the texels, the direct light
+	// and one indirect bounce, timed separately.
+	int lightmap(std::uint32_t segments, std::size_t iterations) noexcept;
+}
+
+#endif
@@ -0,0 +1,267 @@
+#include "skinning_bench.h"
+#include "bench_util.h"
+
+#include <octoon/pmx_loader.h>
+#include <octoon/model/skinning.h>
+#include <octoon/video/forward_skinning.h>
+
+#include <iostream>
+
+namespace octoon::bench
+{
+	struct SkinningScene
+	{
+		math::float3s vertices;
+		math::float3s normals;
+		math::float4x4s joints;
+		skelecton::VertexWeights weights;
+
+		std::vector<math::uint1s> morphIndices;
+		std::vector<math::float3s> morphOffsets;
+	};
+
+	static bool
+	loadScene(const std::string& filepath, SkinningScene& scene) noexcept
+	{
+		PMX pmx;
+		PmxLoader loader;
+		if (!loader.doLoad(filepath, pmx) || pmx.numBones == 0)
+			return false;
+
+		scene.vertices.resize(pmx.numVertices);
+		scene.normals.resize(pmx.numVertices);
+		scene.weights.resize(pmx.numVertices);
+
+		for (std::size_t i = 0; i < pmx.numVertices; i++)
+		{
+			auto& v = pmx.vertices[i];
+
+			scene.vertices[i] = v.position;
+			scene.normals[i] = v.normal;
+
+			auto& weight = scene.weights[i];
+			weight.weight1 = v.weight.weight1;
+			weight.weight2 = v.weight.weight2;
+			weight.weight3 = v.weight.weight3;
+			weight.weight4 = v.weight.weight4;
+			weight.bone1 = v.weight.bone1 < pmx.numBones ? v.weight.bone1 : 0;
+			weight.bone2 = v.weight.bone2 < pmx.numBones ? v.weight.bone2 : 0;
+			weight.bone3 = v.weight.bone3 < pmx.numBones ? v.weight.bone3 : 0;
+			weight.bone4 = v.weight.bone4 < pmx.numBones ? v.weight.bone4 : 0;
+		}
+
+		// A deterministic pose so that every run of the benchmark skins the same data.
+		scene.joints.resize(pmx.numBones);
+
+		for (std::size_t i = 0; i < pmx.numBones; i++)
+		{
+			math::float4x4 bindpose;
+			bindpose.makeTranslate(-pmx.bones[i].position);
+
+			float angle = 0.05f * static_cast<float>(i % 7);
+			math::float3 axis = math::normalize(math::float3(1.0f, static_cast<float>(i % 3), 0.5f));
+
+			math::float4x4 pose;
+			pose.makeRotation(math::Quaternion(axis, angle), pmx.bones[i].position);
+
+			scene.joints[i] = math::transformMultiply(pose, bindpose);
+		}
+
+		for (auto& morph : pmx.morphs)
+		{
+			if (morph.morphType != PmxMorphType::PMX_MorphTypeVertex)
+				continue;
+
+			math::uint1s indices;
+			math::float3s offsets;
+
+			for (auto& it : morph.vertices)
+			{
+				if (it.index < pmx.numVertices)
+				{
+					indices.push_back(it.index);
+					offsets.push_back(it.offset);
+				}
+			}
+
+			scene.morphIndices.push_back(std::move(indices));
+			scene.morphOffsets.push_back(std::move(offsets));
+		}
+
+		return true;
+	}
+
+	static void
+	skinningLegacy(const SkinningScene& scene, math::float3s& vertices, math::float3s& normals) noexcept
+	{
+		auto& joints = scene.joints;
+		auto& weights = scene.weights;
+
+		auto numVertices = static_cast<std::int32_t>(scene.vertices.size());
+
+#		pragma omp parallel for num_threads(4)
+		for (std::int32_t i = 0; i < numVertices; i++)
+		{
+			auto& blend = weights[i];
+
+			math::float3 v = math::float3::Zero;
+			math::float3 n = math::float3::Zero;
+
+			for (std::uint8_t j = 0; j < 4; j++)
+			{
+				auto w = blend.weights[j];
+				if (w == 0.0f)
+					break;
+				v += (joints[blend.bones[j]] * scene.vertices[i]) * w;
+				n += ((math::float3x3)joints[blend.bones[j]] * scene.normals[i]) * w;
+			}
+
+			vertices[i] = v;
+			normals[i] = n;
+		}
+	}
+
+	static float
+	maxError(const math::float3s& a, const math::float3s& b) noexcept
+	{
+		float error = 0.0f;
+		for (std::size_t i = 0; i < a.size(); i++)
+			error = std::max(error, math::length(a[i] - b[i]));
+		return error;
+	}
+
+	int
+	skinning(const std::string& filepath, std::size_t iterations) noexcept
+	{
+		SkinningScene scene;
+		if (!loadScene(filepath, scene))
+		{
+			std::cerr << "skinning: failed to load " << filepath << std::endl;
+			return 1;
+		}
+
+		skelecton::SkinningStreams streams;
+		streams.setVertexArray(scene.vertices);
+		streams.setNormalArray(scene.normals);
+		streams.setWeightArray(scene.weights);
+
+		auto numVertices = scene.vertices.size();
+
+		math::float3s expectVertices(numVertices);
+		math::float3s expectNormals(numVertices);
+		math::float3s vertices(numVertices);
+		math::float3s normals(numVertices);
+
+		std::cout << "skinning: " << numVertices << " vertices, " << scene.joints.size() << " joints, " << iterations << " iterations" << std::endl;
+
+		auto legacy = measure(iterations, [&]() { skinningLegacy(scene, expectVertices, expectNormals); });
+		std::cout << "  legacy (4 threads)  " << legacy << " us" << std::endl;
+
+		for (auto kernel : { skelecton::SkinningKernel::Scalar, skelecton::SkinningKernel::SSE, skelecton::SkinningKernel::AVX2 })
+		{
+			auto time = measure(iterations, [&]() { skelecton::skinning(scene.joints.data(), streams, vertices.data(), normals.data(), 0, numVertices, kernel); });
+			auto error = std::max(maxError(vertices, expectVertices), maxError(normals, expectNormals));
+			std::cout << "  " << skelecton::getSkinningKernelName(kernel) << " (1 thread)  " << time << " us, max error " << error << std::endl;
+		}
+
+		auto time = measure(iterations, [&]() { skelecton::skinning(scene.joints, streams, vertices, normals); });
+		std::cout << "  " << skelecton::getSkinningKernelName(skelecton::SkinningKernel::Auto) << " (all threads)  " << time << " us, speedup " << legacy / time << "x" << std::endl;
+
+		return 0;
+	}
+
+	int
+	morphing(const std::string& filepath, std::size_t iterations) noexcept
+	{
+		SkinningScene scene;
+		if (!loadScene(filepath, scene))
+		{
+			std::cerr << "morphing: failed to load " << filepath << std::endl;
+			return 1;
+		}
+
+		auto numVertices = scene.vertices.size();
+		auto numMorphs = scene.morphIndices.size();
+
+		skelecton::SkinningData data;
+		data.joints = scene.joints;
+		data.streams.setVertexArray(scene.vertices);
+		data.streams.setNormalArray(scene.normals);
+		data.streams.setWeightArray(scene.weights);
+
+		std::vector<std::pair<const math::uint1s*, const math::float3s*>> morphs;
+		for (std::size_t i = 0; i < numMorphs; i++)
+			morphs.emplace_back(&scene.morphIndices[i], &scene.morphOffsets[i]);
+
+		data.morphs.setMorphArray(numVertices, morphs);
+
+		// Drive every other morph so that the zero weights are exercised too.
+		data.morphWeights.resize(numMorphs);
+		for (std::size_t i = 0; i < numMorphs; i++)
+			data.morphWeights[i] = (i % 2) ? 0.0f : 0.25f + 0.5f * static_cast<float>(i % 3) / 3.0f;
+
+		math::float3s expectVertices;
+		math::float3s expectNormals;
+		math::float3s vertices;
+		math::float3s normals;
+
+		std::cout << "morphing: " << numVertices << " vertices, " << numMorphs << " morphs, " << data.morphs.deltas.size() << " deltas, " << iterations << " iterations" << std::endl;
+
+		// The per morph scatter that SkinnedMeshRendererComponent used before the morphs were merged per vertex.
+		auto legacy = measure(iterations, [&]()
+		{
+			auto streams = data.streams;
+
+			for (std::size_t m = 0; m < numMorphs; m++)
+			{
+				auto control = data.morphWeights[m];
+				if (control > 0.0f)
+				{
+					auto& indices = scene.morphIndices[m];
+					auto& offsets = scene.morphOffsets[m];
+
+					for (std::size_t i = 0; i < indices.size(); i++)
+					{
+						streams.positionX[indices[i]] += offsets[i].x * control;
+						streams.positionY[indices[i]] += offsets[i].y * control;
+						streams.positionZ[indices[i]] += offsets[i].z * control;
+					}
+				}
+			}
+
+			skelecton::skinning(data.joints, streams, expectVertices, expectNormals);
+		});
+
+		std::cout << "  legacy scatter  " << legacy << " us" << std::endl;
+
+		auto time = measure(iterations, [&]() { skelecton::skinning(data, vertices, normals); });
+		auto error = std::max(maxError(vertices, expectVertices), maxError(normals, expectNormals));
+		auto valid = error <= video::ForwardSkinning::ValidationTolerance;
+		std::cout << "  reference gather  " << time << " us, max error " << error << (valid ? "" : " (over tolerance)") << std::endl;
+
+		// A frame where a single morph moves, as when one facial track is animated.
+		auto weights = data.morphWeights;
+		if (numMorphs > 0)
+			weights[0] = weights[0] > 0.0f ? 0.0f : 0.5f;
+
+		auto base = data.streams;
+		skelecton::morphing(data.morphs, data.morphWeights, base);
+
+		auto additive = measure(iterations, [&]()
+		{
+			auto streams = data.streams;
+			skelecton::morphing(data.morphs, weights, streams);
+		});
+
+		auto incremental = measure(iterations, [&]()
+		{
+			auto streams = base;
+			skelecton::morphing(data.morphs, weights, data.morphWeights, scene.vertices, streams);
+		});
+
+		std::cout << "  morph additive  " << additive << " us" << std::endl;
+		std::cout << "  morph incremental  " << incremental << " us (one weight changed)" << std::endl;
+
+		return valid ? 0 : 1;
+	}
+}
\ No newline at end of file
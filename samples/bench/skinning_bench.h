@@ -0,0 +1,16 @@
+#ifndef OCTOON_BENCH_SKINNING_H_
+#define OCTOON_BENCH_SKINNING_H_
+
+#include <string>
+
+namespace octoon::bench
+{
+	// Skins the first mesh of a PMX model with the legacy per-influence loop and every available skinning kernel.
+	int skinning(const std::string& filepath, std::size_t iterations) noexcept;
+
+	// Applies the vertex morphs of a PMX model with the legacy per-morph scatter and with the per-vertex reference used by the GPU path,
+	// and fails when the skinned results differ by more than the tolerance.
+	int morphing(const std::string& filepath, std::size_t iterations) noexcept;
+}
+
+#endif
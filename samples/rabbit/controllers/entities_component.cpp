@@ -306,9 +306,7 @@ namespace rabbit
 		std::vector<Keyframes<float>> translateX(it.bone_init_frame.size());
 		std::vector<Keyframes<float>> translateY(it.bone_init_frame.size());
 		std::vector<Keyframes<float>> translateZ(it.bone_init_frame.size());
-		std::vector<Keyframes<float>> rotationX(it.bone_init_frame.size());
-		std::vector<Keyframes<float>> rotationY(it.bone_init_frame.size());
-		std::vector<Keyframes<float>> rotationZ(it.bone_init_frame.size());
+		std::vector<Keyframes<math::Quaternion>> rotation(it.bone_init_frame.size());
 
 		std::vector<uint32_t> key_to_animation_count(it.bone_init_frame.size());
 		std::vector<uint32_t> key_to_array_index(it.bone_key_frame.size() << 1);
@@ -339,9 +337,7 @@ namespace rabbit
 			translateX[i].reserve(count);
 			translateY[i].reserve(count);
 			translateZ[i].reserve(count);
-			rotationX[i].reserve(count * 20);
-			rotationY[i].reserve(count * 20);
-			rotationZ[i].reserve(count * 20);
+			rotation[i].reserve(count);
 		}
 
 		for (std::size_t i = 0; i < it.bone_init_frame.size(); i++)
@@ -353,14 +349,10 @@ namespace rabbit
 			auto interpolationZ = std::make_shared<PathInterpolator<float>>(key.interpolation_z[0] / 127.0f, key.interpolation_z[2] / 127.0f, key.interpolation_z[1] / 127.0f, key.interpolation_z[3] / 127.0f);
 			auto interpolationRotation = std::make_shared<PathInterpolator<float>>(key.interpolation_rotation[0] / 127.0f, key.interpolation_rotation[2] / 127.0f, key.interpolation_rotation[1] / 127.0f, key.interpolation_rotation[3] / 127.0f);
 
-			auto euler = math::eulerAngles(key.quaternion);
-
 			translateX[i].emplace_back((float)key.frame / 30.0f, key.translation.x, interpolationX);
 			translateY[i].emplace_back((float)key.frame / 30.0f, key.translation.y, interpolationY);
 			translateZ[i].emplace_back((float)key.frame / 30.0f, key.translation.z, interpolationZ);
-			rotationX[i].emplace_back((float)key.frame / 30.0f, euler.x, interpolationRotation);
-			rotationY[i].emplace_back((float)key.frame / 30.0f, euler.y, interpolationRotation);
-			rotationZ[i].emplace_back((float)key.frame / 30.0f, euler.z, interpolationRotation);
+			rotation[i].emplace_back((float)key.frame / 30.0f, key.quaternion, interpolationRotation);
 		}
 
 		for (int i = 0; i < it.bone_key_frame.size(); i++)
@@ -375,17 +367,7 @@ namespace rabbit
 
 			auto index = key_to_data_index[i];
 
-			for (std::size_t j = 1; j <= (key.frame - keyLast.frame) * 20; j++)
-			{
-				auto t = j / ((key.frame - keyLast.frame) * 20.0f);
-				auto euler = math::eulerAngles(math::slerp(keyLast.quaternion, key.quaternion, interpolationRotation->interpolator(t)));
-				auto frame = keyLast.frame + (key.frame - keyLast.frame) / ((key.frame - keyLast.frame) * 20.0f) * j;
-
-				rotationX[index].emplace_back((float)frame / 30.0f, euler.x);
-				rotationY[index].emplace_back((float)frame / 30.0f, euler.y);
-				rotationZ[index].emplace_back((float)frame / 30.0f, euler.z);
-			}
-
+			rotation[index].emplace_back((float)key.frame / 30.0f, key.quaternion, interpolationRotation);
 			translateX[index].emplace_back((float)key.frame / 30.0f, key.translation.x, interpolationX);
 			translateY[index].emplace_back((float)key.frame / 30.0f, key.translation.y, interpolationY);
 			translateZ[index].emplace_back((float)key.frame / 30.0f, key.translation.z, interpolationZ);
@@ -400,9 +382,7 @@ namespace rabbit
 			clip.setCurve("LocalPosition.x", AnimationCurve(std::move(translateX[i])));
 			clip.setCurve("LocalPosition.y", AnimationCurve(std::move(translateY[i])));
 			clip.setCurve("LocalPosition.z", AnimationCurve(std::move(translateZ[i])));
-			clip.setCurve("LocalEulerAnglesRaw.x", AnimationCurve(std::move(rotationX[i])));
-			clip.setCurve("LocalEulerAnglesRaw.y", AnimationCurve(std::move(rotationY[i])));
-			clip.setCurve("LocalEulerAnglesRaw.z", AnimationCurve(std::move(rotationZ[i])));
+			clip.setCurve("LocalRotation", AnimationCurve(std::move(rotation[i])));
 		}
 	}
 
@@ -0,0 +1,315 @@
+#include <octoon/animation/pose_buffer.h>
+#include <octoon/runtime/except.h>
+
+#include <cassert>
+#include <cstring>
+
+namespace octoon::animation
+{
+	struct PoseBufferHeader
+	{
+		char magic[4];
+		std::uint32_t version;
+		std::uint32_t numBones;
+		std::uint32_t numFrames;
+		float frameRate;
+	};
+
+	constexpr char PoseBufferMagic[4] = { 'O', 'P', 'S', 'E' };
+	constexpr std::uint32_t PoseBufferVersion = 1;
+
+	// The three smallest components of a unit quaternion lie within this range.
+	constexpr float SmallestThreeRange = 0.70710678f;
+	constexpr float SmallestThreeScale = 32767.0f;
+
+	PoseBuffer::PoseBuffer() noexcept
+		: frameRate_(30.0f)
+		, numBones_(0)
+	{
+	}
+
+	PoseBuffer::PoseBuffer(std::size_t numBones, float frameRate) noexcept
+		: PoseBuffer()
+	{
+		this->reset(numBones, frameRate);
+	}
+
+	PoseBuffer::~PoseBuffer() noexcept
+	{
+	}
+
+	void
+	PoseBuffer::reset(std::size_t numBones, float frameRate) noexcept
+	{
+		assert(frameRate > 0.0f);
+
+		frameRate_ = frameRate;
+		numBones_ = numBones;
+		base_.clear();
+		poses_.clear();
+	}
+
+	void
+	PoseBuffer::clear() noexcept
+	{
+		base_.clear();
+		poses_.clear();
+	}
+
+	bool
+	PoseBuffer::empty() const noexcept
+	{
+		return poses_.empty();
+	}
+
+	std::size_t
+	PoseBuffer::getNumBones() const noexcept
+	{
+		return numBones_;
+	}
+
+	std::size_t
+	PoseBuffer::getNumFrames() const noexcept
+	{
+		return numBones_ > 0 ? poses_.size() / numBones_ : 0;
+	}
+
+	float
+	PoseBuffer::getFrameRate() const noexcept
+	{
+		return frameRate_;
+	}
+
+	float
+	PoseBuffer::getTimeLength() const noexcept
+	{
+		auto numFrames = this->getNumFrames();
+		return numFrames > 1 ? (numFrames - 1) / frameRate_ : 0.0f;
+	}
+
+	void
+	PoseBuffer::addFrame(const math::float3* translates, const math::Quaternion* rotations) noexcept
+	{
+		if (base_.empty())
+			base_.assign(translates, translates + numBones_);
+
+		for (std::size_t i = 0; i < numBones_; i++)
+		{
+			auto offset = translates[i] - base_[i];
+
+			Pose pose;
+			encode(rotations[i], pose.rotation);
+			pose.translate[0] = encode(offset.x);
+			pose.translate[1] = encode(offset.y);
+			pose.translate[2] = encode(offset.z);
+
+			poses_.push_back(pose);
+		}
+	}
+
+	void
+	PoseBuffer::sample(float time, math::float3* translates, math::Quaternion* rotations) const noexcept
+	{
+		auto numFrames = this->getNumFrames();
+		if (numFrames == 0)
+			return;
+
+		auto frame = std::max(time, 0.0f) * frameRate_;
+		auto index = std::min(static_cast<std::size_t>(frame), numFrames - 1);
+		auto next = std::min(index + 1, numFrames - 1);
+		auto t = std::min(frame - index, 1.0f);
+
+		auto a = poses_.data() + index * numBones_;
+		auto b = poses_.data() + next * numBones_;
+
+		for (std::size_t i = 0; i < numBones_; i++)
+		{
+			auto ta = math::float3(decode(a[i].translate[0]), decode(a[i].translate[1]), decode(a[i].translate[2]));
+			auto tb = math::float3(decode(b[i].translate[0]), decode(b[i].translate[1]), decode(b[i].translate[2]));
+			translates[i] = base_[i] + ta + (tb - ta) * t;
+
+			auto qa = decode(a[i].rotation);
+			auto qb = decode(b[i].rotation);
+			if (math::dot(qa, qb) < 0.0f)
+				qb = -qb;
+
+			rotations[i] = math::normalize(math::Quaternion(qa.x + (qb.x - qa.x) * t, qa.y + (qb.y - qa.y) * t, qa.z + (qb.z - qa.z) * t, qa.w + (qb.w - qa.w) * t));
+		}
+	}
+
+	void
+	PoseBuffer::load(io::istream& stream) noexcept(false)
+	{
+		PoseBufferHeader header;
+		if (!stream.read((char*)&header, sizeof(header)))
+			throw runtime::runtime_error::create(R"(Cannot read property "Header" from stream)");
+
+		if (std::memcmp(header.magic, PoseBufferMagic, sizeof(header.magic)) != 0 || header.version != PoseBufferVersion)
+			throw runtime::runtime_error::create("Unsupported pose buffer");
+
+		if (header.frameRate <= 0.0f)
+			throw runtime::runtime_error::create(R"(Invalid property "FrameRate")");
+
+		this->reset(header.numBones, header.frameRate);
+
+		if (header.numFrames > 0 && header.numBones > 0)
+		{
+			base_.resize(header.numBones);
+			poses_.resize(static_cast<std::size_t>(header.numBones) * header.numFrames);
+
+			if (!stream.read((char*)base_.data(), sizeof(math::float3) * base_.size()))
+				throw runtime::runtime_error::create(R"(Cannot read property "Base" from stream)");
+
+			if (!stream.read((char*)poses_.data(), sizeof(Pose) * poses_.size()))
+				throw runtime::runtime_error::create(R"(Cannot read property "Pose" from stream)");
+		}
+	}
+
+	void
+	PoseBuffer::save(io::ostream& stream) const noexcept(false)
+	{
+		PoseBufferHeader header;
+		std::memcpy(header.magic, PoseBufferMagic, sizeof(header.magic));
+		header.version = PoseBufferVersion;
+		header.numBones = static_cast<std::uint32_t>(numBones_);
+		header.numFrames = static_cast<std::uint32_t>(this->getNumFrames());
+		header.frameRate = frameRate_;
+
+		if (!stream.write((char*)&header, sizeof(header)))
+			throw runtime::runtime_error::create(R"(Cannot write property "Header" to stream)");
+
+		if (header.numFrames > 0 && header.numBones > 0)
+		{
+			if (!stream.write((char*)base_.data(), sizeof(math::float3) * base_.size()))
+				throw runtime::runtime_error::create(R"(Cannot write property "Base" to stream)");
+
+			if (!stream.write((char*)poses_.data(), sizeof(Pose) * poses_.size()))
+				throw runtime::runtime_error::create(R"(Cannot write property "Pose" to stream)");
+		}
+	}
+
+	void
+	PoseBuffer::encode(const math::Quaternion& rotation, std::uint16_t packed[3]) noexcept
+	{
+		float q[4] = { rotation.x, rotation.y, rotation.z, rotation.w };
+
+		std::uint16_t largest = 0;
+		for (std::uint16_t i = 1; i < 4; i++)
+		{
+			if (std::abs(q[i]) > std::abs(q[largest]))
+				largest = i;
+		}
+
+		// q and -q are the same rotation, flipping the sign keeps the dropped component positive.
+		auto sign = q[largest] < 0.0f ? -1.0f : 1.0f;
+
+		for (std::uint16_t i = 0, n = 0; i < 4; i++)
+		{
+			if (i == largest)
+				continue;
+
+			auto v = math::clamp(q[i] * sign / SmallestThreeRange, -1.0f, 1.0f) * 0.5f + 0.5f;
+			packed[n++] = static_cast<std::uint16_t>(std::lround(v * SmallestThreeScale));
+		}
+
+		// The index of the dropped component goes into the spare top bits of the first two words.
+		packed[0] |= (largest >> 1) << 15;
+		packed[1] |= (largest & 1) << 15;
+	}
+
+	math::Quaternion
+	PoseBuffer::decode(const std::uint16_t packed[3]) noexcept
+	{
+		auto largest = ((packed[0] >> 15) << 1) | (packed[1] >> 15);
+
+		float v[3];
+		for (std::size_t i = 0; i < 3; i++)
+			v[i] = ((packed[i] & 0x7FFF) / SmallestThreeScale * 2.0f - 1.0f) * SmallestThreeRange;
+
+		float q[4];
+		for (std::size_t i = 0, n = 0; i < 4; i++)
+			q[i] = i == largest ? std::sqrt(std::max(0.0f, 1.0f - v[0] * v[0] - v[1] * v[1] - v[2] * v[2])) : v[n++];
+
+		return math::Quaternion(q[0], q[1], q[2], q[3]);
+	}
+
+	std::uint16_t
+	PoseBuffer::encode(float value) noexcept
+	{
+		std::uint32_t bits;
+		std::memcpy(&bits, &value, sizeof(bits));
+
+		std::uint16_t sign = (bits >> 16) & 0x8000;
+		std::int32_t exponent = ((bits >> 23) & 0xFF) - 127 + 15;
+		std::uint32_t mantissa = bits & 0x7FFFFF;
+
+		if (exponent <= 0)
+		{
+			// Subnormal half, or zero when even the implicit bit shifts out.
+			if (exponent < -10)
+				return sign;
+
+			mantissa |= 0x800000;
+			auto shift = 14 - exponent;
+			auto half = mantissa >> shift;
+			auto remainder = mantissa & ((1u << shift) - 1);
+			auto midpoint = 1u << (shift - 1);
+			if (remainder > midpoint || (remainder == midpoint && (half & 1)))
+				half++;
+
+			return static_cast<std::uint16_t>(sign | half);
+		}
+
+		// Translations never need infinities, clamp to the largest finite half instead.
+		if (exponent >= 31)
+			return static_cast<std::uint16_t>(sign | 0x7BFF);
+
+		std::uint32_t half = (exponent << 10) | (mantissa >> 13);
+		auto remainder = mantissa & 0x1FFF;
+		if (remainder > 0x1000 || (remainder == 0x1000 && (half & 1)))
+			half++;
+
+		return static_cast<std::uint16_t>(sign | std::min<std::uint32_t>(half, 0x7BFF));
+	}
+
+	float
+	PoseBuffer::decode(std::uint16_t value) noexcept
+	{
+		std::uint32_t sign = (value & 0x8000) << 16;
+		std::uint32_t exponent = (value >> 10) & 0x1F;
+		std::uint32_t mantissa = value & 0x3FF;
+
+		std::uint32_t bits;
+		if (exponent == 0)
+		{
+			if (mantissa == 0)
+			{
+				bits = sign;
+			}
+			else
+			{
+				// Renormalize the subnormal half.
+				exponent = 127 - 15 + 1;
+				while ((mantissa & 0x400) == 0)
+				{
+					mantissa <<= 1;
+					exponent--;
+				}
+
+				bits = sign | (exponent << 23) | ((mantissa & 0x3FF) << 13);
+			}
+		}
+		else if (exponent == 31)
+		{
+			bits = sign | 0x7F800000 | (mantissa << 13);
+		}
+		else
+		{
+			bits = sign | ((exponent - 15 + 127) << 23) | (mantissa << 13);
+		}
+
+		float result;
+		std::memcpy(&result, &bits, sizeof(result));
+		return result;
+	}
+}
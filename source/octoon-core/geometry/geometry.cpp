@@ -117,4 +117,16 @@ namespace octoon::geometry
 	{
 		return materials_;
 	}
+
+	void
+	Geometry::setSkinningData(const std::shared_ptr<skelecton::SkinningData>& data) noexcept
+	{
+		this->skinningData_ = data;
+	}
+
+	const std::shared_ptr<skelecton::SkinningData>&
+	Geometry::getSkinningData() const noexcept
+	{
+		return this->skinningData_;
+	}
 }
\ No newline at end of file
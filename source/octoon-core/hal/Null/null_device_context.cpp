@@ -0,0 +1,307 @@
+#include "null_device_context.h"
+#include "null_device.h"
+
+namespace octoon
+{
+	namespace hal
+	{
+		OctoonImplementSubClass(NullDeviceContext, GraphicsContext, "NullDeviceContext")
+
+		NullDeviceContext::NullDeviceContext() noexcept
+			: _stencilCompareMask{ 0xFFFFFFFF, 0xFFFFFFFF }
+			, _stencilReference{ 0, 0 }
+			, _stencilWriteMask{ 0xFFFFFFFF, 0xFFFFFFFF }
+			, _statistics{}
+		{
+		}
+
+		NullDeviceContext::~NullDeviceContext() noexcept
+		{
+			this->close();
+		}
+
+		bool
+		NullDeviceContext::setup(const GraphicsContextDesc& desc) noexcept
+		{
+			auto& deviceProperties = this->getDevice()->getDeviceProperty().getDeviceProperties();
+			_viewports.resize(deviceProperties.maxViewports, float4(0, 0, 0, 0));
+			_scissors.resize(deviceProperties.maxViewports, uint4(0, 0, 0, 0));
+			_vertexBuffers.resize(deviceProperties.maxVertexInputBindings);
+
+			_swapchain = desc.getSwapchain();
+			return true;
+		}
+
+		void
+		NullDeviceContext::close() noexcept
+		{
+			_pipeline.reset();
+			_descriptorSet.reset();
+			_framebuffer.reset();
+			_vertexBuffers.clear();
+			_indexBuffer.reset();
+			_swapchain.reset();
+		}
+
+		void
+		NullDeviceContext::renderBegin() noexcept
+		{
+		}
+
+		void
+		NullDeviceContext::renderEnd() noexcept
+		{
+		}
+
+		void
+		NullDeviceContext::setViewport(std::uint32_t i, const float4& viewport) noexcept
+		{
+			assert(i < _viewports.size());
+			_viewports[i] = viewport;
+		}
+
+		const float4&
+		NullDeviceContext::getViewport(std::uint32_t i) const noexcept
+		{
+			assert(i < _viewports.size());
+			return _viewports[i];
+		}
+
+		void
+		NullDeviceContext::setScissor(std::uint32_t i, const uint4& scissor) noexcept
+		{
+			assert(i < _scissors.size());
+			_scissors[i] = scissor;
+		}
+
+		const uint4&
+		NullDeviceContext::getScissor(std::uint32_t i) const noexcept
+		{
+			assert(i < _scissors.size());
+			return _scissors[i];
+		}
+
+		void
+		NullDeviceContext::setStencilCompareMask(GraphicsStencilFaceFlags face, std::uint32_t mask) noexcept
+		{
+			if (face & GraphicsStencilFaceFlagBits::FrontBit)
+				_stencilCompareMask[0] = mask;
+			if (face & GraphicsStencilFaceFlagBits::BackBit)
+				_stencilCompareMask[1] = mask;
+		}
+
+		std::uint32_t
+		NullDeviceContext::getStencilCompareMask(GraphicsStencilFaceFlags face) noexcept
+		{
+			return (face & GraphicsStencilFaceFlagBits::FrontBit) ? _stencilCompareMask[0] : _stencilCompareMask[1];
+		}
+
+		void
+		NullDeviceContext::setStencilReference(GraphicsStencilFaceFlags face, std::uint32_t reference) noexcept
+		{
+			if (face & GraphicsStencilFaceFlagBits::FrontBit)
+				_stencilReference[0] = reference;
+			if (face & GraphicsStencilFaceFlagBits::BackBit)
+				_stencilReference[1] = reference;
+		}
+
+		std::uint32_t
+		NullDeviceContext::getStencilReference(GraphicsStencilFaceFlags face) noexcept
+		{
+			return (face & GraphicsStencilFaceFlagBits::FrontBit) ? _stencilReference[0] : _stencilReference[1];
+		}
+
+		void
+		NullDeviceContext::setStencilWriteMask(GraphicsStencilFaceFlags face, std::uint32_t mask) noexcept
+		{
+			if (face & GraphicsStencilFaceFlagBits::FrontBit)
+				_stencilWriteMask[0] = mask;
+			if (face & GraphicsStencilFaceFlagBits::BackBit)
+				_stencilWriteMask[1] = mask;
+		}
+
+		std::uint32_t
+		NullDeviceContext::getStencilWriteMask(GraphicsStencilFaceFlags face) noexcept
+		{
+			return (face & GraphicsStencilFaceFlagBits::FrontBit) ? _stencilWriteMask[0] : _stencilWriteMask[1];
+		}
+
+		void
+		NullDeviceContext::setRenderPipeline(const GraphicsPipelinePtr& pipeline) noexcept
+		{
+			if (_pipeline != pipeline)
+			{
+				_pipeline = pipeline;
+				_statistics.pipelineChanges++;
+			}
+		}
+
+		GraphicsPipelinePtr
+		NullDeviceContext::getRenderPipeline() const noexcept
+		{
+			return _pipeline;
+		}
+
+		void
+		NullDeviceContext::setDescriptorSet(const GraphicsDescriptorSetPtr& descriptorSet) noexcept
+		{
+			// Uniforms may have changed even if the set did not, so every call counts like a GL backend rebinding it.
+			_descriptorSet = descriptorSet;
+			_statistics.descriptorSetChanges++;
+		}
+
+		GraphicsDescriptorSetPtr
+		NullDeviceContext::getDescriptorSet() const noexcept
+		{
+			return _descriptorSet;
+		}
+
+		void
+		NullDeviceContext::setVertexBufferData(std::uint32_t i, const GraphicsDataPtr& data, std::intptr_t offset) noexcept
+		{
+			assert(i < _vertexBuffers.size());
+
+			if (_vertexBuffers[i] != data)
+			{
+				_vertexBuffers[i] = data;
+				_statistics.vertexBufferChanges++;
+			}
+		}
+
+		GraphicsDataPtr
+		NullDeviceContext::getVertexBufferData(std::uint32_t i) const noexcept
+		{
+			assert(i < _vertexBuffers.size());
+			return _vertexBuffers[i];
+		}
+
+		void
+		NullDeviceContext::setIndexBufferData(const GraphicsDataPtr& data, std::intptr_t offset, GraphicsIndexType indexType) noexcept
+		{
+			if (_indexBuffer != data)
+			{
+				_indexBuffer = data;
+				_statistics.indexBufferChanges++;
+			}
+		}
+
+		GraphicsDataPtr
+		NullDeviceContext::getIndexBufferData() const noexcept
+		{
+			return _indexBuffer;
+		}
+
+		void
+		NullDeviceContext::generateMipmap(const GraphicsTexturePtr& texture) noexcept
+		{
+			assert(texture);
+		}
+
+		void
+		NullDeviceContext::setFramebuffer(const GraphicsFramebufferPtr& target) noexcept
+		{
+			_framebuffer = target;
+			_statistics.framebufferChanges++;
+		}
+
+		void
+		NullDeviceContext::clearFramebuffer(std::uint32_t i, GraphicsClearFlags flags, const float4& color, float depth, std::int32_t stencil) noexcept
+		{
+			_statistics.clears++;
+		}
+
+		void
+		NullDeviceContext::discardFramebuffer(std::uint32_t i) noexcept
+		{
+		}
+
+		void
+		NullDeviceContext::blitFramebuffer(const GraphicsFramebufferPtr& src, const float4& v1, const GraphicsFramebufferPtr& dest, const float4& v2) noexcept
+		{
+			assert(src);
+		}
+
+		void
+		NullDeviceContext::readFramebuffer(std::uint32_t i, const GraphicsTexturePtr& texture, std::uint32_t miplevel, std::uint32_t x, std::uint32_t y, std::uint32_t width, std::uint32_t height) noexcept
+		{
+			assert(texture);
+		}
+
+		void
+		NullDeviceContext::readFramebufferToCube(std::uint32_t i, std::uint32_t face, const GraphicsTexturePtr& texture, std::uint32_t miplevel, std::uint32_t x, std::uint32_t y, std::uint32_t width, std::uint32_t height) noexcept
+		{
+			assert(texture);
+		}
+
+		GraphicsFramebufferPtr
+		NullDeviceContext::getFramebuffer() const noexcept
+		{
+			return _framebuffer;
+		}
+
+		void
+		NullDeviceContext::draw(std::uint32_t numVertices, std::uint32_t numInstances, std::uint32_t startVertice, std::uint32_t startInstances) noexcept
+		{
+			assert(_pipeline);
+
+			_statistics.drawCalls++;
+			_statistics.vertices += static_cast<std::uint64_t>(numVertices) * numInstances;
+			_statistics.instances += numInstances;
+		}
+
+		void
+		NullDeviceContext::drawIndexed(std::uint32_t numIndices, std::uint32_t numInstances, std::uint32_t startIndice, std::uint32_t startVertice, std::uint32_t startInstances) noexcept
+		{
+			assert(_pipeline);
+			assert(_indexBuffer);
+
+			_statistics.drawCalls++;
+			_statistics.vertices += static_cast<std::uint64_t>(numIndices) * numInstances;
+			_statistics.instances += numInstances;
+		}
+
+		void
+		NullDeviceContext::drawIndirect(const GraphicsDataPtr& data, std::size_t offset, std::uint32_t drawCount, std::uint32_t stride) noexcept
+		{
+			assert(_pipeline);
+			_statistics.drawCalls += drawCount;
+		}
+
+		void
+		NullDeviceContext::drawIndexedIndirect(const GraphicsDataPtr& data, std::size_t offset, std::uint32_t drawCount, std::uint32_t stride) noexcept
+		{
+			assert(_pipeline);
+			assert(_indexBuffer);
+			_statistics.drawCalls += drawCount;
+		}
+
+		void
+		NullDeviceContext::dispatch(std::uint32_t groupCountX, std::uint32_t groupCountY, std::uint32_t groupCountZ) noexcept
+		{
+		}
+
+		void
+		NullDeviceContext::present() noexcept
+		{
+			_statistics.presents++;
+		}
+
+		const GraphicsContextStatistics*
+		NullDeviceContext::getStatistics() const noexcept
+		{
+			return &_statistics;
+		}
+
+		void
+		NullDeviceContext::setDevice(const GraphicsDevicePtr& device) noexcept
+		{
+			_device = device;
+		}
+
+		GraphicsDevicePtr
+		NullDeviceContext::getDevice() noexcept
+		{
+			return _device.lock();
+		}
+	}
+}
@@ -0,0 +1,103 @@
+#ifndef OCTOON_NULL_DEVICE_CONTEXT_H_
+#define OCTOON_NULL_DEVICE_CONTEXT_H_
+
+#include "null_types.h"
+
+namespace octoon
+{
+	namespace hal
+	{
+		// Keeps the bound state so the getters answer like a real context and counts the commands instead of executing them.
+		class NullDeviceContext final : public GraphicsContext
+		{
+			OctoonDeclareSubClass(NullDeviceContext, GraphicsContext)
+		public:
+			NullDeviceContext() noexcept;
+			~NullDeviceContext() noexcept;
+
+			bool setup(const GraphicsContextDesc& desc) noexcept;
+			void close() noexcept;
+
+			void renderBegin() noexcept override;
+			void renderEnd() noexcept override;
+
+			void setViewport(std::uint32_t i, const float4& viewport) noexcept override;
+			const float4& getViewport(std::uint32_t i) const noexcept override;
+
+			void setScissor(std::uint32_t i, const uint4& scissor) noexcept override;
+			const uint4& getScissor(std::uint32_t i) const noexcept override;
+
+			void setStencilCompareMask(GraphicsStencilFaceFlags face, std::uint32_t mask) noexcept override;
+			std::uint32_t getStencilCompareMask(GraphicsStencilFaceFlags face) noexcept override;
+
+			void setStencilReference(GraphicsStencilFaceFlags face, std::uint32_t reference) noexcept override;
+			std::uint32_t getStencilReference(GraphicsStencilFaceFlags face) noexcept override;
+
+			void setStencilWriteMask(GraphicsStencilFaceFlags face, std::uint32_t mask) noexcept override;
+			std::uint32_t getStencilWriteMask(GraphicsStencilFaceFlags face) noexcept override;
+
+			void setRenderPipeline(const GraphicsPipelinePtr& pipeline) noexcept override;
+			GraphicsPipelinePtr getRenderPipeline() const noexcept override;
+
+			void setDescriptorSet(const GraphicsDescriptorSetPtr& descriptorSet) noexcept override;
+			GraphicsDescriptorSetPtr getDescriptorSet() const noexcept override;
+
+			void setVertexBufferData(std::uint32_t i, const GraphicsDataPtr& data, std::intptr_t offset) noexcept override;
+			GraphicsDataPtr getVertexBufferData(std::uint32_t i) const noexcept override;
+
+			void setIndexBufferData(const GraphicsDataPtr& data, std::intptr_t offset = 0, GraphicsIndexType indexType = hal::GraphicsIndexType::UInt32) noexcept override;
+			GraphicsDataPtr getIndexBufferData() const noexcept override;
+
+			void generateMipmap(const GraphicsTexturePtr& texture) noexcept override;
+
+			void setFramebuffer(const GraphicsFramebufferPtr& target) noexcept override;
+			void clearFramebuffer(std::uint32_t i, GraphicsClearFlags flags, const float4& color, float depth, std::int32_t stencil) noexcept override;
+			void discardFramebuffer(std::uint32_t i) noexcept override;
+			void blitFramebuffer(const GraphicsFramebufferPtr& src, const float4& v1, const GraphicsFramebufferPtr& dest, const float4& v2) noexcept override;
+			void readFramebuffer(std::uint32_t i, const GraphicsTexturePtr& texture, std::uint32_t miplevel, std::uint32_t x, std::uint32_t y, std::uint32_t width, std::uint32_t height) noexcept override;
+			void readFramebufferToCube(std::uint32_t i, std::uint32_t face, const GraphicsTexturePtr& texture, std::uint32_t miplevel, std::uint32_t x, std::uint32_t y, std::uint32_t width, std::uint32_t height) noexcept override;
+			GraphicsFramebufferPtr getFramebuffer() const noexcept override;
+
+			void draw(std::uint32_t numVertices, std::uint32_t numInstances, std::uint32_t startVertice, std::uint32_t startInstances) noexcept override;
+			void drawIndexed(std::uint32_t numIndices, std::uint32_t numInstances, std::uint32_t startIndice, std::uint32_t startVertice, std::uint32_t startInstances) noexcept override;
+			void drawIndirect(const GraphicsDataPtr& data, std::size_t offset, std::uint32_t drawCount, std::uint32_t stride) noexcept override;
+			void drawIndexedIndirect(const GraphicsDataPtr& data, std::size_t offset, std::uint32_t drawCount, std::uint32_t stride) noexcept override;
+
+			void dispatch(std::uint32_t groupCountX, std::uint32_t groupCountY, std::uint32_t groupCountZ) noexcept override;
+
+			void present() noexcept override;
+
+			const GraphicsContextStatistics* getStatistics() const noexcept override;
+
+		private:
+			friend class NullDevice;
+			void setDevice(const GraphicsDevicePtr& device) noexcept;
+			GraphicsDevicePtr getDevice() noexcept override;
+
+		private:
+			NullDeviceContext(const NullDeviceContext&) noexcept = delete;
+			NullDeviceContext& operator=(const NullDeviceContext&) noexcept = delete;
+
+		private:
+			std::vector<float4> _viewports;
+			std::vector<uint4> _scissors;
+
+			std::uint32_t _stencilCompareMask[2];
+			std::uint32_t _stencilReference[2];
+			std::uint32_t _stencilWriteMask[2];
+
+			GraphicsPipelinePtr _pipeline;
+			GraphicsDescriptorSetPtr _descriptorSet;
+			GraphicsFramebufferPtr _framebuffer;
+			std::vector<GraphicsDataPtr> _vertexBuffers;
+			GraphicsDataPtr _indexBuffer;
+			GraphicsSwapchainPtr _swapchain;
+
+			GraphicsContextStatistics _statistics;
+
+			GraphicsDeviceWeakPtr _device;
+		};
+	}
+}
+
+#endif
@@ -0,0 +1,586 @@
+#include "null_resources.h"
+
+#include <cstring>
+
+namespace octoon
+{
+	namespace hal
+	{
+		OctoonImplementSubClass(NullSwapchain, GraphicsSwapchain, "NullSwapchain")
+		OctoonImplementSubClass(NullGraphicsData, GraphicsData, "NullGraphicsData")
+		OctoonImplementSubClass(NullTexture, GraphicsTexture, "NullTexture")
+		OctoonImplementSubClass(NullSampler, GraphicsSampler, "NullSampler")
+		OctoonImplementSubClass(NullFramebufferLayout, GraphicsFramebufferLayout, "NullFramebufferLayout")
+		OctoonImplementSubClass(NullFramebuffer, GraphicsFramebuffer, "NullFramebuffer")
+		OctoonImplementSubClass(NullShader, GraphicsShader, "NullShader")
+		OctoonImplementSubClass(NullProgram, GraphicsProgram, "NullProgram")
+		OctoonImplementSubClass(NullGraphicsState, GraphicsState, "NullGraphicsState")
+		OctoonImplementSubClass(NullPipeline, GraphicsPipeline, "NullPipeline")
+		OctoonImplementSubClass(NullInputLayout, GraphicsInputLayout, "NullInputLayout")
+		OctoonImplementSubClass(NullDescriptorPool, GraphicsDescriptorPool, "NullDescriptorPool")
+		OctoonImplementSubClass(NullDescriptorSetLayout, GraphicsDescriptorSetLayout, "NullDescriptorSetLayout")
+		OctoonImplementSubClass(NullDescriptorSet, GraphicsDescriptorSet, "NullDescriptorSet")
+
+		NullSwapchain::NullSwapchain() noexcept
+		{
+		}
+
+		NullSwapchain::~NullSwapchain() noexcept
+		{
+		}
+
+		bool
+		NullSwapchain::setup(const GraphicsSwapchainDesc& desc) noexcept
+		{
+			_swapchainDesc = desc;
+			return true;
+		}
+
+		void
+		NullSwapchain::setSwapInterval(GraphicsSwapInterval interval) noexcept
+		{
+			_swapchainDesc.setSwapInterval(interval);
+		}
+
+		GraphicsSwapInterval
+		NullSwapchain::getSwapInterval() const noexcept
+		{
+			return _swapchainDesc.getSwapInterval();
+		}
+
+		void
+		NullSwapchain::setWindowResolution(std::uint32_t w, std::uint32_t h) noexcept
+		{
+			_swapchainDesc.setWidth(w);
+			_swapchainDesc.setHeight(h);
+		}
+
+		void
+		NullSwapchain::getWindowResolution(std::uint32_t& w, std::uint32_t& h) const noexcept
+		{
+			w = _swapchainDesc.getWidth();
+			h = _swapchainDesc.getHeight();
+		}
+
+		const GraphicsSwapchainDesc&
+		NullSwapchain::getGraphicsSwapchainDesc() const noexcept
+		{
+			return _swapchainDesc;
+		}
+
+		void
+		NullSwapchain::setDevice(const GraphicsDevicePtr& device) noexcept
+		{
+			_device = device;
+		}
+
+		GraphicsDevicePtr
+		NullSwapchain::getDevice() noexcept
+		{
+			return _device.lock();
+		}
+
+		NullGraphicsData::NullGraphicsData() noexcept
+		{
+		}
+
+		NullGraphicsData::~NullGraphicsData() noexcept
+		{
+		}
+
+		bool
+		NullGraphicsData::setup(const GraphicsDataDesc& desc) noexcept
+		{
+			_data.resize(desc.getStreamSize());
+			if (desc.getStream() && !_data.empty())
+				std::memcpy(_data.data(), desc.getStream(), _data.size());
+
+			// The description must not keep pointing at the caller's memory.
+			_dataDesc = desc;
+			_dataDesc.setStream(nullptr);
+			return true;
+		}
+
+		bool
+		NullGraphicsData::map(std::ptrdiff_t offset, std::ptrdiff_t count, void** data) noexcept
+		{
+			assert(data);
+
+			if (offset < 0 || count < 0 || static_cast<std::size_t>(offset + count) > _data.size())
+				return false;
+
+			*data = _data.data() + offset;
+			return true;
+		}
+
+		void
+		NullGraphicsData::unmap() noexcept
+		{
+		}
+
+		std::ptrdiff_t
+		NullGraphicsData::flush(std::ptrdiff_t offset, std::ptrdiff_t count) noexcept
+		{
+			return count;
+		}
+
+		const GraphicsDataDesc&
+		NullGraphicsData::getDataDesc() const noexcept
+		{
+			return _dataDesc;
+		}
+
+		void
+		NullGraphicsData::setDevice(const GraphicsDevicePtr& device) noexcept
+		{
+			_device = device;
+		}
+
+		GraphicsDevicePtr
+		NullGraphicsData::getDevice() noexcept
+		{
+			return _device.lock();
+		}
+
+		NullTexture::NullTexture() noexcept
+		{
+		}
+
+		NullTexture::~NullTexture() noexcept
+		{
+		}
+
+		bool
+		NullTexture::setup(const GraphicsTextureDesc& desc) noexcept
+		{
+			_textureDesc = desc;
+			return true;
+		}
+
+		bool
+		NullTexture::map(std::uint32_t x, std::uint32_t y, std::uint32_t w, std::uint32_t h, std::uint32_t mipLevel, void** data) noexcept
+		{
+			assert(data);
+
+			_data.resize(static_cast<std::size_t>(w) * h * 16);
+			*data = _data.data();
+			return true;
+		}
+
+		void
+		NullTexture::unmap() noexcept
+		{
+		}
+
+		const std::uint64_t
+		NullTexture::handle() const noexcept
+		{
+			return 0;
+		}
+
+		const GraphicsTextureDesc&
+		NullTexture::getTextureDesc() const noexcept
+		{
+			return _textureDesc;
+		}
+
+		void
+		NullTexture::setDevice(const GraphicsDevicePtr& device) noexcept
+		{
+			_device = device;
+		}
+
+		GraphicsDevicePtr
+		NullTexture::getDevice() noexcept
+		{
+			return _device.lock();
+		}
+
+		NullSampler::NullSampler() noexcept
+		{
+		}
+
+		NullSampler::~NullSampler() noexcept
+		{
+		}
+
+		bool
+		NullSampler::setup(const GraphicsSamplerDesc& desc) noexcept
+		{
+			_samplerDesc = desc;
+			return true;
+		}
+
+		const GraphicsSamplerDesc&
+		NullSampler::getSamplerDesc() const noexcept
+		{
+			return _samplerDesc;
+		}
+
+		void
+		NullSampler::setDevice(const GraphicsDevicePtr& device) noexcept
+		{
+			_device = device;
+		}
+
+		GraphicsDevicePtr
+		NullSampler::getDevice() noexcept
+		{
+			return _device.lock();
+		}
+
+		NullFramebufferLayout::NullFramebufferLayout() noexcept
+		{
+		}
+
+		NullFramebufferLayout::~NullFramebufferLayout() noexcept
+		{
+		}
+
+		bool
+		NullFramebufferLayout::setup(const GraphicsFramebufferLayoutDesc& desc) noexcept
+		{
+			_framebufferLayoutDesc = desc;
+			return true;
+		}
+
+		const GraphicsFramebufferLayoutDesc&
+		NullFramebufferLayout::getFramebufferLayoutDesc() const noexcept
+		{
+			return _framebufferLayoutDesc;
+		}
+
+		void
+		NullFramebufferLayout::setDevice(const GraphicsDevicePtr& device) noexcept
+		{
+			_device = device;
+		}
+
+		GraphicsDevicePtr
+		NullFramebufferLayout::getDevice() noexcept
+		{
+			return _device.lock();
+		}
+
+		NullFramebuffer::NullFramebuffer() noexcept
+		{
+		}
+
+		NullFramebuffer::~NullFramebuffer() noexcept
+		{
+		}
+
+		bool
+		NullFramebuffer::setup(const GraphicsFramebufferDesc& desc) noexcept
+		{
+			_framebufferDesc = desc;
+			return true;
+		}
+
+		const std::uint64_t
+		NullFramebuffer::handle() const noexcept
+		{
+			return 0;
+		}
+
+		const GraphicsFramebufferDesc&
+		NullFramebuffer::getFramebufferDesc() const noexcept
+		{
+			return _framebufferDesc;
+		}
+
+		void
+		NullFramebuffer::setDevice(const GraphicsDevicePtr& device) noexcept
+		{
+			_device = device;
+		}
+
+		GraphicsDevicePtr
+		NullFramebuffer::getDevice() noexcept
+		{
+			return _device.lock();
+		}
+
+		NullShader::NullShader() noexcept
+		{
+		}
+
+		NullShader::~NullShader() noexcept
+		{
+		}
+
+		bool
+		NullShader::setup(const GraphicsShaderDesc& desc) noexcept
+		{
+			_shaderDesc = desc;
+			return true;
+		}
+
+		const GraphicsShaderDesc&
+		NullShader::getShaderDesc() const noexcept
+		{
+			return _shaderDesc;
+		}
+
+		void
+		NullShader::setDevice(const GraphicsDevicePtr& device) noexcept
+		{
+			_device = device;
+		}
+
+		GraphicsDevicePtr
+		NullShader::getDevice() noexcept
+		{
+			return _device.lock();
+		}
+
+		NullProgram::NullProgram() noexcept
+		{
+		}
+
+		NullProgram::~NullProgram() noexcept
+		{
+		}
+
+		bool
+		NullProgram::setup(const GraphicsProgramDesc& desc) noexcept
+		{
+			_programDesc = desc;
+			return true;
+		}
+
+		const GraphicsParams&
+		NullProgram::getActiveParams() const noexcept
+		{
+			return _activeParams;
+		}
+
+		const GraphicsAttributes&
+		NullProgram::getActiveAttributes() const noexcept
+		{
+			return _activeAttributes;
+		}
+
+		const GraphicsProgramDesc&
+		NullProgram::getProgramDesc() const noexcept
+		{
+			return _programDesc;
+		}
+
+		void
+		NullProgram::setDevice(const GraphicsDevicePtr& device) noexcept
+		{
+			_device = device;
+		}
+
+		GraphicsDevicePtr
+		NullProgram::getDevice() noexcept
+		{
+			return _device.lock();
+		}
+
+		NullGraphicsState::NullGraphicsState() noexcept
+		{
+		}
+
+		NullGraphicsState::~NullGraphicsState() noexcept
+		{
+		}
+
+		bool
+		NullGraphicsState::setup(const GraphicsStateDesc& desc) noexcept
+		{
+			_stateDesc = desc;
+			return true;
+		}
+
+		const GraphicsStateDesc&
+		NullGraphicsState::getStateDesc() const noexcept
+		{
+			return _stateDesc;
+		}
+
+		void
+		NullGraphicsState::setDevice(const GraphicsDevicePtr& device) noexcept
+		{
+			_device = device;
+		}
+
+		GraphicsDevicePtr
+		NullGraphicsState::getDevice() noexcept
+		{
+			return _device.lock();
+		}
+
+		NullPipeline::NullPipeline() noexcept
+		{
+		}
+
+		NullPipeline::~NullPipeline() noexcept
+		{
+		}
+
+		bool
+		NullPipeline::setup(const GraphicsPipelineDesc& desc) noexcept
+		{
+			_pipelineDesc = desc;
+			return true;
+		}
+
+		const GraphicsPipelineDesc&
+		NullPipeline::getPipelineDesc() const noexcept
+		{
+			return _pipelineDesc;
+		}
+
+		void
+		NullPipeline::setDevice(const GraphicsDevicePtr& device) noexcept
+		{
+			_device = device;
+		}
+
+		GraphicsDevicePtr
+		NullPipeline::getDevice() noexcept
+		{
+			return _device.lock();
+		}
+
+		NullInputLayout::NullInputLayout() noexcept
+		{
+		}
+
+		NullInputLayout::~NullInputLayout() noexcept
+		{
+		}
+
+		bool
+		NullInputLayout::setup(const GraphicsInputLayoutDesc& desc) noexcept
+		{
+			_inputLayoutDesc = desc;
+			return true;
+		}
+
+		const GraphicsInputLayoutDesc&
+		NullInputLayout::getInputLayoutDesc() const noexcept
+		{
+			return _inputLayoutDesc;
+		}
+
+		void
+		NullInputLayout::setDevice(const GraphicsDevicePtr& device) noexcept
+		{
+			_device = device;
+		}
+
+		GraphicsDevicePtr
+		NullInputLayout::getDevice() noexcept
+		{
+			return _device.lock();
+		}
+
+		NullDescriptorPool::NullDescriptorPool() noexcept
+		{
+		}
+
+		NullDescriptorPool::~NullDescriptorPool() noexcept
+		{
+		}
+
+		bool
+		NullDescriptorPool::setup(const GraphicsDescriptorPoolDesc& desc) noexcept
+		{
+			_descriptorPoolDesc = desc;
+			return true;
+		}
+
+		const GraphicsDescriptorPoolDesc&
+		NullDescriptorPool::getDescriptorPoolDesc() const noexcept
+		{
+			return _descriptorPoolDesc;
+		}
+
+		void
+		NullDescriptorPool::setDevice(const GraphicsDevicePtr& device) noexcept
+		{
+			_device = device;
+		}
+
+		GraphicsDevicePtr
+		NullDescriptorPool::getDevice() noexcept
+		{
+			return _device.lock();
+		}
+
+		NullDescriptorSetLayout::NullDescriptorSetLayout() noexcept
+		{
+		}
+
+		NullDescriptorSetLayout::~NullDescriptorSetLayout() noexcept
+		{
+		}
+
+		bool
+		NullDescriptorSetLayout::setup(const GraphicsDescriptorSetLayoutDesc& desc) noexcept
+		{
+			_descriptorSetLayoutDesc = desc;
+			return true;
+		}
+
+		const GraphicsDescriptorSetLayoutDesc&
+		NullDescriptorSetLayout::getDescriptorSetLayoutDesc() const noexcept
+		{
+			return _descriptorSetLayoutDesc;
+		}
+
+		void
+		NullDescriptorSetLayout::setDevice(const GraphicsDevicePtr& device) noexcept
+		{
+			_device = device;
+		}
+
+		GraphicsDevicePtr
+		NullDescriptorSetLayout::getDevice() noexcept
+		{
+			return _device.lock();
+		}
+
+		NullDescriptorSet::NullDescriptorSet() noexcept
+		{
+		}
+
+		NullDescriptorSet::~NullDescriptorSet() noexcept
+		{
+		}
+
+		bool
+		NullDescriptorSet::setup(const GraphicsDescriptorSetDesc& desc) noexcept
+		{
+			_descriptorSetDesc = desc;
+			return true;
+		}
+
+		const GraphicsUniformSets&
+		NullDescriptorSet::getUniformSets() const noexcept
+		{
+			return _uniformSets;
+		}
+
+		const GraphicsDescriptorSetDesc&
+		NullDescriptorSet::getDescriptorSetDesc() const noexcept
+		{
+			return _descriptorSetDesc;
+		}
+
+		void
+		NullDescriptorSet::setDevice(const GraphicsDevicePtr& device) noexcept
+		{
+			_device = device;
+		}
+
+		GraphicsDevicePtr
+		NullDescriptorSet::getDevice() noexcept
+		{
+			return _device.lock();
+		}
+	}
+}
@@ -0,0 +1,335 @@
+#ifndef OCTOON_NULL_RESOURCES_H_
+#define OCTOON_NULL_RESOURCES_H_
+
+#include "null_types.h"
+
+namespace octoon
+{
+	namespace hal
+	{
+		class NullSwapchain final : public GraphicsSwapchain
+		{
+			OctoonDeclareSubClass(NullSwapchain, GraphicsSwapchain)
+		public:
+			NullSwapchain() noexcept;
+			~NullSwapchain() noexcept;
+
+			bool setup(const GraphicsSwapchainDesc& desc) noexcept;
+
+			void setSwapInterval(GraphicsSwapInterval interval) noexcept override;
+			GraphicsSwapInterval getSwapInterval() const noexcept override;
+
+			void setWindowResolution(std::uint32_t w, std::uint32_t h) noexcept override;
+			void getWindowResolution(std::uint32_t& w, std::uint32_t& h) const noexcept override;
+
+			const GraphicsSwapchainDesc& getGraphicsSwapchainDesc() const noexcept override;
+
+		private:
+			friend class NullDevice;
+			void setDevice(const GraphicsDevicePtr& device) noexcept;
+			GraphicsDevicePtr getDevice() noexcept override;
+
+		private:
+			GraphicsSwapchainDesc _swapchainDesc;
+			GraphicsDeviceWeakPtr _device;
+		};
+
+		// Keeps the contents in host memory, so code that uploads or reads back through map() behaves as on a GPU.
+		class NullGraphicsData final : public GraphicsData
+		{
+			OctoonDeclareSubClass(NullGraphicsData, GraphicsData)
+		public:
+			NullGraphicsData() noexcept;
+			~NullGraphicsData() noexcept;
+
+			bool setup(const GraphicsDataDesc& desc) noexcept;
+
+			bool map(std::ptrdiff_t offset, std::ptrdiff_t count, void** data) noexcept override;
+			void unmap() noexcept override;
+
+			std::ptrdiff_t flush(std::ptrdiff_t offset, std::ptrdiff_t count) noexcept override;
+
+			const GraphicsDataDesc& getDataDesc() const noexcept override;
+
+		private:
+			friend class NullDevice;
+			void setDevice(const GraphicsDevicePtr& device) noexcept;
+			GraphicsDevicePtr getDevice() noexcept override;
+
+		private:
+			std::vector<std::uint8_t> _data;
+			GraphicsDataDesc _dataDesc;
+			GraphicsDeviceWeakPtr _device;
+		};
+
+		class NullTexture final : public GraphicsTexture
+		{
+			OctoonDeclareSubClass(NullTexture, GraphicsTexture)
+		public:
+			NullTexture() noexcept;
+			~NullTexture() noexcept;
+
+			bool setup(const GraphicsTextureDesc& desc) noexcept;
+
+			// The mapped region holds four 32-bit channels per pixel, enough for any format.
+			bool map(std::uint32_t x, std::uint32_t y, std::uint32_t w, std::uint32_t h, std::uint32_t mipLevel, void** data) noexcept override;
+			void unmap() noexcept override;
+
+			const std::uint64_t handle() const noexcept override;
+			const GraphicsTextureDesc& getTextureDesc() const noexcept override;
+
+		private:
+			friend class NullDevice;
+			void setDevice(const GraphicsDevicePtr& device) noexcept;
+			GraphicsDevicePtr getDevice() noexcept override;
+
+		private:
+			std::vector<std::uint8_t> _data;
+			GraphicsTextureDesc _textureDesc;
+			GraphicsDeviceWeakPtr _device;
+		};
+
+		class NullSampler final : public GraphicsSampler
+		{
+			OctoonDeclareSubClass(NullSampler, GraphicsSampler)
+		public:
+			NullSampler() noexcept;
+			~NullSampler() noexcept;
+
+			bool setup(const GraphicsSamplerDesc& desc) noexcept;
+
+			const GraphicsSamplerDesc& getSamplerDesc() const noexcept override;
+
+		private:
+			friend class NullDevice;
+			void setDevice(const GraphicsDevicePtr& device) noexcept;
+			GraphicsDevicePtr getDevice() noexcept override;
+
+		private:
+			GraphicsSamplerDesc _samplerDesc;
+			GraphicsDeviceWeakPtr _device;
+		};
+
+		class NullFramebufferLayout final : public GraphicsFramebufferLayout
+		{
+			OctoonDeclareSubClass(NullFramebufferLayout, GraphicsFramebufferLayout)
+		public:
+			NullFramebufferLayout() noexcept;
+			~NullFramebufferLayout() noexcept;
+
+			bool setup(const GraphicsFramebufferLayoutDesc& desc) noexcept;
+
+			const GraphicsFramebufferLayoutDesc& getFramebufferLayoutDesc() const noexcept override;
+
+		private:
+			friend class NullDevice;
+			void setDevice(const GraphicsDevicePtr& device) noexcept;
+			GraphicsDevicePtr getDevice() noexcept override;
+
+		private:
+			GraphicsFramebufferLayoutDesc _framebufferLayoutDesc;
+			GraphicsDeviceWeakPtr _device;
+		};
+
+		class NullFramebuffer final : public GraphicsFramebuffer
+		{
+			OctoonDeclareSubClass(NullFramebuffer, GraphicsFramebuffer)
+		public:
+			NullFramebuffer() noexcept;
+			~NullFramebuffer() noexcept;
+
+			bool setup(const GraphicsFramebufferDesc& desc) noexcept;
+
+			const std::uint64_t handle() const noexcept override;
+			const GraphicsFramebufferDesc& getFramebufferDesc() const noexcept override;
+
+		private:
+			friend class NullDevice;
+			void setDevice(const GraphicsDevicePtr& device) noexcept;
+			GraphicsDevicePtr getDevice() noexcept override;
+
+		private:
+			GraphicsFramebufferDesc _framebufferDesc;
+			GraphicsDeviceWeakPtr _device;
+		};
+
+		class NullShader final : public GraphicsShader
+		{
+			OctoonDeclareSubClass(NullShader, GraphicsShader)
+		public:
+			NullShader() noexcept;
+			~NullShader() noexcept;
+
+			bool setup(const GraphicsShaderDesc& desc) noexcept;
+
+			const GraphicsShaderDesc& getShaderDesc() const noexcept override;
+
+		private:
+			friend class NullDevice;
+			void setDevice(const GraphicsDevicePtr& device) noexcept;
+			GraphicsDevicePtr getDevice() noexcept override;
+
+		private:
+			GraphicsShaderDesc _shaderDesc;
+			GraphicsDeviceWeakPtr _device;
+		};
+
+		// Nothing is compiled, so there are no active parameters to bind and the materials skip their uniforms.
+		class NullProgram final : public GraphicsProgram
+		{
+			OctoonDeclareSubClass(NullProgram, GraphicsProgram)
+		public:
+			NullProgram() noexcept;
+			~NullProgram() noexcept;
+
+			bool setup(const GraphicsProgramDesc& desc) noexcept;
+
+			const GraphicsParams& getActiveParams() const noexcept override;
+			const GraphicsAttributes& getActiveAttributes() const noexcept override;
+
+			const GraphicsProgramDesc& getProgramDesc() const noexcept override;
+
+		private:
+			friend class NullDevice;
+			void setDevice(const GraphicsDevicePtr& device) noexcept;
+			GraphicsDevicePtr getDevice() noexcept override;
+
+		private:
+			GraphicsParams _activeParams;
+			GraphicsAttributes _activeAttributes;
+			GraphicsProgramDesc _programDesc;
+			GraphicsDeviceWeakPtr _device;
+		};
+
+		class NullGraphicsState final : public GraphicsState
+		{
+			OctoonDeclareSubClass(NullGraphicsState, GraphicsState)
+		public:
+			NullGraphicsState() noexcept;
+			~NullGraphicsState() noexcept;
+
+			bool setup(const GraphicsStateDesc& desc) noexcept;
+
+			const GraphicsStateDesc& getStateDesc() const noexcept override;
+
+		private:
+			friend class NullDevice;
+			void setDevice(const GraphicsDevicePtr& device) noexcept;
+			GraphicsDevicePtr getDevice() noexcept override;
+
+		private:
+			GraphicsStateDesc _stateDesc;
+			GraphicsDeviceWeakPtr _device;
+		};
+
+		class NullPipeline final : public GraphicsPipeline
+		{
+			OctoonDeclareSubClass(NullPipeline, GraphicsPipeline)
+		public:
+			NullPipeline() noexcept;
+			~NullPipeline() noexcept;
+
+			bool setup(const GraphicsPipelineDesc& desc) noexcept;
+
+			const GraphicsPipelineDesc& getPipelineDesc() const noexcept override;
+
+		private:
+			friend class NullDevice;
+			void setDevice(const GraphicsDevicePtr& device) noexcept;
+			GraphicsDevicePtr getDevice() noexcept override;
+
+		private:
+			GraphicsPipelineDesc _pipelineDesc;
+			GraphicsDeviceWeakPtr _device;
+		};
+
+		class NullInputLayout final : public GraphicsInputLayout
+		{
+			OctoonDeclareSubClass(NullInputLayout, GraphicsInputLayout)
+		public:
+			NullInputLayout() noexcept;
+			~NullInputLayout() noexcept;
+
+			bool setup(const GraphicsInputLayoutDesc& desc) noexcept;
+
+			const GraphicsInputLayoutDesc& getInputLayoutDesc() const noexcept override;
+
+		private:
+			friend class NullDevice;
+			void setDevice(const GraphicsDevicePtr& device) noexcept;
+			GraphicsDevicePtr getDevice() noexcept override;
+
+		private:
+			GraphicsInputLayoutDesc _inputLayoutDesc;
+			GraphicsDeviceWeakPtr _device;
+		};
+
+		class NullDescriptorPool final : public GraphicsDescriptorPool
+		{
+			OctoonDeclareSubClass(NullDescriptorPool, GraphicsDescriptorPool)
+		public:
+			NullDescriptorPool() noexcept;
+			~NullDescriptorPool() noexcept;
+
+			bool setup(const GraphicsDescriptorPoolDesc& desc) noexcept;
+
+			const GraphicsDescriptorPoolDesc& getDescriptorPoolDesc() const noexcept override;
+
+		private:
+			friend class NullDevice;
+			void setDevice(const GraphicsDevicePtr& device) noexcept;
+			GraphicsDevicePtr getDevice() noexcept override;
+
+		private:
+			GraphicsDescriptorPoolDesc _descriptorPoolDesc;
+			GraphicsDeviceWeakPtr _device;
+		};
+
+		class NullDescriptorSetLayout final : public GraphicsDescriptorSetLayout
+		{
+			OctoonDeclareSubClass(NullDescriptorSetLayout, GraphicsDescriptorSetLayout)
+		public:
+			NullDescriptorSetLayout() noexcept;
+			~NullDescriptorSetLayout() noexcept;
+
+			bool setup(const GraphicsDescriptorSetLayoutDesc& desc) noexcept;
+
+			const GraphicsDescriptorSetLayoutDesc& getDescriptorSetLayoutDesc() const noexcept override;
+
+		private:
+			friend class NullDevice;
+			void setDevice(const GraphicsDevicePtr& device) noexcept;
+			GraphicsDevicePtr getDevice() noexcept override;
+
+		private:
+			GraphicsDescriptorSetLayoutDesc _descriptorSetLayoutDesc;
+			GraphicsDeviceWeakPtr _device;
+		};
+
+		// Layouts built from a NullProgram are empty, so the set holds no uniforms either.
+		class NullDescriptorSet final : public GraphicsDescriptorSet
+		{
+			OctoonDeclareSubClass(NullDescriptorSet, GraphicsDescriptorSet)
+		public:
+			NullDescriptorSet() noexcept;
+			~NullDescriptorSet() noexcept;
+
+			bool setup(const GraphicsDescriptorSetDesc& desc) noexcept;
+
+			const GraphicsUniformSets& getUniformSets() const noexcept override;
+			const GraphicsDescriptorSetDesc& getDescriptorSetDesc() const noexcept override;
+
+		private:
+			friend class NullDevice;
+			void setDevice(const GraphicsDevicePtr& device) noexcept;
+			GraphicsDevicePtr getDevice() noexcept override;
+
+		private:
+			GraphicsUniformSets _uniformSets;
+			GraphicsDescriptorSetDesc _descriptorSetDesc;
+			GraphicsDeviceWeakPtr _device;
+		};
+	}
+}
+
+#endif
@@ -0,0 +1,42 @@
+#ifndef OCTOON_NULL_TYPES_H_
+#define OCTOON_NULL_TYPES_H_
+
+#include <octoon/hal/graphics_device.h>
+#include <octoon/hal/graphics_device_property.h>
+#include <octoon/hal/graphics_context.h>
+#include <octoon/hal/graphics_data.h>
+#include <octoon/hal/graphics_texture.h>
+#include <octoon/hal/graphics_sampler.h>
+#include <octoon/hal/graphics_framebuffer.h>
+#include <octoon/hal/graphics_shader.h>
+#include <octoon/hal/graphics_state.h>
+#include <octoon/hal/graphics_pipeline.h>
+#include <octoon/hal/graphics_input_layout.h>
+#include <octoon/hal/graphics_descriptor.h>
+#include <octoon/hal/graphics_swapchain.h>
+
+namespace octoon
+{
+	namespace hal
+	{
+		typedef std::shared_ptr<class NullDevice> NullDevicePtr;
+		typedef std::shared_ptr<class NullDeviceProperty> NullDevicePropertyPtr;
+		typedef std::shared_ptr<class NullDeviceContext> NullDeviceContextPtr;
+		typedef std::shared_ptr<class NullSwapchain> NullSwapchainPtr;
+		typedef std::shared_ptr<class NullGraphicsData> NullGraphicsDataPtr;
+		typedef std::shared_ptr<class NullTexture> NullTexturePtr;
+		typedef std::shared_ptr<class NullSampler> NullSamplerPtr;
+		typedef std::shared_ptr<class NullFramebufferLayout> NullFramebufferLayoutPtr;
+		typedef std::shared_ptr<class NullFramebuffer> NullFramebufferPtr;
+		typedef std::shared_ptr<class NullShader> NullShaderPtr;
+		typedef std::shared_ptr<class NullProgram> NullProgramPtr;
+		typedef std::shared_ptr<class NullGraphicsState> NullGraphicsStatePtr;
+		typedef std::shared_ptr<class NullPipeline> NullPipelinePtr;
+		typedef std::shared_ptr<class NullInputLayout> NullInputLayoutPtr;
+		typedef std::shared_ptr<class NullDescriptorPool> NullDescriptorPoolPtr;
+		typedef std::shared_ptr<class NullDescriptorSetLayout> NullDescriptorSetLayoutPtr;
+		typedef std::shared_ptr<class NullDescriptorSet> NullDescriptorSetPtr;
+	}
+}
+
+#endif
@@ -673,6 +673,11 @@ namespace octoon
 		{
 		}
 
+		void
+		GL20DeviceContext::dispatch(std::uint32_t groupCountX, std::uint32_t groupCountY, std::uint32_t groupCountZ) noexcept
+		{
+		}
+
 		void
 		GL20DeviceContext::present() noexcept
 		{
@@ -75,14 +75,14 @@ namespace octoon
 			}
 		}
 
-		int
+		std::ptrdiff_t
 		GL20GraphicsData::flush() noexcept
 		{
 			return 0;
 		}
 
-		int
-		GL20GraphicsData::flush(GLintptr offset, GLsizeiptr cnt) noexcept
+		std::ptrdiff_t
+		GL20GraphicsData::flush(std::ptrdiff_t offset, std::ptrdiff_t count) noexcept
 		{
 			return 0;
 		}
@@ -5,6 +5,8 @@
 #include "gl20_descriptor_set.h"
 #include "gl20_graphics_data.h"
 
+#include <map>
+
 namespace octoon
 {
 	namespace hal
@@ -32,11 +34,13 @@ namespace octoon
 			assert(pipelineDesc.getInputLayout()->isInstanceOf<GL20InputLayout>());
 			assert(pipelineDesc.getDescriptorSetLayout()->isInstanceOf<GL20DescriptorSetLayout>());
 
-			std::uint16_t offset = 0;
+			std::map<std::uint8_t, std::uint16_t> offsets;
 
 			auto& layouts = pipelineDesc.getInputLayout()->getInputLayoutDesc().getVertexLayouts();
 			for (auto& it : layouts)
 			{
+				auto& offset = offsets[it.getVertexSlot()];
+
 				GLuint attribIndex = GL_INVALID_INDEX;
 
 				auto& attributes = pipelineDesc.getGraphicsProgram()->getActiveAttributes();
@@ -68,7 +72,7 @@ namespace octoon
 					attrib.normalize = GL20Types::isNormFormat(it.getVertexFormat());
 					attrib.size = pipelineDesc.getInputLayout()->getInputLayoutDesc().getVertexSize((std::uint8_t)it.getVertexSlot());
 
-					if (it.getVertexSlot() <= _attributes.size())
+					if (it.getVertexSlot() >= _attributes.size())
 						_attributes.resize(it.getVertexSlot() + 1);
 
 					_attributes[it.getVertexSlot()].push_back(attrib);
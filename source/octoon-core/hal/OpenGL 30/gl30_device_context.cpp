@@ -736,6 +736,11 @@ namespace octoon
 		{
 		}
 
+		void
+		GL30DeviceContext::dispatch(std::uint32_t groupCountX, std::uint32_t groupCountY, std::uint32_t groupCountZ) noexcept
+		{
+		}
+
 		void
 		GL30DeviceContext::present() noexcept
 		{
@@ -66,11 +66,15 @@ namespace octoon
 		}
 
 		std::ptrdiff_t
-		GL30GraphicsData::flush(GLintptr offset, GLsizeiptr cnt) noexcept
+		GL30GraphicsData::flush(std::ptrdiff_t offset, std::ptrdiff_t count) noexcept
 		{
-			glBindBuffer(_target, _buffer);
-			glFlushMappedBufferRange(_buffer, offset, cnt);
-			return cnt;
+			if (_desc.getUsage() & GraphicsUsageFlagBits::FlushExplicitBit)
+			{
+				glBindBuffer(_target, _buffer);
+				glFlushMappedBufferRange(_target, offset, count);
+			}
+
+			return count;
 		}
 
 		bool
@@ -78,7 +82,11 @@ namespace octoon
 		{
 			assert(data);
 			glBindBuffer(_target, _buffer);
-			*data = glMapBufferRange(_target, offset, count, GL_MAP_READ_BIT | GL_MAP_WRITE_BIT);
+			GLbitfield flags = GL_MAP_READ_BIT | GL_MAP_WRITE_BIT;
+			if (_desc.getUsage() & GraphicsUsageFlagBits::FlushExplicitBit)
+				flags |= GL_MAP_FLUSH_EXPLICIT_BIT;
+
+			*data = glMapBufferRange(_target, offset, count, flags);
 			return *data ? true : false;
 		}
 
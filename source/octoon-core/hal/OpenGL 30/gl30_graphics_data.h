@@ -18,7 +18,7 @@ namespace octoon
 			void close() noexcept;
 
 			std::ptrdiff_t flush() noexcept;
-			std::ptrdiff_t flush(GLintptr offset, GLsizeiptr cnt) noexcept;
+			std::ptrdiff_t flush(std::ptrdiff_t offset, std::ptrdiff_t count) noexcept override;
 
 			bool map(std::ptrdiff_t offset, std::ptrdiff_t count, void** data) noexcept override;
 			void unmap() noexcept override;
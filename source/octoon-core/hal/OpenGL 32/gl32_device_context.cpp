@@ -747,6 +747,11 @@ namespace octoon
 		{
 		}
 
+		void
+		GL32DeviceContext::dispatch(std::uint32_t groupCountX, std::uint32_t groupCountY, std::uint32_t groupCountZ) noexcept
+		{
+		}
+
 		void
 		GL32DeviceContext::present() noexcept
 		{
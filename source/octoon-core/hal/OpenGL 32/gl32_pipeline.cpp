@@ -5,6 +5,8 @@
 #include "gl32_descriptor_set.h"
 #include "gl32_graphics_data.h"
 
+#include <map>
+
 namespace octoon
 {
 	namespace hal
@@ -32,11 +34,13 @@ namespace octoon
 			assert(pipelineDesc.getInputLayout()->isInstanceOf<GL32InputLayout>());
 			assert(pipelineDesc.getDescriptorSetLayout()->isInstanceOf<GL32DescriptorSetLayout>());
 
-			std::uint16_t offset = 0;
+			std::map<std::uint8_t, std::uint16_t> offsets;
 
 			auto& layouts = pipelineDesc.getInputLayout()->getInputLayoutDesc().getVertexLayouts();
 			for (auto& it : layouts)
 			{
+				auto& offset = offsets[it.getVertexSlot()];
+
 				GLuint attribIndex = GL_INVALID_INDEX;
 
 				auto& attributes = pipelineDesc.getGraphicsProgram()->getActiveAttributes();
@@ -805,6 +805,11 @@ namespace octoon
 			}
 		}
 
+		void
+		GL33DeviceContext::dispatch(std::uint32_t groupCountX, std::uint32_t groupCountY, std::uint32_t groupCountZ) noexcept
+		{
+		}
+
 		void
 		GL33DeviceContext::present() noexcept
 		{
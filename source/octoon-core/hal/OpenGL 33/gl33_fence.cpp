@@ -0,0 +1,75 @@
+#include "gl33_fence.h"
+
+namespace octoon
+{
+	namespace hal
+	{
+		GL33FenceRanges::GL33FenceRanges() noexcept
+			: _writeOffset(0)
+			, _writeCount(0)
+		{
+		}
+
+		GL33FenceRanges::~GL33FenceRanges() noexcept
+		{
+			this->clear();
+		}
+
+		void
+		GL33FenceRanges::write(std::ptrdiff_t offset, std::ptrdiff_t count) noexcept
+		{
+			// The caller cycles through ranges of the buffer. The range it wrote last is read by the draws issued since, so a
+			// fence is placed behind them, and only the fences of the range about to be written are waited on.
+			if (_writeCount > 0)
+				_fences.push_back(Fence{ _writeOffset, _writeCount, glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0) });
+
+			for (auto it = _fences.begin(); it != _fences.end();)
+			{
+				GLenum result;
+
+				auto overlap = it->offset < offset + count && offset < it->offset + it->count;
+				if (overlap)
+				{
+					do
+					{
+						result = glClientWaitSync(it->sync, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000);
+					}
+					while (result == GL_TIMEOUT_EXPIRED);
+				}
+				else
+				{
+					result = glClientWaitSync(it->sync, 0, 0);
+					if (result == GL_TIMEOUT_EXPIRED)
+					{
+						++it;
+						continue;
+					}
+				}
+
+				// A fence that can't be waited on says nothing about the draws behind it, so every one of them is finished.
+				if (result == GL_WAIT_FAILED)
+				{
+					glFinish();
+					this->clear();
+					break;
+				}
+
+				glDeleteSync(it->sync);
+				it = _fences.erase(it);
+			}
+
+			_writeOffset = offset;
+			_writeCount = count;
+		}
+
+		void
+		GL33FenceRanges::clear() noexcept
+		{
+			for (auto& it : _fences)
+				glDeleteSync(it.sync);
+
+			_fences.clear();
+			_writeCount = 0;
+		}
+	}
+}
@@ -0,0 +1,42 @@
+#ifndef OCTOON_GL33_FENCE_H_
+#define OCTOON_GL33_FENCE_H_
+
+#include "gl33_types.h"
+
+namespace octoon
+{
+	namespace hal
+	{
+		// Ranges of a buffer written through a persistent or unsynchronized mapping and the fences that follow the draws
+		// reading them.
+		class GL33FenceRanges final
+		{
+		public:
+			GL33FenceRanges() noexcept;
+			~GL33FenceRanges() noexcept;
+
+			// Fences the range written last and waits for the fences of the range about to be written.
+			void write(std::ptrdiff_t offset, std::ptrdiff_t count) noexcept;
+
+			void clear() noexcept;
+
+		private:
+			GL33FenceRanges(const GL33FenceRanges&) noexcept = delete;
+			GL33FenceRanges& operator=(const GL33FenceRanges&) noexcept = delete;
+
+		private:
+			struct Fence
+			{
+				std::ptrdiff_t offset;
+				std::ptrdiff_t count;
+				GLsync sync;
+			};
+
+			std::ptrdiff_t _writeOffset;
+			std::ptrdiff_t _writeCount;
+			std::vector<Fence> _fences;
+		};
+	}
+}
+
+#endif
@@ -83,6 +83,8 @@ namespace octoon
 			if (_data)
 				this->unmap();
 
+			_fences.clear();
+
 			if (_buffer)
 			{
 				glDeleteBuffers(1, &_buffer);
@@ -90,6 +92,24 @@ namespace octoon
 			}
 		}
 
+		std::ptrdiff_t
+		GL33GraphicsData::flush() noexcept
+		{
+			return this->flush(0, _desc.getStreamSize());
+		}
+
+		std::ptrdiff_t
+		GL33GraphicsData::flush(std::ptrdiff_t offset, std::ptrdiff_t count) noexcept
+		{
+			if (_data && _desc.getUsage() & GraphicsUsageFlagBits::FlushExplicitBit)
+			{
+				glBindBuffer(_target, _buffer);
+				glFlushMappedBufferRange(_target, offset, count);
+			}
+
+			return count;
+		}
+
 		bool
 		GL33GraphicsData::map(std::ptrdiff_t offset, std::ptrdiff_t count, void** data) noexcept
 		{
@@ -105,6 +125,18 @@ namespace octoon
 				flags |= GL_MAP_READ_BIT;
 			if (usage & GraphicsUsageFlagBits::WriteBit)
 				flags |= GL_MAP_WRITE_BIT;
+			if (usage & GraphicsUsageFlagBits::FlushExplicitBit)
+				flags |= GL_MAP_FLUSH_EXPLICIT_BIT;
+
+			// An unsynchronized mapping never waits for the device, so the range about to be written is fenced by hand.
+			if (usage & GraphicsUsageFlagBits::UnsynchronizedBit)
+			{
+				_fences.write(offset, count);
+
+				flags |= GL_MAP_UNSYNCHRONIZED_BIT;
+				if (!(usage & GraphicsUsageFlagBits::ReadBit))
+					flags |= GL_MAP_INVALIDATE_RANGE_BIT;
+			}
 
 			_data = *data = glMapBufferRange(_target, offset, count, flags);
 			return _data ? true : false;
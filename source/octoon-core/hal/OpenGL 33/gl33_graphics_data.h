@@ -1,7 +1,7 @@
 #ifndef OCTOON_GL33_GRAPHICS_DATA_H_
 #define OCTOON_GL33_GRAPHICS_DATA_H_
 
-#include "gl33_types.h"
+#include "gl33_fence.h"
 
 namespace octoon
 {
@@ -19,6 +19,9 @@ namespace octoon
 
 			bool is_open() const noexcept;
 
+			std::ptrdiff_t flush() noexcept;
+			std::ptrdiff_t flush(std::ptrdiff_t offset, std::ptrdiff_t count) noexcept override;
+
 			bool map(std::ptrdiff_t begin, std::ptrdiff_t count, void** data) noexcept;
 			void unmap() noexcept;
 
@@ -39,6 +42,10 @@ namespace octoon
 			GLuint _buffer;
 			GLenum _target;
 			GLvoid* _data;
+
+			// Ranges mapped with UnsynchronizedBit.
+			GL33FenceRanges _fences;
+
 			GraphicsDataDesc _desc;
 			GraphicsDeviceWeakPtr _device;
 		};
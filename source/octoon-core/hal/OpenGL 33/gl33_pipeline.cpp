@@ -7,6 +7,8 @@
 #include "gl33_descriptor_set.h"
 #include "gl33_device.h"
 
+#include <map>
+
 namespace octoon
 {
 	namespace hal
@@ -34,11 +36,13 @@ namespace octoon
 			assert(pipelineDesc.getInputLayout()->isInstanceOf<GL33InputLayout>());
 			assert(pipelineDesc.getDescriptorSetLayout()->isInstanceOf<GL33DescriptorSetLayout>());
 
-			std::uint16_t offset = 0;
+			std::map<std::uint8_t, std::uint16_t> offsets;
 
 			auto& layouts = pipelineDesc.getInputLayout()->getInputLayoutDesc().getVertexLayouts();
 			for (auto& it : layouts)
 			{
+				auto& offset = offsets[it.getVertexSlot()];
+
 				GLuint attribIndex = GL_INVALID_INDEX;
 
 				auto& attributes = pipelineDesc.getGraphicsProgram()->getActiveAttributes();
@@ -69,7 +73,7 @@ namespace octoon
 					attrib.offset = offset + it.getVertexOffset();
 					attrib.normalize = GL33Types::isNormFormat(it.getVertexFormat());
 
-					if (it.getVertexSlot() <= _attributes.size())
+					if (it.getVertexSlot() >= _attributes.size())
 						_attributes.resize(it.getVertexSlot() + 1);
 
 					_attributes[it.getVertexSlot()].push_back(attrib);
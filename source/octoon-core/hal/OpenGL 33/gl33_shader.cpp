@@ -497,7 +497,11 @@ namespace octoon
 		{
 			assert(_program == GL_NONE);
 
-			if (programDesc.getShaders().empty())
+			auto& binary = programDesc.getProgramBinary();
+			if (programDesc.getShaders().empty() && binary.empty())
+				return false;
+
+			if (!binary.empty() && !glProgramBinary)
 				return false;
 
 			_program = glCreateProgram();
@@ -507,19 +511,33 @@ namespace octoon
 				return false;
 			}
 
-			for (auto& shader : programDesc.getShaders())
+			if (!binary.empty())
 			{
-				auto glshader = shader->downcast<GL33Shader>();
-				if (glshader)
-					glAttachShader(_program, glshader->getInstanceID());
+				glProgramBinary(_program, programDesc.getProgramBinaryFormat(), binary.data(), (GLsizei)binary.size());
 			}
+			else
+			{
+				for (auto& shader : programDesc.getShaders())
+				{
+					auto glshader = shader->downcast<GL33Shader>();
+					if (glshader)
+						glAttachShader(_program, glshader->getInstanceID());
+				}
+
+				if (glProgramParameteri)
+					glProgramParameteri(_program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
 
-			glLinkProgram(_program);
+				glLinkProgram(_program);
+			}
 
 			GLint status = GL_FALSE;
 			glGetProgramiv(_program, GL_LINK_STATUS, &status);
 			if (!status)
 			{
+				// Binaries go stale whenever the driver changes, the caller compiles the sources again.
+				if (!binary.empty())
+					return false;
+
 				GLint length = 0;
 				glGetProgramiv(_program, GL_INFO_LOG_LENGTH, &length);
 
@@ -533,6 +551,7 @@ namespace octoon
 			_initActiveAttribute();
 			_initActiveUniform();
 			_initActiveUniformBlock();
+			_initActiveStorageBlock();
 
 			_programDesc = programDesc;
 			return true;
@@ -575,6 +594,28 @@ namespace octoon
 			return _activeParams;
 		}
 
+		bool
+		GL33Program::getProgramBinary(std::vector<std::uint8_t>& binary, std::uint32_t& format) const noexcept
+		{
+			if (!glGetProgramBinary || _program == GL_NONE)
+				return false;
+
+			GLint length = 0;
+			glGetProgramiv(_program, GL_PROGRAM_BINARY_LENGTH, &length);
+			if (length <= 0)
+				return false;
+
+			GLenum binaryFormat = GL_NONE;
+			GLsizei written = 0;
+
+			binary.resize((std::size_t)length);
+			glGetProgramBinary(_program, length, &written, &binaryFormat, binary.data());
+			binary.resize((std::size_t)written);
+
+			format = binaryFormat;
+			return written > 0;
+		}
+
 		void
 		GL33Program::_initActiveAttribute() noexcept
 		{
@@ -754,6 +795,48 @@ namespace octoon
 			}
 		}
 
+		void
+		GL33Program::_initActiveStorageBlock() noexcept
+		{
+			if (!GLEW_ARB_shader_storage_buffer_object)
+				return;
+
+			GLint numStorageBlock = 0;
+			GLint maxStorageBlockLength = 0;
+
+			glGetProgramInterfaceiv(_program, GL_SHADER_STORAGE_BLOCK, GL_ACTIVE_RESOURCES, &numStorageBlock);
+			glGetProgramInterfaceiv(_program, GL_SHADER_STORAGE_BLOCK, GL_MAX_NAME_LENGTH, &maxStorageBlockLength);
+
+			if (numStorageBlock == 0)
+				return;
+
+			auto nameStorageBlock = std::make_unique<GLchar[]>(maxStorageBlockLength + 1);
+			nameStorageBlock[maxStorageBlockLength] = 0;
+
+			for (GLint i = 0; i < numStorageBlock; ++i)
+			{
+				GLsizei lengthStorageBlock = 0;
+				glGetProgramResourceName(_program, GL_SHADER_STORAGE_BLOCK, (GLuint)i, maxStorageBlockLength, &lengthStorageBlock, nameStorageBlock.get());
+				if (lengthStorageBlock == 0)
+					continue;
+
+				glShaderStorageBlockBinding(_program, (GLuint)i, (GLuint)i);
+
+				GLenum props[] = { GL_BUFFER_DATA_SIZE };
+				GLint size = 0;
+				glGetProgramResourceiv(_program, GL_SHADER_STORAGE_BLOCK, (GLuint)i, 1, props, 1, nullptr, &size);
+
+				auto storageblock = std::make_shared<GL33GraphicsUniformBlock>();
+				storageblock->setName(nameStorageBlock.get());
+				storageblock->setBindingPoint((GLuint)i);
+				storageblock->setBlockSize(size);
+				storageblock->setType(GraphicsUniformType::StorageBuffer);
+				storageblock->setShaderStageFlags(GraphicsShaderStageFlagBits::All);
+
+				_activeParams.push_back(storageblock);
+			}
+		}
+
 		GraphicsFormat
 		GL33Program::toGraphicsFormat(GLenum type) noexcept
 		{
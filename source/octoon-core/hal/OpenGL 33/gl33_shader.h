@@ -167,10 +167,13 @@ namespace octoon
 
 			const GraphicsProgramDesc& getProgramDesc() const noexcept override;
 
+			bool getProgramBinary(std::vector<std::uint8_t>& binary, std::uint32_t& format) const noexcept override;
+
 		private:
 			void _initActiveAttribute() noexcept;
 			void _initActiveUniform() noexcept;
 			void _initActiveUniformBlock() noexcept;
+			void _initActiveStorageBlock() noexcept;
 
 		private:
 			static GraphicsFormat toGraphicsFormat(GLenum type) noexcept;
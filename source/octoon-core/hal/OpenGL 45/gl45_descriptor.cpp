@@ -171,7 +171,15 @@ namespace octoon
 				case GraphicsUniformType::StorageTexelBuffer:
 					break;
 				case GraphicsUniformType::StorageBuffer:
-					break;
+				{
+					auto& buffer = it->getBuffer();
+					if (buffer)
+					{
+						auto ssbo = buffer->downcast<GL45GraphicsData>();
+						glBindBufferBase(GL_SHADER_STORAGE_BUFFER, location, ssbo->getInstanceID());
+					}
+				}
+				break;
 				case GraphicsUniformType::StorageBufferDynamic:
 					break;
 				case GraphicsUniformType::UniformTexelBuffer:
@@ -322,6 +330,7 @@ namespace octoon
 					case GraphicsUniformType::StorageTexelBuffer:
 						break;
 					case GraphicsUniformType::StorageBuffer:
+						(*it)->uniformBuffer(activeUniformSet->getBuffer());
 						break;
 					case GraphicsUniformType::StorageBufferDynamic:
 						break;
@@ -724,6 +724,25 @@ namespace octoon
 			}
 		}
 
+		void
+		GL45DeviceContext::dispatch(std::uint32_t groupCountX, std::uint32_t groupCountY, std::uint32_t groupCountZ) noexcept
+		{
+			assert(_pipeline);
+			assert(_glcontext->getActive());
+
+			if (_needUpdateDescriptor)
+			{
+				_descriptorSet->apply(*_program);
+				_needUpdateDescriptor = false;
+			}
+
+			if (groupCountX > 0 && groupCountY > 0 && groupCountZ > 0)
+			{
+				glDispatchCompute(groupCountX, groupCountY, groupCountZ);
+				glMemoryBarrier(GL_VERTEX_ATTRIB_ARRAY_BARRIER_BIT | GL_SHADER_STORAGE_BARRIER_BIT | GL_BUFFER_UPDATE_BARRIER_BIT);
+			}
+		}
+
 		void
 		GL45DeviceContext::present() noexcept
 		{
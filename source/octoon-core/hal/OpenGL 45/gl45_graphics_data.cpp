@@ -11,6 +11,7 @@ namespace octoon
 			: _buffer(GL_NONE)
 			, _bufferAddr(GL_NONE)
 			, _data(nullptr)
+			, _mapOffset(0)
 		{
 		}
 
@@ -65,8 +66,6 @@ namespace octoon
 				flags |= GL_MAP_PERSISTENT_BIT;
 			if (usage & GraphicsUsageFlagBits::CoherentBit)
 				flags |= GL_MAP_COHERENT_BIT;
-			if (usage & GraphicsUsageFlagBits::FlushExplicitBit)
-				flags |= GL_MAP_FLUSH_EXPLICIT_BIT;
 			if (usage & GraphicsUsageFlagBits::DynamicStorageBit)
 				flags |= GL_DYNAMIC_STORAGE_BIT;
 			if (usage & GraphicsUsageFlagBits::ClientStorageBit)
@@ -88,7 +87,12 @@ namespace octoon
 		GL45GraphicsData::close() noexcept
 		{
 			if (_data)
+			{
 				glUnmapNamedBuffer(_buffer);
+				_data = nullptr;
+			}
+
+			_fences.clear();
 
 			if (_buffer)
 			{
@@ -104,10 +108,11 @@ namespace octoon
 		}
 
 		std::ptrdiff_t
-		GL45GraphicsData::flush(GLintptr offset, GLsizeiptr cnt) noexcept
+		GL45GraphicsData::flush(std::ptrdiff_t offset, std::ptrdiff_t count) noexcept
 		{
-			glFlushMappedNamedBufferRange(_buffer, offset, cnt);
-			return cnt;
+			if (_data && _desc.getUsage() & GraphicsUsageFlagBits::FlushExplicitBit)
+				glFlushMappedNamedBufferRange(_buffer, _mapOffset + offset, count);
+			return count;
 		}
 
 		bool
@@ -129,15 +134,33 @@ namespace octoon
 			if (usage & GraphicsUsageFlagBits::FlushExplicitBit)
 				flags |= GL_MAP_FLUSH_EXPLICIT_BIT;
 
-			if (!_data && usage & GraphicsUsageFlagBits::PersistentBit)
-				_data = glMapNamedBuffer(_buffer, flags);
+			// A persistent mapping never waits for the device, so the range about to be written is fenced by hand.
+			if (usage & (GraphicsUsageFlagBits::PersistentBit | GraphicsUsageFlagBits::UnsynchronizedBit))
+				_fences.write(offset, count);
+
+			if (usage & GraphicsUsageFlagBits::PersistentBit)
+			{
+				if (!_data)
+					_data = glMapNamedBufferRange(_buffer, 0, _desc.getStreamSize(), flags);
+
+				if (_data)
+				{
+					_mapOffset = offset;
+					*data = (std::uint8_t*)_data + offset;
+					return true;
+				}
 
-			if (_data && usage & GraphicsUsageFlagBits::PersistentBit)
+				return false;
+			}
+
+			if (usage & GraphicsUsageFlagBits::UnsynchronizedBit)
 			{
-				*data = (std::uint8_t*)_data + offset;
-				return true;
+				flags |= GL_MAP_UNSYNCHRONIZED_BIT;
+				if (!(usage & GraphicsUsageFlagBits::ReadBit))
+					flags |= GL_MAP_INVALIDATE_RANGE_BIT;
 			}
 
+			_mapOffset = 0;
 			*data = _data = glMapNamedBufferRange(_buffer, offset, count, flags);
 			return *data ? true : false;
 		}
@@ -146,9 +169,11 @@ namespace octoon
 		GL45GraphicsData::unmap() noexcept
 		{
 			auto usage = _desc.getUsage();
-			if (!(usage & GraphicsUsageFlagBits::PersistentBit))
+			if (_data && !(usage & GraphicsUsageFlagBits::PersistentBit))
+			{
 				glUnmapNamedBuffer(_buffer);
-			_data = nullptr;
+				_data = nullptr;
+			}
 		}
 
 		GLuint
@@ -1,7 +1,7 @@
 #ifndef OCTOON_GL33_CORE_GRAPHICS_DATA_H_
 #define OCTOON_GL33_CORE_GRAPHICS_DATA_H_
 
-#include "gl33_types.h"
+#include "gl33_fence.h"
 
 namespace octoon
 {
@@ -18,7 +18,7 @@ namespace octoon
 			void close() noexcept;
 
 			std::ptrdiff_t flush() noexcept;
-			std::ptrdiff_t flush(GLintptr offset, GLsizeiptr cnt) noexcept;
+			std::ptrdiff_t flush(std::ptrdiff_t offset, std::ptrdiff_t count) noexcept override;
 
 			bool map(std::ptrdiff_t offset, std::ptrdiff_t count, void** data) noexcept;
 			void unmap() noexcept;
@@ -41,6 +41,11 @@ namespace octoon
 			GLuint _buffer;
 			GLuint64 _bufferAddr;
 			GLvoid* _data;
+			GLintptr _mapOffset;
+
+			// Ranges written through a persistent or unsynchronized mapping.
+			GL33FenceRanges _fences;
+
 			GraphicsDataDesc _desc;
 			GraphicsDeviceWeakPtr _device;
 		};
@@ -30,5 +30,11 @@ namespace octoon
 		{
 			return _swapchain;
 		}
+
+		const GraphicsContextStatistics*
+		GraphicsContext::getStatistics() const noexcept
+		{
+			return nullptr;
+		}
 	}
 }
\ No newline at end of file
@@ -109,6 +109,11 @@ namespace octoon
 			return _main;
 		}
 
+		GraphicsProgramDesc::GraphicsProgramDesc() noexcept
+			: _binaryFormat(0)
+		{
+		}
+
 		bool
 		GraphicsProgramDesc::addShader(GraphicsShaderPtr shader) noexcept
 		{
@@ -140,5 +145,30 @@ namespace octoon
 		{
 			return _shaders;
 		}
+
+		void
+		GraphicsProgramDesc::setProgramBinary(std::vector<std::uint8_t>&& binary, std::uint32_t format) noexcept
+		{
+			_binary = std::move(binary);
+			_binaryFormat = format;
+		}
+
+		const std::vector<std::uint8_t>&
+		GraphicsProgramDesc::getProgramBinary() const noexcept
+		{
+			return _binary;
+		}
+
+		std::uint32_t
+		GraphicsProgramDesc::getProgramBinaryFormat() const noexcept
+		{
+			return _binaryFormat;
+		}
+
+		bool
+		GraphicsProgram::getProgramBinary(std::vector<std::uint8_t>& binary, std::uint32_t& format) const noexcept
+		{
+			return false;
+		}
 	}
 }
\ No newline at end of file
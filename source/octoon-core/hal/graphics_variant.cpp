@@ -111,7 +111,8 @@ namespace octoon
 					delete _value.m4array;
 					_value.m4array = nullptr;
 				}
-				else if (_type == GraphicsUniformType::UniformBuffer)
+				else if (_type == GraphicsUniformType::UniformBuffer ||
+					_type == GraphicsUniformType::StorageBuffer)
 				{
 					delete _value.ubo;
 					_value.ubo = nullptr;
@@ -163,7 +164,8 @@ namespace octoon
 					_value.m3array = new std::vector<float3x3>;
 				else if (type == GraphicsUniformType::Float4x4Array)
 					_value.m4array = new std::vector<float4x4>;
-				else if (type == GraphicsUniformType::UniformBuffer)
+				else if (type == GraphicsUniformType::UniformBuffer ||
+					type == GraphicsUniformType::StorageBuffer)
 					_value.ubo = new GraphicsDataPtr;
 				else if (type == GraphicsUniformType::SamplerImage ||
 					type == GraphicsUniformType::StorageImage ||
@@ -663,7 +665,7 @@ namespace octoon
 		void
 		GraphicsVariant::uniformBuffer(GraphicsDataPtr ubo) noexcept
 		{
-			assert(_type == GraphicsUniformType::UniformBuffer);
+			assert(_type == GraphicsUniformType::UniformBuffer || _type == GraphicsUniformType::StorageBuffer);
 			*_value.ubo = ubo;
 		}
 
@@ -901,7 +903,7 @@ namespace octoon
 		const GraphicsDataPtr&
 		GraphicsVariant::getBuffer() const noexcept
 		{
-			assert(_type == GraphicsUniformType::UniformBuffer);
+			assert(_type == GraphicsUniformType::UniformBuffer || _type == GraphicsUniformType::StorageBuffer);
 			return *_value.ubo;
 		}
 	}
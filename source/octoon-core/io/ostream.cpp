@@ -130,6 +130,12 @@ namespace octoon
 				return (ios_base::pos_type(ios_base::_BADOFF));
 		}
 
+		ios_base::pos_type
+		ostream::tellp() noexcept
+		{
+			return this->tellg();
+		}
+
 		ostream&
 		ostream::operator << (const char* str) noexcept
 		{
@@ -43,6 +43,7 @@ namespace octoon::material
 		, _stencilBackZFail(hal::GraphicsStencilOp::Keep)
 		, _stencilBackPass(hal::GraphicsStencilOp::Keep)
 		, dirty_(true)
+		, revision_(1)
 	{
 	}
 
@@ -515,6 +516,8 @@ namespace octoon::material
 	Material::setDirty(bool dirty) noexcept
 	{
 		this->dirty_ = dirty;
+		if (dirty)
+			this->revision_++;
 	}
 
 	bool
@@ -523,6 +526,12 @@ namespace octoon::material
 		return this->dirty_;
 	}
 
+	std::uint64_t
+	Material::getRevision() const noexcept
+	{
+		return this->revision_;
+	}
+
 	const std::vector<MaterialParam>&
 	Material::getMaterialParams() const noexcept
 	{
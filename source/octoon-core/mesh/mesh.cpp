@@ -11,6 +11,7 @@ namespace octoon::mesh
 	OctoonImplementSubClass(Mesh, runtime::RttiInterface, "Mesh");
 
 	Mesh::Mesh() noexcept
+		: _vertexRevision(0)
 	{
 	}
 
@@ -55,16 +56,30 @@ namespace octoon::mesh
 		return count;
 	}
 
+	void
+	Mesh::markVertexDirty() noexcept
+	{
+		_vertexRevision++;
+	}
+
+	std::uint32_t
+	Mesh::getVertexRevision() const noexcept
+	{
+		return _vertexRevision;
+	}
+
 	void
 	Mesh::setVertexArray(const float3s& array) noexcept
 	{
 		_vertices = array;
+		_vertexRevision++;
 	}
 
 	void
 	Mesh::setNormalArray(const float3s& array) noexcept
 	{
 		_normals = array;
+		_vertexRevision++;
 	}
 
 	void
@@ -106,16 +121,30 @@ namespace octoon::mesh
 		_weights = array;
 	}
 
+	void
+	Mesh::setSkinningModeArray(const skelecton::SkinningModes& array) noexcept
+	{
+		_skinningModes = array;
+	}
+
+	void
+	Mesh::setSphericalDeformArray(const skelecton::SphericalDeforms& array) noexcept
+	{
+		_sphericalDeforms = array;
+	}
+
 	void
 	Mesh::setVertexArray(float3s&& array) noexcept
 	{
 		_vertices = std::move(array);
+		_vertexRevision++;
 	}
 
 	void
 	Mesh::setNormalArray(float3s&& array) noexcept
 	{
 		_normals = std::move(array);
+		_vertexRevision++;
 	}
 
 	void
@@ -151,6 +180,18 @@ namespace octoon::mesh
 		_weights = std::move(array);
 	}
 
+	void
+	Mesh::setSkinningModeArray(skelecton::SkinningModes&& array) noexcept
+	{
+		_skinningModes = std::move(array);
+	}
+
+	void
+	Mesh::setSphericalDeformArray(skelecton::SphericalDeforms&& array) noexcept
+	{
+		_sphericalDeforms = std::move(array);
+	}
+
 	void
 	Mesh::setBindposes(float4x4s&& array) noexcept
 	{
@@ -194,6 +235,18 @@ namespace octoon::mesh
 		return _weights;
 	}
 
+	skelecton::SkinningModes&
+	Mesh::getSkinningModeArray() noexcept
+	{
+		return _skinningModes;
+	}
+
+	skelecton::SphericalDeforms&
+	Mesh::getSphericalDeformArray() noexcept
+	{
+		return _sphericalDeforms;
+	}
+
 	uint1s&
 	Mesh::getIndicesArray(std::size_t n) noexcept
 	{
@@ -243,6 +296,18 @@ namespace octoon::mesh
 		return _weights;
 	}
 
+	const skelecton::SkinningModes&
+	Mesh::getSkinningModeArray() const noexcept
+	{
+		return _skinningModes;
+	}
+
+	const skelecton::SphericalDeforms&
+	Mesh::getSphericalDeformArray() const noexcept
+	{
+		return _sphericalDeforms;
+	}
+
 	const float4x4s&
 	Mesh::getBindposes() const noexcept
 	{
@@ -351,6 +416,8 @@ namespace octoon::mesh
 		_normals.shrink_to_fit();
 		_colors.shrink_to_fit();
 		_tangents.shrink_to_fit();
+		_skinningModes.shrink_to_fit();
+		_sphericalDeforms.shrink_to_fit();
 
 		for (auto& it : _indices)
 			it.shrink_to_fit();
@@ -368,6 +435,8 @@ namespace octoon::mesh
 		mesh->setNormalArray(this->getNormalArray());
 		mesh->setColorArray(this->getColorArray());
 		mesh->setWeightArray(this->getWeightArray());
+		mesh->setSkinningModeArray(this->getSkinningModeArray());
+		mesh->setSphericalDeformArray(this->getSphericalDeformArray());
 		mesh->setTangentArray(this->getTangentArray());
 		mesh->setBindposes(this->getBindposes());
 		mesh->_boundingBox = this->_boundingBox;
@@ -395,6 +464,7 @@ namespace octoon::mesh
 			if (_indices.empty() != mesh._indices.empty()) return false;
 			if (_bones.empty() != mesh._bones.empty()) return false;
 			if (_weights.empty() != mesh._weights.empty()) return false;
+			if (_skinningModes.empty() != mesh._skinningModes.empty()) return false;
 
 			for (std::size_t i = 0; i < TEXTURE_ARRAY_COUNT; i++)
 			{
@@ -412,6 +482,24 @@ namespace octoon::mesh
 		_bones.insert(_bones.end(), mesh._bones.begin(), mesh._bones.end());
 		_weights.insert(_weights.end(), mesh._weights.begin(), mesh._weights.end());
 
+		if (!_skinningModes.empty() || !mesh._skinningModes.empty())
+		{
+			_skinningModes.resize(_vertices.size() - mesh._vertices.size(), skelecton::SkinningMode::Linear);
+			_sphericalDeforms.resize(_skinningModes.size());
+
+			if (mesh._skinningModes.empty())
+			{
+				_skinningModes.resize(_vertices.size(), skelecton::SkinningMode::Linear);
+				_sphericalDeforms.resize(_vertices.size());
+			}
+			else
+			{
+				_skinningModes.insert(_skinningModes.end(), mesh._skinningModes.begin(), mesh._skinningModes.end());
+				_sphericalDeforms.insert(_sphericalDeforms.end(), mesh._sphericalDeforms.begin(), mesh._sphericalDeforms.end());
+				_sphericalDeforms.resize(_skinningModes.size());
+			}
+		}
+
 		for (std::size_t i = 0; i < TEXTURE_ARRAY_COUNT; i++)
 			_texcoords[i].insert(_texcoords[i].end(), mesh._texcoords[i].begin(), mesh._texcoords[i].end());
 
@@ -0,0 +1,1092 @@
+#include <octoon/model/skinning.h>
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#	define OCTOON_SKINNING_X86 1
+#	if defined(_MSC_VER)
+#		include <intrin.h>
+#		include <immintrin.h>
+#		define OCTOON_SKINNING_TARGET_AVX2
+#	else
+#		include <cpuid.h>
+#		include <immintrin.h>
+#		define OCTOON_SKINNING_TARGET_AVX2 __attribute__((target("avx2,fma")))
+#	endif
+#	if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#		define OCTOON_SKINNING_SSE 1
+#	endif
+#	define OCTOON_SKINNING_AVX2 1
+#endif
+
+namespace octoon::skelecton
+{
+	constexpr std::size_t SkinningBlockSize = 2048;
+
+	struct ContiguousIndex
+	{
+		std::size_t operator()(std::size_t i) const noexcept { return i; }
+	};
+
+	struct IndirectIndex
+	{
+		const std::uint32_t* indices;
+		std::size_t operator()(std::size_t i) const noexcept { return indices[i]; }
+	};
+
+	void
+	SkinningStreams::setVertexArray(const math::float3s& array) noexcept
+	{
+		positionX.resize(array.size());
+		positionY.resize(array.size());
+		positionZ.resize(array.size());
+
+		for (std::size_t i = 0; i < array.size(); i++)
+		{
+			positionX[i] = array[i].x;
+			positionY[i] = array[i].y;
+			positionZ[i] = array[i].z;
+		}
+	}
+
+	void
+	SkinningStreams::setNormalArray(const math::float3s& array) noexcept
+	{
+		normalX.resize(array.size());
+		normalY.resize(array.size());
+		normalZ.resize(array.size());
+
+		for (std::size_t i = 0; i < array.size(); i++)
+		{
+			normalX[i] = array[i].x;
+			normalY[i] = array[i].y;
+			normalZ[i] = array[i].z;
+		}
+	}
+
+	void
+	SkinningStreams::setWeightArray(const VertexWeights& array) noexcept
+	{
+		weights.resize(array.size());
+		bones.resize(array.size() * 4);
+
+		for (std::size_t i = 0; i < array.size(); i++)
+		{
+			weights[i].set(array[i].weight1, array[i].weight2, array[i].weight3, array[i].weight4);
+
+			for (std::uint8_t j = 0; j < 4; j++)
+				bones[i * 4 + j] = array[i].bones[j];
+		}
+	}
+
+	void
+	SkinningStreams::setSkinningModeArray(const SkinningModes& modes, const SphericalDeforms& deforms) noexcept
+	{
+		assert(modes.empty() || modes.size() == weights.size());
+
+		linearIndices.clear();
+		dualQuaternionIndices.clear();
+		sphericalIndices.clear();
+		sphericalCenters.clear();
+		sphericalR0.clear();
+		sphericalR1.clear();
+
+		for (std::size_t i = 0; i < modes.size(); i++)
+		{
+			auto index = static_cast<std::uint32_t>(i);
+
+			switch (modes[i])
+			{
+			case SkinningMode::DualQuaternion:
+				dualQuaternionIndices.push_back(index);
+				break;
+			case SkinningMode::Spherical:
+			{
+				if (i >= deforms.size())
+				{
+					linearIndices.push_back(index);
+					break;
+				}
+
+				auto w0 = weights[i].x;
+				auto w1 = 1.0f - w0;
+
+				auto& sdef = deforms[i];
+				auto rw = sdef.r0 * w0 + sdef.r1 * w1;
+				auto r0 = sdef.center + sdef.r0 - rw;
+				auto r1 = sdef.center + sdef.r1 - rw;
+
+				sphericalIndices.push_back(index);
+				sphericalCenters.push_back(sdef.center);
+				sphericalR0.push_back((sdef.center + r0) * 0.5f);
+				sphericalR1.push_back((sdef.center + r1) * 0.5f);
+			}
+			break;
+			default:
+				linearIndices.push_back(index);
+			}
+		}
+
+		if (this->isLinearOnly())
+			linearIndices.clear();
+	}
+
+	std::size_t
+	SkinningStreams::getNumVertices() const noexcept
+	{
+		return positionX.size();
+	}
+
+	bool
+	SkinningStreams::isLinearOnly() const noexcept
+	{
+		return dualQuaternionIndices.empty() && sphericalIndices.empty();
+	}
+
+	void
+	SkinningStreams::clear() noexcept
+	{
+		positionX.clear();
+		positionY.clear();
+		positionZ.clear();
+		normalX.clear();
+		normalY.clear();
+		normalZ.clear();
+		weights.clear();
+		bones.clear();
+		linearIndices.clear();
+		dualQuaternionIndices.clear();
+		sphericalIndices.clear();
+		sphericalCenters.clear();
+		sphericalR0.clear();
+		sphericalR1.clear();
+	}
+
+	void
+	MorphStreams::setMorphArray(std::size_t numVertices, const std::vector<std::pair<const math::uint1s*, const math::float3s*>>& morphs) noexcept
+	{
+		this->clear();
+
+		rows.assign(numVertices + 1, 0);
+		morphOffsets.assign(morphs.size() + 1, 0);
+
+		for (std::size_t m = 0; m < morphs.size(); m++)
+		{
+			auto& indices = *morphs[m].first;
+			auto numIndices = std::min(indices.size(), morphs[m].second->size());
+
+			auto first = morphVertices.size();
+
+			for (std::size_t i = 0; i < numIndices; i++)
+			{
+				if (indices[i] < numVertices)
+				{
+					rows[indices[i] + 1]++;
+					morphVertices.push_back(indices[i]);
+				}
+			}
+
+			std::sort(morphVertices.begin() + first, morphVertices.end());
+			morphVertices.erase(std::unique(morphVertices.begin() + first, morphVertices.end()), morphVertices.end());
+
+			morphOffsets[m + 1] = static_cast<std::uint32_t>(morphVertices.size());
+		}
+
+		for (std::size_t i = 0; i < numVertices; i++)
+			rows[i + 1] += rows[i];
+
+		targets.resize(rows[numVertices]);
+		deltas.resize(rows[numVertices]);
+
+		std::vector<std::uint32_t> cursor(rows.begin(), rows.end() - 1);
+
+		for (std::size_t m = 0; m < morphs.size(); m++)
+		{
+			auto& indices = *morphs[m].first;
+			auto& offsets = *morphs[m].second;
+
+			auto numIndices = std::min(indices.size(), offsets.size());
+			for (std::size_t i = 0; i < numIndices; i++)
+			{
+				if (indices[i] < numVertices)
+				{
+					auto entry = cursor[indices[i]]++;
+					targets[entry] = static_cast<std::uint32_t>(m);
+					deltas[entry].set(offsets[i].x, offsets[i].y, offsets[i].z, 0.0f);
+				}
+			}
+		}
+	}
+
+	std::size_t
+	MorphStreams::getNumMorphs() const noexcept
+	{
+		return morphOffsets.empty() ? 0 : morphOffsets.size() - 1;
+	}
+
+	bool
+	MorphStreams::empty() const noexcept
+	{
+		return targets.empty();
+	}
+
+	void
+	MorphStreams::clear() noexcept
+	{
+		rows.clear();
+		targets.clear();
+		deltas.clear();
+		morphOffsets.clear();
+		morphVertices.clear();
+	}
+
+	SkinningData::SkinningData() noexcept
+		: streamRevision(0)
+		, positionRevision(0)
+		, poseRevision(0)
+	{
+	}
+
+	// Builds the rotation quaternion (x, y, z, w) and the dual part of every joint, stored as two float4 per joint.
+	static void
+	computeDualQuaternions(const math::float4x4s& joints, math::float4s& dualQuaternions) noexcept
+	{
+		dualQuaternions.resize(joints.size() * 2);
+
+		for (std::size_t i = 0; i < joints.size(); i++)
+		{
+			auto& m = joints[i];
+
+			float x, y, z, w;
+			float trace = m.a1 + m.b2 + m.c3;
+			if (trace > 0.0f)
+			{
+				float s = 0.5f / std::sqrt(trace + 1.0f);
+				w = 0.25f / s;
+				x = (m.b3 - m.c2) * s;
+				y = (m.c1 - m.a3) * s;
+				z = (m.a2 - m.b1) * s;
+			}
+			else if (m.a1 > m.b2 && m.a1 > m.c3)
+			{
+				float s = 2.0f * std::sqrt(1.0f + m.a1 - m.b2 - m.c3);
+				w = (m.b3 - m.c2) / s;
+				x = 0.25f * s;
+				y = (m.b1 + m.a2) / s;
+				z = (m.c1 + m.a3) / s;
+			}
+			else if (m.b2 > m.c3)
+			{
+				float s = 2.0f * std::sqrt(1.0f + m.b2 - m.a1 - m.c3);
+				w = (m.c1 - m.a3) / s;
+				x = (m.b1 + m.a2) / s;
+				y = 0.25f * s;
+				z = (m.c2 + m.b3) / s;
+			}
+			else
+			{
+				float s = 2.0f * std::sqrt(1.0f + m.c3 - m.a1 - m.b2);
+				w = (m.a2 - m.b1) / s;
+				x = (m.c1 + m.a3) / s;
+				y = (m.c2 + m.b3) / s;
+				z = 0.25f * s;
+			}
+
+			float length = std::sqrt(x * x + y * y + z * z + w * w);
+			x /= length; y /= length; z /= length; w /= length;
+
+			float tx = m.d1, ty = m.d2, tz = m.d3;
+
+			dualQuaternions[i * 2].set(x, y, z, w);
+			dualQuaternions[i * 2 + 1].set(
+				0.5f * (w * tx + ty * z - tz * y),
+				0.5f * (w * ty + tz * x - tx * z),
+				0.5f * (w * tz + tx * y - ty * x),
+				-0.5f * (tx * x + ty * y + tz * z));
+		}
+	}
+
+	static inline math::float3
+	rotate(const math::float4& q, const math::float3& v) noexcept
+	{
+		math::float3 u(q.x, q.y, q.z);
+		math::float3 t = math::cross(u, v) * 2.0f;
+		return v + t * q.w + math::cross(u, t);
+	}
+
+	template<typename Index>
+	static void
+	linearScalar(const math::float4x4* joints, const SkinningStreams& streams, Index index, math::float3* vertices, math::float3* normals, std::size_t first, std::size_t last) noexcept
+	{
+		for (std::size_t k = first; k < last; k++)
+		{
+			auto i = index(k);
+			auto& w = streams.weights[i];
+			auto b = &streams.bones[i * 4];
+
+			float m[12] = { 0 };
+			for (std::uint8_t j = 0; j < 4; j++)
+			{
+				auto joint = &joints[b[j]].a1;
+				auto weight = w[j];
+
+				m[0] += joint[0] * weight;
+				m[1] += joint[1] * weight;
+				m[2] += joint[2] * weight;
+				m[3] += joint[4] * weight;
+				m[4] += joint[5] * weight;
+				m[5] += joint[6] * weight;
+				m[6] += joint[8] * weight;
+				m[7] += joint[9] * weight;
+				m[8] += joint[10] * weight;
+				m[9] += joint[12] * weight;
+				m[10] += joint[13] * weight;
+				m[11] += joint[14] * weight;
+			}
+
+			float px = streams.positionX[i];
+			float py = streams.positionY[i];
+			float pz = streams.positionZ[i];
+
+			float nx = streams.normalX[i];
+			float ny = streams.normalY[i];
+			float nz = streams.normalZ[i];
+
+			vertices[i].set(
+				px * m[0] + py * m[3] + pz * m[6] + m[9],
+				px * m[1] + py * m[4] + pz * m[7] + m[10],
+				px * m[2] + py * m[5] + pz * m[8] + m[11]);
+
+			normals[i].set(
+				nx * m[0] + ny * m[3] + nz * m[6],
+				nx * m[1] + ny * m[4] + nz * m[7],
+				nx * m[2] + ny * m[5] + nz * m[8]);
+		}
+	}
+
+	static void
+	dualQuaternionScalar(const math::float4* dualQuaternions, const SkinningStreams& streams, math::float3* vertices, math::float3* normals, std::size_t first, std::size_t last) noexcept
+	{
+		for (std::size_t k = first; k < last; k++)
+		{
+			auto i = streams.dualQuaternionIndices[k];
+			auto& w = streams.weights[i];
+			auto b = &streams.bones[i * 4];
+
+			auto& pivot = dualQuaternions[b[0] * 2];
+
+			math::float4 real = math::float4::Zero;
+			math::float4 dual = math::float4::Zero;
+
+			for (std::uint8_t j = 0; j < 4; j++)
+			{
+				auto& r = dualQuaternions[b[j] * 2];
+				auto& d = dualQuaternions[b[j] * 2 + 1];
+				auto weight = math::dot(r, pivot) < 0.0f ? -w[j] : w[j];
+
+				real += r * weight;
+				dual += d * weight;
+			}
+
+			auto length = math::length(real);
+			real /= length;
+			dual /= length;
+
+			math::float3 r(real.x, real.y, real.z);
+			math::float3 d(dual.x, dual.y, dual.z);
+			math::float3 translate = (d * real.w - r * dual.w + math::cross(r, d)) * 2.0f;
+
+			math::float3 position(streams.positionX[i], streams.positionY[i], streams.positionZ[i]);
+			math::float3 normal(streams.normalX[i], streams.normalY[i], streams.normalZ[i]);
+
+			vertices[i] = rotate(real, position) + translate;
+			normals[i] = rotate(real, normal);
+		}
+	}
+
+	static void
+	sphericalScalar(const math::float4x4* joints, const math::float4* dualQuaternions, const SkinningStreams& streams, math::float3* vertices, math::float3* normals, std::size_t first, std::size_t last) noexcept
+	{
+		for (std::size_t k = first; k < last; k++)
+		{
+			auto i = streams.sphericalIndices[k];
+			auto b = &streams.bones[i * 4];
+
+			auto w0 = streams.weights[i].x;
+			auto w1 = 1.0f - w0;
+
+			auto& q0 = dualQuaternions[b[0] * 2];
+			auto& q1 = dualQuaternions[b[1] * 2];
+
+			auto q = q0 * w0 + q1 * (math::dot(q0, q1) < 0.0f ? -w1 : w1);
+			q /= math::length(q);
+
+			math::float3 position(streams.positionX[i], streams.positionY[i], streams.positionZ[i]);
+			math::float3 normal(streams.normalX[i], streams.normalY[i], streams.normalZ[i]);
+
+			auto cr0 = joints[b[0]] * streams.sphericalR0[k];
+			auto cr1 = joints[b[1]] * streams.sphericalR1[k];
+
+			vertices[i] = rotate(q, position - streams.sphericalCenters[k]) + cr0 * w0 + cr1 * w1;
+			normals[i] = rotate(q, normal);
+		}
+	}
+
+#if defined(OCTOON_SKINNING_SSE)
+	static inline __m128
+	crossSSE(__m128 a, __m128 b) noexcept
+	{
+		auto a_yzx = _mm_shuffle_ps(a, a, _MM_SHUFFLE(3, 0, 2, 1));
+		auto b_yzx = _mm_shuffle_ps(b, b, _MM_SHUFFLE(3, 0, 2, 1));
+		auto c = _mm_sub_ps(_mm_mul_ps(a, b_yzx), _mm_mul_ps(a_yzx, b));
+		return _mm_shuffle_ps(c, c, _MM_SHUFFLE(3, 0, 2, 1));
+	}
+
+	static inline __m128
+	rotateSSE(__m128 q, __m128 v) noexcept
+	{
+		auto t = crossSSE(q, v);
+		t = _mm_add_ps(t, t);
+		auto w = _mm_shuffle_ps(q, q, _MM_SHUFFLE(3, 3, 3, 3));
+		return _mm_add_ps(_mm_add_ps(v, _mm_mul_ps(t, w)), crossSSE(q, t));
+	}
+
+	static inline float
+	dotSSE(const float* a, const float* b) noexcept
+	{
+		return a[0] * b[0] + a[1] * b[1] + a[2] * b[2] + a[3] * b[3];
+	}
+
+	template<typename Index>
+	static void
+	linearSSE(const math::float4x4* joints, const SkinningStreams& streams, Index index, math::float3* vertices, math::float3* normals, std::size_t first, std::size_t last) noexcept
+	{
+		alignas(16) float v[4];
+		alignas(16) float n[4];
+
+		for (std::size_t k = first; k < last; k++)
+		{
+			auto i = index(k);
+			auto w = _mm_loadu_ps(streams.weights[i].ptr());
+			auto b = &streams.bones[i * 4];
+
+			auto m0 = &joints[b[0]].a1;
+			auto m1 = &joints[b[1]].a1;
+			auto m2 = &joints[b[2]].a1;
+			auto m3 = &joints[b[3]].a1;
+
+			auto w0 = _mm_shuffle_ps(w, w, _MM_SHUFFLE(0, 0, 0, 0));
+			auto w1 = _mm_shuffle_ps(w, w, _MM_SHUFFLE(1, 1, 1, 1));
+			auto w2 = _mm_shuffle_ps(w, w, _MM_SHUFFLE(2, 2, 2, 2));
+			auto w3 = _mm_shuffle_ps(w, w, _MM_SHUFFLE(3, 3, 3, 3));
+
+			auto right = _mm_mul_ps(_mm_loadu_ps(m0), w0);
+			right = _mm_add_ps(right, _mm_mul_ps(_mm_loadu_ps(m1), w1));
+			right = _mm_add_ps(right, _mm_mul_ps(_mm_loadu_ps(m2), w2));
+			right = _mm_add_ps(right, _mm_mul_ps(_mm_loadu_ps(m3), w3));
+
+			auto up = _mm_mul_ps(_mm_loadu_ps(m0 + 4), w0);
+			up = _mm_add_ps(up, _mm_mul_ps(_mm_loadu_ps(m1 + 4), w1));
+			up = _mm_add_ps(up, _mm_mul_ps(_mm_loadu_ps(m2 + 4), w2));
+			up = _mm_add_ps(up, _mm_mul_ps(_mm_loadu_ps(m3 + 4), w3));
+
+			auto forward = _mm_mul_ps(_mm_loadu_ps(m0 + 8), w0);
+			forward = _mm_add_ps(forward, _mm_mul_ps(_mm_loadu_ps(m1 + 8), w1));
+			forward = _mm_add_ps(forward, _mm_mul_ps(_mm_loadu_ps(m2 + 8), w2));
+			forward = _mm_add_ps(forward, _mm_mul_ps(_mm_loadu_ps(m3 + 8), w3));
+
+			auto position = _mm_mul_ps(_mm_loadu_ps(m0 + 12), w0);
+			position = _mm_add_ps(position, _mm_mul_ps(_mm_loadu_ps(m1 + 12), w1));
+			position = _mm_add_ps(position, _mm_mul_ps(_mm_loadu_ps(m2 + 12), w2));
+			position = _mm_add_ps(position, _mm_mul_ps(_mm_loadu_ps(m3 + 12), w3));
+
+			auto normal = _mm_mul_ps(right, _mm_set1_ps(streams.normalX[i]));
+			normal = _mm_add_ps(normal, _mm_mul_ps(up, _mm_set1_ps(streams.normalY[i])));
+			normal = _mm_add_ps(normal, _mm_mul_ps(forward, _mm_set1_ps(streams.normalZ[i])));
+
+			position = _mm_add_ps(position, _mm_mul_ps(right, _mm_set1_ps(streams.positionX[i])));
+			position = _mm_add_ps(position, _mm_mul_ps(up, _mm_set1_ps(streams.positionY[i])));
+			position = _mm_add_ps(position, _mm_mul_ps(forward, _mm_set1_ps(streams.positionZ[i])));
+
+			_mm_store_ps(v, position);
+			_mm_store_ps(n, normal);
+
+			vertices[i].set(v[0], v[1], v[2]);
+			normals[i].set(n[0], n[1], n[2]);
+		}
+	}
+
+	static void
+	dualQuaternionSSE(const math::float4* dualQuaternions, const SkinningStreams& streams, math::float3* vertices, math::float3* normals, std::size_t first, std::size_t last) noexcept
+	{
+		alignas(16) float v[4];
+		alignas(16) float n[4];
+		alignas(16) float q[4];
+
+		for (std::size_t k = first; k < last; k++)
+		{
+			auto i = streams.dualQuaternionIndices[k];
+			auto w = streams.weights[i].ptr();
+			auto b = &streams.bones[i * 4];
+
+			auto pivot = dualQuaternions[b[0] * 2].ptr();
+
+			auto real = _mm_setzero_ps();
+			auto dual = _mm_setzero_ps();
+
+			for (std::uint8_t j = 0; j < 4; j++)
+			{
+				auto r = dualQuaternions[b[j] * 2].ptr();
+				auto d = dualQuaternions[b[j] * 2 + 1].ptr();
+				auto weight = _mm_set1_ps(dotSSE(r, pivot) < 0.0f ? -w[j] : w[j]);
+
+				real = _mm_add_ps(real, _mm_mul_ps(_mm_loadu_ps(r), weight));
+				dual = _mm_add_ps(dual, _mm_mul_ps(_mm_loadu_ps(d), weight));
+			}
+
+			_mm_store_ps(q, real);
+			auto scale = _mm_set1_ps(1.0f / std::sqrt(dotSSE(q, q)));
+			real = _mm_mul_ps(real, scale);
+			dual = _mm_mul_ps(dual, scale);
+
+			auto realW = _mm_shuffle_ps(real, real, _MM_SHUFFLE(3, 3, 3, 3));
+			auto dualW = _mm_shuffle_ps(dual, dual, _MM_SHUFFLE(3, 3, 3, 3));
+
+			auto translate = _mm_sub_ps(_mm_mul_ps(dual, realW), _mm_mul_ps(real, dualW));
+			translate = _mm_add_ps(translate, crossSSE(real, dual));
+			translate = _mm_add_ps(translate, translate);
+
+			auto position = _mm_set_ps(0.0f, streams.positionZ[i], streams.positionY[i], streams.positionX[i]);
+			auto normal = _mm_set_ps(0.0f, streams.normalZ[i], streams.normalY[i], streams.normalX[i]);
+
+			_mm_store_ps(v, _mm_add_ps(rotateSSE(real, position), translate));
+			_mm_store_ps(n, rotateSSE(real, normal));
+
+			vertices[i].set(v[0], v[1], v[2]);
+			normals[i].set(n[0], n[1], n[2]);
+		}
+	}
+
+	static void
+	sphericalSSE(const math::float4x4* joints, const math::float4* dualQuaternions, const SkinningStreams& streams, math::float3* vertices, math::float3* normals, std::size_t first, std::size_t last) noexcept
+	{
+		alignas(16) float v[4];
+		alignas(16) float n[4];
+		alignas(16) float q[4];
+
+		for (std::size_t k = first; k < last; k++)
+		{
+			auto i = streams.sphericalIndices[k];
+			auto b = &streams.bones[i * 4];
+
+			auto w0 = streams.weights[i].x;
+			auto w1 = 1.0f - w0;
+
+			auto q0 = dualQuaternions[b[0] * 2].ptr();
+			auto q1 = dualQuaternions[b[1] * 2].ptr();
+
+			auto rotation = _mm_mul_ps(_mm_loadu_ps(q0), _mm_set1_ps(w0));
+			rotation = _mm_add_ps(rotation, _mm_mul_ps(_mm_loadu_ps(q1), _mm_set1_ps(dotSSE(q0, q1) < 0.0f ? -w1 : w1)));
+
+			_mm_store_ps(q, rotation);
+			rotation = _mm_mul_ps(rotation, _mm_set1_ps(1.0f / std::sqrt(dotSSE(q, q))));
+
+			auto m0 = &joints[b[0]].a1;
+			auto m1 = &joints[b[1]].a1;
+
+			auto& cr0 = streams.sphericalR0[k];
+			auto& cr1 = streams.sphericalR1[k];
+
+			auto p0 = _mm_loadu_ps(m0 + 12);
+			p0 = _mm_add_ps(p0, _mm_mul_ps(_mm_loadu_ps(m0), _mm_set1_ps(cr0.x)));
+			p0 = _mm_add_ps(p0, _mm_mul_ps(_mm_loadu_ps(m0 + 4), _mm_set1_ps(cr0.y)));
+			p0 = _mm_add_ps(p0, _mm_mul_ps(_mm_loadu_ps(m0 + 8), _mm_set1_ps(cr0.z)));
+
+			auto p1 = _mm_loadu_ps(m1 + 12);
+			p1 = _mm_add_ps(p1, _mm_mul_ps(_mm_loadu_ps(m1), _mm_set1_ps(cr1.x)));
+			p1 = _mm_add_ps(p1, _mm_mul_ps(_mm_loadu_ps(m1 + 4), _mm_set1_ps(cr1.y)));
+			p1 = _mm_add_ps(p1, _mm_mul_ps(_mm_loadu_ps(m1 + 8), _mm_set1_ps(cr1.z)));
+
+			auto& center = streams.sphericalCenters[k];
+			auto position = _mm_set_ps(0.0f, streams.positionZ[i] - center.z, streams.positionY[i] - center.y, streams.positionX[i] - center.x);
+			auto normal = _mm_set_ps(0.0f, streams.normalZ[i], streams.normalY[i], streams.normalX[i]);
+
+			position = rotateSSE(rotation, position);
+			position = _mm_add_ps(position, _mm_mul_ps(p0, _mm_set1_ps(w0)));
+			position = _mm_add_ps(position, _mm_mul_ps(p1, _mm_set1_ps(w1)));
+
+			_mm_store_ps(v, position);
+			_mm_store_ps(n, rotateSSE(rotation, normal));
+
+			vertices[i].set(v[0], v[1], v[2]);
+			normals[i].set(n[0], n[1], n[2]);
+		}
+	}
+#endif
+
+#if defined(OCTOON_SKINNING_AVX2)
+	OCTOON_SKINNING_TARGET_AVX2 static inline __m256
+	loadJointRows(const float* lo, const float* hi) noexcept
+	{
+		return _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(lo)), _mm_loadu_ps(hi), 1);
+	}
+
+	OCTOON_SKINNING_TARGET_AVX2 static inline __m256
+	broadcastPair(float lo, float hi) noexcept
+	{
+		return _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_set1_ps(lo)), _mm_set1_ps(hi), 1);
+	}
+
+	// Two vertices per iteration, one in each 128-bit lane, blending the joint rows with FMA.
+	template<typename Index>
+	OCTOON_SKINNING_TARGET_AVX2 static void
+	linearAVX2(const math::float4x4* joints, const SkinningStreams& streams, Index index, math::float3* vertices, math::float3* normals, std::size_t first, std::size_t last) noexcept
+	{
+		alignas(32) float v[8];
+		alignas(32) float n[8];
+
+		std::size_t k = first;
+
+		for (; k + 1 < last; k += 2)
+		{
+			auto ia = index(k);
+			auto ib = index(k + 1);
+
+			auto wa = streams.weights[ia].ptr();
+			auto wb = streams.weights[ib].ptr();
+			auto ba = &streams.bones[ia * 4];
+			auto bb = &streams.bones[ib * 4];
+
+			auto right = _mm256_setzero_ps();
+			auto up = _mm256_setzero_ps();
+			auto forward = _mm256_setzero_ps();
+			auto position = _mm256_setzero_ps();
+
+			for (std::uint8_t j = 0; j < 4; j++)
+			{
+				auto ma = &joints[ba[j]].a1;
+				auto mb = &joints[bb[j]].a1;
+				auto w = broadcastPair(wa[j], wb[j]);
+
+				right = _mm256_fmadd_ps(loadJointRows(ma, mb), w, right);
+				up = _mm256_fmadd_ps(loadJointRows(ma + 4, mb + 4), w, up);
+				forward = _mm256_fmadd_ps(loadJointRows(ma + 8, mb + 8), w, forward);
+				position = _mm256_fmadd_ps(loadJointRows(ma + 12, mb + 12), w, position);
+			}
+
+			auto normal = _mm256_mul_ps(right, broadcastPair(streams.normalX[ia], streams.normalX[ib]));
+			normal = _mm256_fmadd_ps(up, broadcastPair(streams.normalY[ia], streams.normalY[ib]), normal);
+			normal = _mm256_fmadd_ps(forward, broadcastPair(streams.normalZ[ia], streams.normalZ[ib]), normal);
+
+			position = _mm256_fmadd_ps(right, broadcastPair(streams.positionX[ia], streams.positionX[ib]), position);
+			position = _mm256_fmadd_ps(up, broadcastPair(streams.positionY[ia], streams.positionY[ib]), position);
+			position = _mm256_fmadd_ps(forward, broadcastPair(streams.positionZ[ia], streams.positionZ[ib]), position);
+
+			_mm256_store_ps(v, position);
+			_mm256_store_ps(n, normal);
+
+			vertices[ia].set(v[0], v[1], v[2]);
+			vertices[ib].set(v[4], v[5], v[6]);
+			normals[ia].set(n[0], n[1], n[2]);
+			normals[ib].set(n[4], n[5], n[6]);
+		}
+
+		if (k < last)
+			linearScalar(joints, streams, index, vertices, normals, k, last);
+	}
+#endif
+
+	template<typename Index>
+	static void
+	linearSkinning(const math::float4x4* joints, const SkinningStreams& streams, Index index, math::float3* vertices, math::float3* normals, std::size_t first, std::size_t last, SkinningKernel kernel) noexcept
+	{
+		switch (kernel)
+		{
+#if defined(OCTOON_SKINNING_AVX2)
+		case SkinningKernel::AVX2:
+			if (detectSkinningKernel() == SkinningKernel::AVX2)
+			{
+				linearAVX2(joints, streams, index, vertices, normals, first, last);
+				break;
+			}
+			[[fallthrough]];
+#endif
+#if defined(OCTOON_SKINNING_SSE)
+		case SkinningKernel::SSE:
+			linearSSE(joints, streams, index, vertices, normals, first, last);
+			break;
+#endif
+		default:
+			linearScalar(joints, streams, index, vertices, normals, first, last);
+		}
+	}
+
+	// Morph kernels sum the weighted deltas of each listed vertex and hand the total to write(vertex, x, y, z).
+	template<typename Write>
+	static void
+	morphScalar(const MorphStreams& morphs, const float* weights, const std::uint32_t* vertices, std::size_t first, std::size_t last, Write write) noexcept
+	{
+		for (std::size_t k = first; k < last; k++)
+		{
+			auto i = vertices[k];
+			float x = 0.0f, y = 0.0f, z = 0.0f;
+
+			for (auto j = morphs.rows[i]; j < morphs.rows[i + 1]; j++)
+			{
+				auto weight = weights[morphs.targets[j]];
+				x += morphs.deltas[j].x * weight;
+				y += morphs.deltas[j].y * weight;
+				z += morphs.deltas[j].z * weight;
+			}
+
+			write(i, x, y, z);
+		}
+	}
+
+#if defined(OCTOON_SKINNING_SSE)
+	template<typename Write>
+	static void
+	morphSSE(const MorphStreams& morphs, const float* weights, const std::uint32_t* vertices, std::size_t first, std::size_t last, Write write) noexcept
+	{
+		alignas(16) float v[4];
+
+		auto deltas = morphs.deltas.front().ptr();
+
+		for (std::size_t k = first; k < last; k++)
+		{
+			auto i = vertices[k];
+			auto sum = _mm_setzero_ps();
+
+			for (auto j = morphs.rows[i]; j < morphs.rows[i + 1]; j++)
+				sum = _mm_add_ps(sum, _mm_mul_ps(_mm_loadu_ps(deltas + j * 4), _mm_set1_ps(weights[morphs.targets[j]])));
+
+			_mm_store_ps(v, sum);
+			write(i, v[0], v[1], v[2]);
+		}
+	}
+#endif
+
+#if defined(OCTOON_SKINNING_AVX2)
+	template<typename Write>
+	OCTOON_SKINNING_TARGET_AVX2 static void
+	morphFMA(const MorphStreams& morphs, const float* weights, const std::uint32_t* vertices, std::size_t first, std::size_t last, Write write) noexcept
+	{
+		alignas(16) float v[4];
+
+		auto deltas = morphs.deltas.front().ptr();
+
+		for (std::size_t k = first; k < last; k++)
+		{
+			auto i = vertices[k];
+			auto sum = _mm_setzero_ps();
+
+			for (auto j = morphs.rows[i]; j < morphs.rows[i + 1]; j++)
+				sum = _mm_fmadd_ps(_mm_loadu_ps(deltas + j * 4), _mm_set1_ps(weights[morphs.targets[j]]), sum);
+
+			_mm_store_ps(v, sum);
+			write(i, v[0], v[1], v[2]);
+		}
+	}
+#endif
+
+	template<typename Write>
+	static void
+	morphBlock(const MorphStreams& morphs, const float* weights, const std::uint32_t* vertices, std::size_t first, std::size_t last, SkinningKernel kernel, Write write) noexcept
+	{
+		switch (kernel)
+		{
+#if defined(OCTOON_SKINNING_AVX2)
+		case SkinningKernel::AVX2:
+			if (detectSkinningKernel() == SkinningKernel::AVX2)
+			{
+				morphFMA(morphs, weights, vertices, first, last, write);
+				break;
+			}
+			[[fallthrough]];
+#endif
+#if defined(OCTOON_SKINNING_SSE)
+		case SkinningKernel::SSE:
+			morphSSE(morphs, weights, vertices, first, last, write);
+			break;
+#endif
+		default:
+			morphScalar(morphs, weights, vertices, first, last, write);
+		}
+	}
+
+	// Collects, without duplicates, the vertices of every morph the predicate selects.
+	// Each call stamps the vertices with a new epoch, so the marks never have to be cleared.
+	template<typename Predicate>
+	static const std::vector<std::uint32_t>&
+	collectMorphVertices(const MorphStreams& morphs, std::size_t numVertices, Predicate predicate) noexcept
+	{
+		static thread_local std::vector<std::uint32_t> vertices;
+		static thread_local std::vector<std::uint32_t> stamps;
+		static thread_local std::uint32_t epoch = 0;
+
+		vertices.clear();
+
+		if (stamps.size() < numVertices)
+			stamps.resize(numVertices, 0);
+
+		if (++epoch == 0)
+		{
+			std::fill(stamps.begin(), stamps.end(), 0);
+			epoch = 1;
+		}
+
+		for (std::size_t m = 0; m < morphs.getNumMorphs(); m++)
+		{
+			if (!predicate(m))
+				continue;
+
+			for (auto k = morphs.morphOffsets[m]; k < morphs.morphOffsets[m + 1]; k++)
+			{
+				auto i = morphs.morphVertices[k];
+				if (stamps[i] != epoch)
+				{
+					stamps[i] = epoch;
+					vertices.push_back(i);
+				}
+			}
+		}
+
+		return vertices;
+	}
+
+	template<typename Write>
+	static void
+	gatherMorphs(const MorphStreams& morphs, const float* weights, const std::vector<std::uint32_t>& vertices, SkinningKernel kernel, Write write) noexcept
+	{
+		auto numVertices = vertices.size();
+		auto numBlocks = static_cast<std::int32_t>((numVertices + SkinningBlockSize - 1) / SkinningBlockSize);
+
+		// Every vertex appears once and owns its row, the blocks never write to the same vertex.
+#		pragma omp parallel for schedule(static) if (numBlocks > 1)
+		for (std::int32_t i = 0; i < numBlocks; i++)
+		{
+			auto first = static_cast<std::size_t>(i) * SkinningBlockSize;
+			auto last = std::min(first + SkinningBlockSize, numVertices);
+			morphBlock(morphs, weights, vertices.data(), first, last, kernel, write);
+		}
+	}
+
+	SkinningKernel
+	detectSkinningKernel() noexcept
+	{
+		static const SkinningKernel kernel = []() noexcept
+		{
+#if defined(OCTOON_SKINNING_X86)
+			bool avx2 = false;
+#	if defined(_MSC_VER)
+			int info[4];
+			__cpuid(info, 0);
+			if (info[0] >= 7)
+			{
+				__cpuid(info, 1);
+				bool osxsave = (info[2] & (1 << 27)) != 0;
+				bool fma = (info[2] & (1 << 12)) != 0;
+				if (osxsave && fma && (_xgetbv(0) & 0x6) == 0x6)
+				{
+					__cpuidex(info, 7, 0);
+					avx2 = (info[1] & (1 << 5)) != 0;
+				}
+			}
+#	else
+			__builtin_cpu_init();
+			avx2 = __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+#	endif
+			if (avx2)
+				return SkinningKernel::AVX2;
+#endif
+#if defined(OCTOON_SKINNING_SSE)
+			return SkinningKernel::SSE;
+#else
+			return SkinningKernel::Scalar;
+#endif
+		}();
+
+		return kernel;
+	}
+
+	const char*
+	getSkinningKernelName(SkinningKernel kernel) noexcept
+	{
+		switch (kernel)
+		{
+		case SkinningKernel::Auto:
+			return getSkinningKernelName(detectSkinningKernel());
+		case SkinningKernel::SSE:
+			return "sse";
+		case SkinningKernel::AVX2:
+			return "avx2";
+		default:
+			return "scalar";
+		}
+	}
+
+	void
+	skinning(const math::float4x4* joints, const SkinningStreams& streams, math::float3* vertices, math::float3* normals, std::size_t first, std::size_t count, SkinningKernel kernel) noexcept
+	{
+		assert(streams.weights.size() == streams.getNumVertices());
+		assert(streams.normalX.size() == streams.getNumVertices());
+		assert(first + count <= streams.getNumVertices());
+
+		if (kernel == SkinningKernel::Auto)
+			kernel = detectSkinningKernel();
+
+		linearSkinning(joints, streams, ContiguousIndex(), vertices, normals, first, first + count, kernel);
+	}
+
+	void
+	skinning(const math::float4x4s& joints, const SkinningStreams& streams, math::float3s& vertices, math::float3s& normals, SkinningKernel kernel) noexcept
+	{
+		auto numVertices = streams.getNumVertices();
+		vertices.resize(numVertices);
+		normals.resize(numVertices);
+
+		if (kernel == SkinningKernel::Auto)
+			kernel = detectSkinningKernel();
+
+		if (streams.isLinearOnly())
+		{
+			auto numBlocks = static_cast<std::int32_t>((numVertices + SkinningBlockSize - 1) / SkinningBlockSize);
+
+#			pragma omp parallel for schedule(static) if (numBlocks > 1)
+			for (std::int32_t i = 0; i < numBlocks; i++)
+			{
+				auto first = static_cast<std::size_t>(i) * SkinningBlockSize;
+				auto last = std::min(first + SkinningBlockSize, numVertices);
+				linearSkinning(joints.data(), streams, ContiguousIndex(), vertices.data(), normals.data(), first, last, kernel);
+			}
+		}
+		else
+		{
+			static thread_local math::float4s dualQuaternions;
+			computeDualQuaternions(joints, dualQuaternions);
+
+			auto numLinear = streams.linearIndices.size();
+			auto numDualQuaternion = streams.dualQuaternionIndices.size();
+			auto numSpherical = streams.sphericalIndices.size();
+
+			auto numLinearBlocks = (numLinear + SkinningBlockSize - 1) / SkinningBlockSize;
+			auto numDualQuaternionBlocks = (numDualQuaternion + SkinningBlockSize - 1) / SkinningBlockSize;
+			auto numSphericalBlocks = (numSpherical + SkinningBlockSize - 1) / SkinningBlockSize;
+			auto numBlocks = static_cast<std::int32_t>(numLinearBlocks + numDualQuaternionBlocks + numSphericalBlocks);
+
+			auto table = dualQuaternions.data();
+			bool simd = kernel != SkinningKernel::Scalar;
+
+			// Every block holds vertices of a single mode, the mode branch is taken once per block.
+#			pragma omp parallel for schedule(static) if (numBlocks > 1)
+			for (std::int32_t i = 0; i < numBlocks; i++)
+			{
+				auto block = static_cast<std::size_t>(i);
+				if (block < numLinearBlocks)
+				{
+					auto first = block * SkinningBlockSize;
+					auto last = std::min(first + SkinningBlockSize, numLinear);
+					linearSkinning(joints.data(), streams, IndirectIndex{ streams.linearIndices.data() }, vertices.data(), normals.data(), first, last, kernel);
+				}
+				else if (block < numLinearBlocks + numDualQuaternionBlocks)
+				{
+					auto first = (block - numLinearBlocks) * SkinningBlockSize;
+					auto last = std::min(first + SkinningBlockSize, numDualQuaternion);
+#if defined(OCTOON_SKINNING_SSE)
+					if (simd)
+						dualQuaternionSSE(table, streams, vertices.data(), normals.data(), first, last);
+					else
+#endif
+						dualQuaternionScalar(table, streams, vertices.data(), normals.data(), first, last);
+				}
+				else
+				{
+					auto first = (block - numLinearBlocks - numDualQuaternionBlocks) * SkinningBlockSize;
+					auto last = std::min(first + SkinningBlockSize, numSpherical);
+#if defined(OCTOON_SKINNING_SSE)
+					if (simd)
+						sphericalSSE(joints.data(), table, streams, vertices.data(), normals.data(), first, last);
+					else
+#endif
+						sphericalScalar(joints.data(), table, streams, vertices.data(), normals.data(), first, last);
+				}
+			}
+		}
+	}
+
+	void
+	morphing(const MorphStreams& morphs, const math::float1s& weights, SkinningStreams& streams, SkinningKernel kernel) noexcept
+	{
+		assert(weights.size() >= morphs.getNumMorphs());
+		assert(morphs.rows.size() <= streams.getNumVertices() + 1);
+
+		if (morphs.empty())
+			return;
+
+		if (kernel == SkinningKernel::Auto)
+			kernel = detectSkinningKernel();
+
+		auto& vertices = collectMorphVertices(morphs, morphs.rows.size() - 1, [&](std::size_t m) { return weights[m] != 0.0f; });
+		if (vertices.empty())
+			return;
+
+		auto x = streams.positionX.data();
+		auto y = streams.positionY.data();
+		auto z = streams.positionZ.data();
+
+		gatherMorphs(morphs, weights.data(), vertices, kernel, [=](std::uint32_t i, float dx, float dy, float dz)
+		{
+			x[i] += dx;
+			y[i] += dy;
+			z[i] += dz;
+		});
+	}
+
+	void
+	morphing(const MorphStreams& morphs, const math::float1s& weights, const math::float1s& previous, const math::float3s& base, SkinningStreams& streams, SkinningKernel kernel) noexcept
+	{
+		assert(weights.size() >= morphs.getNumMorphs());
+		assert(morphs.rows.size() <= std::min(base.size(), streams.getNumVertices()) + 1);
+
+		if (morphs.empty())
+			return;
+
+		if (kernel == SkinningKernel::Auto)
+			kernel = detectSkinningKernel();
+
+		auto& vertices = collectMorphVertices(morphs, morphs.rows.size() - 1, [&](std::size_t m)
+		{
+			return weights[m] != (m < previous.size() ? previous[m] : 0.0f);
+		});
+
+		if (vertices.empty())
+			return;
+
+		auto x = streams.positionX.data();
+		auto y = streams.positionY.data();
+		auto z = streams.positionZ.data();
+		auto b = base.data();
+
+		gatherMorphs(morphs, weights.data(), vertices, kernel, [=](std::uint32_t i, float dx, float dy, float dz)
+		{
+			x[i] = b[i].x + dx;
+			y[i] = b[i].y + dy;
+			z[i] = b[i].z + dz;
+		});
+	}
+
+	void
+	skinning(const SkinningData& data, math::float3s& vertices, math::float3s& normals, SkinningKernel kernel) noexcept
+	{
+		if (data.morphs.empty())
+		{
+			skinning(data.joints, data.streams, vertices, normals, kernel);
+		}
+		else
+		{
+			static thread_local SkinningStreams streams;
+			streams = data.streams;
+
+			morphing(data.morphs, data.morphWeights, streams);
+			skinning(data.joints, streams, vertices, normals, kernel);
+		}
+	}
+}
@@ -8,5 +8,11 @@ namespace octoon
 		PhysicsListener::onFetchResult() noexcept
 		{
 		}
+
+		void
+		PhysicsListener::onFetchResult(const math::float3& position, const math::Quaternion& rotation) noexcept
+		{
+			this->onFetchResult();
+		}
 	}
 }
\ No newline at end of file
@@ -4,6 +4,8 @@
 
 #include <PxPhysicsAPI.h>
 
+#include <atomic>
+
 namespace octoon
 {
 	namespace physics
@@ -64,14 +66,54 @@ namespace octoon
 			}
 		};
 
+		// Runs on a dispatcher thread as soon as a step can be fetched, which tells apart the time the step took from
+		// the time it waited for fetchResults().
+		class SimulationCompletionTask : public physx::PxLightCpuTask
+		{
+		public:
+			SimulationCompletionTask() noexcept
+				: finish_(0)
+			{
+			}
+
+			void run() override
+			{
+				finish_.store(std::chrono::steady_clock::now().time_since_epoch().count(), std::memory_order_release);
+			}
+
+			const char* getName() const override
+			{
+				return "octoon.simulationCompletion";
+			}
+
+			void reset() noexcept
+			{
+				finish_.store(0, std::memory_order_relaxed);
+			}
+
+			std::chrono::steady_clock::time_point finish() const noexcept
+			{
+				return std::chrono::steady_clock::time_point(std::chrono::steady_clock::duration(finish_.load(std::memory_order_acquire)));
+			}
+
+		private:
+			std::atomic<std::chrono::steady_clock::rep> finish_;
+		};
+
 		PhysxScene::PhysxScene(PhysxContext* context, PhysicsSceneDesc desc)
 			: context(nullptr)
 			, px_scene(nullptr)
+			, dispatcher_(nullptr)
 			, simulationEventCallback_(std::make_unique<SimulationEventCallback>())
+			, simulationCompletionTask_(std::make_unique<SimulationCompletionTask>())
+			, simulating_(false)
+			, simulationTime_(0.0f)
 		{
+			dispatcher_ = physx::PxDefaultCpuDispatcherCreate(desc.threadCount);
+
 			physx::PxSceneDesc sceneDesc(context->getPxPhysics()->getTolerancesScale());
 			sceneDesc.gravity = physx::PxVec3(desc.gravity.x, desc.gravity.y, desc.gravity.z);
-			sceneDesc.cpuDispatcher = physx::PxDefaultCpuDispatcherCreate(4);
+			sceneDesc.cpuDispatcher = dispatcher_;
 			sceneDesc.filterShader = DefaultSimulationFilterShader;
 			sceneDesc.simulationEventCallback = simulationEventCallback_.get();
 			sceneDesc.ccdMaxPasses = 4;
@@ -90,8 +132,14 @@ namespace octoon
 
 		PhysxScene::~PhysxScene()
 		{
+			if (simulating_)
+				this->fetchResults();
+
 			px_scene->release();
 			px_scene = nullptr;
+
+			dispatcher_->release();
+			dispatcher_ = nullptr;
 		}
 
 		void
@@ -121,13 +169,31 @@ namespace octoon
 
 		void PhysxScene::simulate(float time)
 		{
-			px_scene->simulate(time);
+			simulationCompletionTask_->reset();
+			simulationCompletionTask_->setContinuation(*px_scene->getTaskManager(), nullptr);
+			simulationStart_ = std::chrono::steady_clock::now();
+
+			px_scene->simulate(time, simulationCompletionTask_.get());
+			simulationCompletionTask_->removeReference();
+
+			simulating_ = true;
 		}
 
 		void
 		PhysxScene::fetchResults()
 		{
 			px_scene->fetchResults(true);
+
+			if (simulating_)
+			{
+				// The completion task may still be queued behind the wakeup of this thread, its time is then close enough.
+				auto finish = simulationCompletionTask_->finish();
+				if (finish < simulationStart_)
+					finish = std::chrono::steady_clock::now();
+
+				simulationTime_ = std::chrono::duration<float>(finish - simulationStart_).count();
+				simulating_ = false;
+			}
 		}
 
 		void
@@ -142,5 +208,48 @@ namespace octoon
 					listener->onFetchResult();
 			}
 		}
+
+		void
+		PhysxScene::fetchActivePoses(std::vector<PhysicsActivePose>& poses)
+		{
+			physx::PxU32 nbActiveActors;
+			physx::PxActor** activeActors = px_scene->getActiveActors(nbActiveActors);
+
+			poses.clear();
+			poses.reserve(nbActiveActors);
+
+			for (physx::PxU32 i = 0; i < nbActiveActors; ++i)
+			{
+				auto listener = static_cast<PhysicsListener*>(activeActors[i]->userData);
+				auto actor = activeActors[i]->is<physx::PxRigidActor>();
+				if (listener && actor)
+				{
+					auto pose = actor->getGlobalPose();
+					poses.push_back({ listener, math::float3(pose.p.x, pose.p.y, pose.p.z), math::Quaternion(pose.q.x, pose.q.y, pose.q.z, pose.q.w) });
+				}
+			}
+		}
+
+		void
+		PhysxScene::setKinematicTargets(const PhysicsKinematicTarget* targets, std::size_t count)
+		{
+			for (std::size_t i = 0; i < count; ++i)
+			{
+				auto& target = targets[i];
+				if (target.rigidbody)
+				{
+					auto actor = static_cast<PhysxRigidbody*>(target.rigidbody)->getPxRigidbody();
+					actor->setGlobalPose(physx::PxTransform(
+						physx::PxVec3(target.position.x, target.position.y, target.position.z),
+						physx::PxQuat(target.rotation.x, target.rotation.y, target.rotation.z, target.rotation.w)));
+				}
+			}
+		}
+
+		float
+		PhysxScene::getSimulationTime() const noexcept
+		{
+			return simulationTime_;
+		}
 	}
 }
\ No newline at end of file
@@ -1,6 +1,7 @@
 #ifndef OCTOON_PHYSX_SCENE_H_
 #define OCTOON_PHYSX_SCENE_H_
 
+#include <chrono>
 #include <memory>
 #include <vector>
 
@@ -33,13 +34,24 @@ namespace octoon
 			virtual void fetchResults() override;
 			virtual void fetchFinish() override;
 
+			virtual void fetchActivePoses(std::vector<PhysicsActivePose>& poses) override;
+			virtual void setKinematicTargets(const PhysicsKinematicTarget* targets, std::size_t count) override;
+
+			virtual float getSimulationTime() const noexcept override;
+
 		private:
 			PhysxScene(const PhysxScene&) noexcept = delete;
 			PhysxScene& operator=(const PhysxScene&) noexcept = delete;
         private:
 			PhysxContext* context;
 			physx::PxScene* px_scene;
+			physx::PxDefaultCpuDispatcher* dispatcher_;
 			std::unique_ptr<class SimulationEventCallback> simulationEventCallback_;
+			std::unique_ptr<class SimulationCompletionTask> simulationCompletionTask_;
+
+			bool simulating_;
+			float simulationTime_;
+			std::chrono::steady_clock::time_point simulationStart_;
 			std::vector<std::shared_ptr<PhysxRigidbody>> rigidbody_;
 		};
 	}
@@ -0,0 +1,315 @@
+#include <octoon/runtime/job_system.h>
+
+#include <algorithm>
+#include <cassert>
+
+namespace octoon
+{
+	namespace runtime
+	{
+		OctoonImplementSingleton(JobSystem)
+
+		// Worker the current thread belongs to, threads outside of the pool carry no system.
+		struct JobThread
+		{
+			const JobSystem* system;
+			std::size_t index;
+		};
+
+		static thread_local JobThread currentThread = { nullptr, 0 };
+
+		JobGroup::JobGroup() noexcept
+			: pending_(0)
+		{
+		}
+
+		JobGroup::~JobGroup() noexcept
+		{
+			assert(this->done());
+		}
+
+		bool
+		JobGroup::done() const noexcept
+		{
+			return pending_.load(std::memory_order_acquire) == 0;
+		}
+
+		JobSystem::JobSystem() noexcept
+			: threadCount_(0)
+			, started_(false)
+			, next_(0)
+			, pending_(0)
+			, quit_(false)
+		{
+		}
+
+		JobSystem::~JobSystem() noexcept
+		{
+			this->stop();
+		}
+
+		void
+		JobSystem::setThreadCount(std::size_t count) noexcept
+		{
+			assert(pending_ == 0);
+
+			if (threadCount_ != count)
+			{
+				this->stop();
+				threadCount_ = count;
+			}
+		}
+
+		std::size_t
+		JobSystem::getThreadCount() const noexcept
+		{
+			if (threadCount_ > 0)
+				return threadCount_;
+
+			auto hardware = static_cast<std::size_t>(std::thread::hardware_concurrency());
+			return hardware > 1 ? hardware - 1 : 0;
+		}
+
+		void
+		JobSystem::submit(JobGroup& group, Job&& job) noexcept
+		{
+			if (!started_.load(std::memory_order_acquire))
+				this->start();
+
+			group.pending_.fetch_add(1, std::memory_order_relaxed);
+
+			Task task{ std::move(job), &group };
+
+			if (workers_.empty())
+			{
+				this->execute(task);
+				return;
+			}
+
+			// Jobs spawned by a worker stay on its own deque, where it picks them up first while they are still hot.
+			auto index = currentThread.system == this ? currentThread.index : next_.fetch_add(1, std::memory_order_relaxed) % workers_.size();
+
+			{
+				std::lock_guard<std::mutex> guard(workers_[index]->lock);
+				workers_[index]->tasks.push_back(std::move(task));
+				pending_.fetch_add(1, std::memory_order_release);
+			}
+
+			{
+				std::lock_guard<std::mutex> guard(sleepLock_);
+			}
+
+			wake_.notify_one();
+		}
+
+		void
+		JobSystem::wait(JobGroup& group) noexcept(false)
+		{
+			auto index = currentThread.system == this ? currentThread.index : workers_.size();
+
+			while (!group.done())
+			{
+				Task task;
+				if (this->pop(index, task) || this->steal(index, task))
+					this->execute(task);
+				else
+					std::this_thread::yield();
+			}
+
+			std::exception_ptr exception;
+
+			{
+				std::lock_guard<std::mutex> guard(group.lock_);
+				std::swap(exception, group.exception_);
+			}
+
+			if (exception)
+				std::rethrow_exception(exception);
+		}
+
+		void
+		JobSystem::parallelFor(std::size_t count, std::size_t grain, const RangeJob& job) noexcept(false)
+		{
+			if (count == 0)
+				return;
+
+			if (!started_.load(std::memory_order_acquire))
+				this->start();
+
+			// A few ranges per thread leave room for stealing when the elements differ in cost.
+			auto threads = workers_.size() + 1;
+			auto size = std::max(std::max<std::size_t>(grain, 1), (count + threads * 4 - 1) / (threads * 4));
+			if (size >= count || workers_.empty())
+			{
+				job(0, count);
+				return;
+			}
+
+			JobGroup group;
+
+			for (std::size_t begin = size; begin < count; begin += size)
+			{
+				auto end = std::min(begin + size, count);
+				this->submit(group, [&job, begin, end]() { job(begin, end); });
+			}
+
+			std::exception_ptr exception;
+
+			try
+			{
+				job(0, size);
+			}
+			catch (...)
+			{
+				exception = std::current_exception();
+			}
+
+			// The other ranges still reference the job, they have to finish before anything is rethrown.
+			try
+			{
+				this->wait(group);
+			}
+			catch (...)
+			{
+				if (!exception)
+					exception = std::current_exception();
+			}
+
+			if (exception)
+				std::rethrow_exception(exception);
+		}
+
+		void
+		JobSystem::start() noexcept
+		{
+			std::lock_guard<std::mutex> guard(startLock_);
+
+			if (started_.load(std::memory_order_relaxed))
+				return;
+
+			auto count = this->getThreadCount();
+
+			quit_ = false;
+			workers_.clear();
+
+			for (std::size_t i = 0; i < count; i++)
+				workers_.push_back(std::make_unique<Worker>());
+
+			for (std::size_t i = 0; i < count; i++)
+				workers_[i]->thread = std::thread(&JobSystem::run, this, i);
+
+			started_.store(true, std::memory_order_release);
+		}
+
+		void
+		JobSystem::stop() noexcept
+		{
+			std::lock_guard<std::mutex> guard(startLock_);
+
+			if (!started_.load(std::memory_order_relaxed))
+				return;
+
+			{
+				std::lock_guard<std::mutex> sleepGuard(sleepLock_);
+				quit_ = true;
+			}
+
+			wake_.notify_all();
+
+			for (auto& it : workers_)
+			{
+				if (it->thread.joinable())
+					it->thread.join();
+			}
+
+			workers_.clear();
+			started_.store(false, std::memory_order_release);
+		}
+
+		void
+		JobSystem::run(std::size_t index) noexcept
+		{
+			currentThread.system = this;
+			currentThread.index = index;
+
+			for (;;)
+			{
+				Task task;
+				if (this->pop(index, task) || this->steal(index, task))
+				{
+					this->execute(task);
+					continue;
+				}
+
+				std::unique_lock<std::mutex> lock(sleepLock_);
+				wake_.wait(lock, [this]() { return quit_ || pending_.load(std::memory_order_acquire) > 0; });
+
+				if (quit_ && pending_.load(std::memory_order_acquire) == 0)
+					break;
+			}
+
+			currentThread.system = nullptr;
+		}
+
+		void
+		JobSystem::execute(Task& task) noexcept
+		{
+			try
+			{
+				task.job();
+			}
+			catch (...)
+			{
+				std::lock_guard<std::mutex> guard(task.group->lock_);
+				if (!task.group->exception_)
+					task.group->exception_ = std::current_exception();
+			}
+
+			task.group->pending_.fetch_sub(1, std::memory_order_acq_rel);
+		}
+
+		bool
+		JobSystem::pop(std::size_t index, Task& task) noexcept
+		{
+			if (index >= workers_.size())
+				return false;
+
+			auto& worker = *workers_[index];
+
+			std::lock_guard<std::mutex> guard(worker.lock);
+			if (worker.tasks.empty())
+				return false;
+
+			task = std::move(worker.tasks.back());
+			worker.tasks.pop_back();
+			pending_.fetch_sub(1, std::memory_order_relaxed);
+
+			return true;
+		}
+
+		bool
+		JobSystem::steal(std::size_t index, Task& task) noexcept
+		{
+			auto count = workers_.size();
+
+			for (std::size_t i = 1; i <= count; i++)
+			{
+				auto& worker = *workers_[(index + i) % count];
+				if (&worker == (index < count ? workers_[index].get() : nullptr))
+					continue;
+
+				std::lock_guard<std::mutex> guard(worker.lock);
+				if (worker.tasks.empty())
+					continue;
+
+				task = std::move(worker.tasks.front());
+				worker.tasks.pop_front();
+				pending_.fetch_sub(1, std::memory_order_relaxed);
+
+				return true;
+			}
+
+			return false;
+		}
+	}
+}
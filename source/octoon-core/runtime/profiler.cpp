@@ -0,0 +1,220 @@
+#include <octoon/runtime/profiler.h>
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+
+namespace octoon
+{
+	namespace runtime
+	{
+		OctoonImplementSingleton(Profiler)
+
+		Profiler::Profiler() noexcept
+			: enable_(false)
+			, capture_(false)
+			, frameBegin_(0)
+			, frameEnd_(0)
+			, captureBegin_(0)
+		{
+		}
+
+		Profiler::~Profiler() noexcept
+		{
+		}
+
+		void
+		Profiler::setEnable(bool enable) noexcept
+		{
+			if (enable && !enable_.load(std::memory_order_relaxed))
+			{
+				// Anything left from an earlier run would show up in the next frame.
+				std::lock_guard<std::mutex> guard(lock_);
+				for (auto& it : buffers_)
+					it->tail = it->head.load(std::memory_order_acquire);
+			}
+
+			enable_.store(enable, std::memory_order_relaxed);
+		}
+
+		bool
+		Profiler::getEnable() const noexcept
+		{
+			return enable_.load(std::memory_order_relaxed);
+		}
+
+		void
+		Profiler::beginFrame() noexcept
+		{
+			if (enable_.load(std::memory_order_relaxed))
+				frameBegin_ = now();
+		}
+
+		void
+		Profiler::endFrame() noexcept
+		{
+			if (!enable_.load(std::memory_order_relaxed))
+				return;
+
+			frameEnd_ = now();
+			frameEvents_.clear();
+
+			{
+				std::lock_guard<std::mutex> guard(lock_);
+
+				for (auto& it : buffers_)
+				{
+					// A thread that wrote more than a whole ring since the last frame lost its oldest events.
+					auto head = it->head.load(std::memory_order_acquire);
+					auto tail = std::max(it->tail, head > BufferSize ? head - BufferSize : 0);
+					auto first = frameEvents_.size();
+
+					for (auto i = tail; i < head; i++)
+						frameEvents_.push_back(it->events[i % BufferSize]);
+
+					// The thread keeps writing while we copy. Once its head passed an event we read plus a whole ring, the
+					// slot may have been rewritten under the copy, so those events are dropped rather than reported torn.
+					std::atomic_thread_fence(std::memory_order_acquire);
+					auto after = it->head.load(std::memory_order_relaxed);
+					auto safe = after >= BufferSize ? after - BufferSize + 1 : 0;
+					if (safe > tail)
+					{
+						auto lost = std::min(safe, head) - tail;
+						frameEvents_.erase(frameEvents_.begin() + first, frameEvents_.begin() + first + lost);
+					}
+
+					it->tail = head;
+				}
+			}
+
+			if (capture_)
+				captureEvents_.insert(captureEvents_.end(), frameEvents_.begin(), frameEvents_.end());
+		}
+
+		const std::vector<ProfileEvent>&
+		Profiler::getFrameEvents() const noexcept
+		{
+			return frameEvents_;
+		}
+
+		double
+		Profiler::getFrameTime() const noexcept
+		{
+			return frameEnd_ > frameBegin_ ? (frameEnd_ - frameBegin_) / 1e6 : 0.0;
+		}
+
+		void
+		Profiler::setCapture(bool enable) noexcept
+		{
+			if (enable && !capture_)
+			{
+				captureEvents_.clear();
+				captureBegin_ = now();
+			}
+
+			capture_ = enable;
+		}
+
+		bool
+		Profiler::getCapture() const noexcept
+		{
+			return capture_;
+		}
+
+		bool
+		Profiler::saveTrace(std::string_view path) const noexcept
+		{
+			std::ofstream stream(std::string(path), std::ios_base::out | std::ios_base::trunc);
+			if (!stream)
+				return false;
+
+			// Fixed microseconds with nanosecond digits, the default precision would round long captures to whole milliseconds.
+			stream << std::fixed << std::setprecision(3);
+			stream << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+
+			bool first = true;
+
+			for (auto& it : captureEvents_)
+			{
+				if (!first)
+					stream << ",";
+
+				stream << "\n{\"name\":\"";
+
+				for (auto c = it.name; *c; c++)
+				{
+					if (*c == '"' || *c == '\\')
+						stream << '\\';
+					stream << *c;
+				}
+
+				// Chrome expects microseconds, relative to the start of the capture.
+				auto begin = it.begin > captureBegin_ ? it.begin - captureBegin_ : 0;
+				stream << "\",\"ph\":\"X\",\"pid\":1,\"tid\":" << it.thread << ",\"ts\":" << begin / 1e3 << ",\"dur\":" << (it.end - it.begin) / 1e3 << "}";
+
+				first = false;
+			}
+
+			stream << "\n]}\n";
+
+			return stream.good();
+		}
+
+		std::uint64_t
+		Profiler::now() noexcept
+		{
+			return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count());
+		}
+
+		Profiler::Buffer*
+		Profiler::getThreadBuffer() noexcept
+		{
+			static thread_local Buffer* buffer = nullptr;
+
+			if (!buffer)
+			{
+				// The profiler owns the buffers, so events of threads that have already exited can still be collected.
+				auto instance = std::make_unique<Buffer>();
+				instance->events = std::make_unique<ProfileEvent[]>(BufferSize);
+				instance->head = 0;
+				instance->tail = 0;
+				instance->depth = 0;
+
+				std::lock_guard<std::mutex> guard(lock_);
+				instance->thread = static_cast<std::uint32_t>(buffers_.size());
+				buffer = instance.get();
+				buffers_.push_back(std::move(instance));
+			}
+
+			return buffer;
+		}
+
+		ProfileZone::ProfileZone(const char* name) noexcept
+			: name_(nullptr)
+			, begin_(0)
+		{
+			auto profiler = Profiler::instance();
+			if (profiler->enable_.load(std::memory_order_relaxed))
+			{
+				profiler->getThreadBuffer()->depth++;
+				name_ = name;
+				begin_ = Profiler::now();
+			}
+		}
+
+		ProfileZone::~ProfileZone() noexcept
+		{
+			if (name_)
+			{
+				auto end = Profiler::now();
+				auto buffer = Profiler::instance()->getThreadBuffer();
+				buffer->depth--;
+
+				auto head = buffer->head.load(std::memory_order_relaxed);
+				buffer->events[head % Profiler::BufferSize] = ProfileEvent{ name_, begin_, end, buffer->thread, buffer->depth };
+				buffer->head.store(head + 1, std::memory_order_release);
+			}
+		}
+	}
+}
@@ -4,7 +4,11 @@
 #include <imgui_dock.h>
 #include <imgui_user.h>
 
+#include <octoon/runtime/profiler.h>
+
+#include <algorithm>
 #include <cstring> // std::memcpy
+#include <vector>
 
 namespace octoon::imgui
 {
@@ -148,6 +152,85 @@ namespace octoon::imgui
 			ImGui::ShowMetricsWindow(isOpened);
 	}
 
+	void showProfilerWindow(bool* isOpened) noexcept
+	{
+		struct ZoneStats
+		{
+			const char* name;
+			std::uint32_t thread;
+			std::uint32_t depth;
+			std::uint32_t count;
+			std::uint64_t time;
+		};
+
+		static std::vector<runtime::ProfileEvent> events;
+		static std::vector<ZoneStats> zones;
+
+		auto profiler = runtime::Profiler::instance();
+
+		if (!ImGui::Begin("Profiler", isOpened, ImGuiWindowFlags_AlwaysAutoResize))
+		{
+			ImGui::End();
+			return;
+		}
+
+		bool enable = profiler->getEnable();
+		if (ImGui::Checkbox("Enable", &enable))
+			profiler->setEnable(enable);
+
+		ImGui::SameLine();
+
+		bool capture = profiler->getCapture();
+		if (ImGui::Checkbox("Capture", &capture))
+			profiler->setCapture(capture);
+
+		ImGui::SameLine();
+
+		if (ImGui::Button("Save trace.json"))
+			profiler->saveTrace("trace.json");
+
+		ImGui::Text("Frame %.3f ms", profiler->getFrameTime());
+		ImGui::Separator();
+
+		// Zones of the same name, thread and depth are summed up and listed in the order they were entered.
+		events = profiler->getFrameEvents();
+		std::sort(events.begin(), events.end(), [](auto& a, auto& b) { return a.thread != b.thread ? a.thread < b.thread : a.begin < b.begin; });
+
+		zones.clear();
+
+		for (auto& it : events)
+		{
+			auto zone = std::find_if(zones.begin(), zones.end(), [&](auto& z) { return z.name == it.name && z.thread == it.thread && z.depth == it.depth; });
+			if (zone != zones.end())
+			{
+				zone->count++;
+				zone->time += it.end - it.begin;
+			}
+			else
+			{
+				zones.push_back(ZoneStats{ it.name, it.thread, it.depth, 1, it.end - it.begin });
+			}
+		}
+
+		ImGui::Columns(4, "profiler", false);
+		ImGui::Text("Zone"); ImGui::NextColumn();
+		ImGui::Text("Thread"); ImGui::NextColumn();
+		ImGui::Text("Calls"); ImGui::NextColumn();
+		ImGui::Text("ms"); ImGui::NextColumn();
+		ImGui::Separator();
+
+		for (auto& it : zones)
+		{
+			ImGui::Text("%*s%s", it.depth * 2, "", it.name); ImGui::NextColumn();
+			ImGui::Text("%u", it.thread); ImGui::NextColumn();
+			ImGui::Text("%u", it.count); ImGui::NextColumn();
+			ImGui::Text("%.3f", it.time / 1e6); ImGui::NextColumn();
+		}
+
+		ImGui::Columns(1);
+		ImGui::End();
+	}
+
 	bool begin(const char* name, bool* isOpened, GuiWindowFlags flags) noexcept
 	{
 		if (!ImGui::Begin(name, isOpened, flags))
@@ -1,13 +1,26 @@
 #include <octoon/video/forward_buffer.h>
 #include <octoon/video/renderer.h>
+#include <octoon/runtime/except.h>
 
 namespace octoon::video
 {
+	// Number of frames the GPU may still be reading from while the CPU writes the next one.
+	constexpr std::uint32_t DynamicBufferFrames = 3;
+
+	constexpr std::size_t VertexStreamStride = 6;
+	constexpr std::size_t TexcoordStreamStride = 4;
+
 	ForwardBuffer::ForwardBuffer() noexcept
+		: dynamic_(false)
+		, numVertices_(0)
+		, revision_(0)
+		, frame_(0)
+		, vertexOffset_(0)
 	{
 	}
 
 	ForwardBuffer::ForwardBuffer(const std::shared_ptr<mesh::Mesh>& mesh) noexcept(false)
+		: ForwardBuffer()
 	{
 		this->setMesh(mesh);
 	}
@@ -32,18 +45,50 @@ namespace octoon::video
 		return this->mesh_;
 	}
 
+	void
+	ForwardBuffer::update() noexcept(false)
+	{
+		if (this->mesh_ && this->mesh_->getVertexRevision() != this->revision_)
+		{
+			if (this->mesh_->getNumVertices() != this->numVertices_)
+				this->updateData(this->mesh_);
+			else if (this->numVertices_ > 0)
+				this->updateVertexData(*this->mesh_);
+			else
+				this->revision_ = this->mesh_->getVertexRevision();
+		}
+	}
+
+	bool
+	ForwardBuffer::isDynamic() const noexcept
+	{
+		return this->dynamic_;
+	}
+
 	const hal::GraphicsDataPtr&
 	ForwardBuffer::getVertexBuffer() const noexcept
 	{
 		return vertices_;
 	}
 
+	const hal::GraphicsDataPtr&
+	ForwardBuffer::getTexcoordBuffer() const noexcept
+	{
+		return texcoords_;
+	}
+
 	const hal::GraphicsDataPtr&
 	ForwardBuffer::getIndexBuffer(std::size_t n) const noexcept
 	{
 		return indices_[n];
 	}
 
+	std::intptr_t
+	ForwardBuffer::getVertexOffset() const noexcept
+	{
+		return vertexOffset_;
+	}
+
 	std::size_t
 	ForwardBuffer::getNumVertices() const noexcept
 	{
@@ -57,84 +102,136 @@ namespace octoon::video
 	}
 
 	void
-	ForwardBuffer::updateData(const std::shared_ptr<mesh::Mesh>& mesh) noexcept(false)
+	ForwardBuffer::writeVertexStream(const mesh::Mesh& mesh, float* data) noexcept
 	{
-		if (mesh)
+		auto& vertices = mesh.getVertexArray();
+		auto& normals = mesh.getNormalArray();
+
+		auto v = data;
+		for (auto& it : vertices)
 		{
-			auto& vertices = mesh->getVertexArray();
-			auto& texcoord = mesh->getTexcoordArray();
-			auto& texcoord1 = mesh->getTexcoordArray(1);
-			auto& normals = mesh->getNormalArray();
+			v[0] = it.x;
+			v[1] = it.y;
+			v[2] = it.z;
+			v += VertexStreamStride;
+		}
 
-			hal::GraphicsInputLayoutDesc inputLayout;
-			inputLayout.addVertexLayout(hal::GraphicsVertexLayout(0, "POSITION", 0, hal::GraphicsFormat::R32G32B32SFloat));
-			inputLayout.addVertexLayout(hal::GraphicsVertexLayout(0, "NORMAL", 0, hal::GraphicsFormat::R32G32B32SFloat));
-			inputLayout.addVertexLayout(hal::GraphicsVertexLayout(0, "TEXCOORD", 0, hal::GraphicsFormat::R32G32SFloat));
-			inputLayout.addVertexLayout(hal::GraphicsVertexLayout(0, "TEXCOORD", 1, hal::GraphicsFormat::R32G32SFloat));
+		auto n = data + 3;
+		for (std::size_t i = 0; i < vertices.size(); i++)
+		{
+			if (i < normals.size())
+			{
+				n[0] = normals[i].x;
+				n[1] = normals[i].y;
+				n[2] = normals[i].z;
+			}
+			else
+			{
+				n[0] = n[1] = n[2] = 0.0f;
+			}
 
-			inputLayout.addVertexBinding(hal::GraphicsVertexBinding(0, inputLayout.getVertexSize()));
+			n += VertexStreamStride;
+		}
+	}
 
-			auto vertexSize = inputLayout.getVertexSize() / sizeof(float);
+	void
+	ForwardBuffer::writeTexcoordStream(const mesh::Mesh& mesh, float* data) noexcept
+	{
+		auto& texcoord = mesh.getTexcoordArray();
+		auto& texcoord1 = mesh.getTexcoordArray(1);
 
-			std::uint32_t offset = 0;
-			std::vector<float> data(vertices.size() * vertexSize);
+		auto t = data;
+		for (auto& it : texcoord)
+		{
+			t[0] = it.x;
+			t[1] = it.y;
+			t += TexcoordStreamStride;
+		}
 
-			for (auto& layout : inputLayout.getVertexLayouts())
-			{
-				if (layout.getSemantic() == "POSITION")
-				{
-					auto v = data.data() + offset;
-					for (auto& it : vertices)
-					{
-						v[0] = it.x;
-						v[1] = it.y;
-						v[2] = it.z;
-						v += vertexSize;
-					}
-				}
-				else if (layout.getSemantic() == "TEXCOORD" && layout.getSemanticIndex() == 0)
-				{
-					auto t = data.data() + offset;
-					for (auto& it : texcoord)
-					{
-						t[0] = it.x;
-						t[1] = it.y;
-						t += vertexSize;
-					}
-				}
-				else if (layout.getSemantic() == "TEXCOORD" && layout.getSemanticIndex() == 1)
-				{
-					auto t = data.data() + offset;
-					for (auto& it : texcoord1)
-					{
-						t[0] = it.x;
-						t[1] = it.y;
-						t += vertexSize;
-					}
-				}
-				else if (layout.getSemantic() == "NORMAL")
-				{
-					auto n = data.data() + offset;
-					for (auto& it : normals)
-					{
-						n[0] = it.x;
-						n[1] = it.y;
-						n[2] = it.z;
-						n += vertexSize;
-					}
-				}
+		t = data + 2;
+		for (auto& it : texcoord1)
+		{
+			t[0] = it.x;
+			t[1] = it.y;
+			t += TexcoordStreamStride;
+		}
+	}
 
-				offset += layout.getVertexCount();
-			}
+	void
+	ForwardBuffer::updateVertexData(const mesh::Mesh& mesh) noexcept(false)
+	{
+		auto streamSize = static_cast<std::intptr_t>(numVertices_ * VertexStreamStride * sizeof(float));
 
+		if (!this->dynamic_)
+		{
 			hal::GraphicsDataDesc dataDesc;
 			dataDesc.setType(hal::GraphicsDataType::StorageVertexBuffer);
-			dataDesc.setStream((std::uint8_t*)data.data());
-			dataDesc.setStreamSize(data.size() * sizeof(float));
+			dataDesc.setStream(nullptr);
+			dataDesc.setStreamSize(streamSize * DynamicBufferFrames);
+			dataDesc.setUsage(hal::GraphicsUsageFlagBits::WriteBit | hal::GraphicsUsageFlagBits::PersistentBit | hal::GraphicsUsageFlagBits::FlushExplicitBit | hal::GraphicsUsageFlagBits::UnsynchronizedBit);
+
+			auto vertices = video::Renderer::instance()->createGraphicsData(dataDesc);
+			if (!vertices)
+				throw runtime::runtime_error::create("createGraphicsData() failed");
+
+			this->vertices_ = std::move(vertices);
+			this->dynamic_ = true;
+			this->frame_ = 0;
+		}
+		else
+		{
+			this->frame_ = (this->frame_ + 1) % DynamicBufferFrames;
+		}
+
+		auto offset = streamSize * this->frame_;
+
+		void* data = nullptr;
+		if (this->vertices_->map(offset, streamSize, &data))
+		{
+			writeVertexStream(mesh, static_cast<float*>(data));
+			this->vertices_->flush(0, streamSize);
+			this->vertices_->unmap();
+		}
+
+		this->vertexOffset_ = offset;
+		this->revision_ = mesh.getVertexRevision();
+	}
+
+	void
+	ForwardBuffer::updateData(const std::shared_ptr<mesh::Mesh>& mesh) noexcept(false)
+	{
+		this->dynamic_ = false;
+		this->frame_ = 0;
+		this->vertexOffset_ = 0;
+		this->indices_.clear();
+
+		if (mesh)
+		{
+			this->numVertices_ = static_cast<std::uint32_t>(mesh->getNumVertices());
+			this->revision_ = mesh->getVertexRevision();
+
+			std::vector<float> vertices(numVertices_ * VertexStreamStride);
+			writeVertexStream(*mesh, vertices.data());
+
+			hal::GraphicsDataDesc dataDesc;
+			dataDesc.setType(hal::GraphicsDataType::StorageVertexBuffer);
+			dataDesc.setStream((std::uint8_t*)vertices.data());
+			dataDesc.setStreamSize(vertices.size() * sizeof(float));
 			dataDesc.setUsage(hal::GraphicsUsageFlagBits::ReadBit);
 
 			this->vertices_ = video::Renderer::instance()->createGraphicsData(dataDesc);
 
+			std::vector<float> texcoords(numVertices_ * TexcoordStreamStride);
+			writeTexcoordStream(*mesh, texcoords.data());
+
+			hal::GraphicsDataDesc texcoordDesc;
+			texcoordDesc.setType(hal::GraphicsDataType::StorageVertexBuffer);
+			texcoordDesc.setStream((std::uint8_t*)texcoords.data());
+			texcoordDesc.setStreamSize(texcoords.size() * sizeof(float));
+			texcoordDesc.setUsage(hal::GraphicsUsageFlagBits::ReadBit);
+
+			this->texcoords_ = video::Renderer::instance()->createGraphicsData(texcoordDesc);
+
 			for (std::size_t i = 0; i < mesh->getNumSubsets(); i++)
 			{
 				auto& indices = mesh->getIndicesArray(i);
@@ -156,8 +253,11 @@ namespace octoon::video
 		}
 		else
 		{
+			this->numVertices_ = 0;
+			this->revision_ = 0;
 			this->vertices_.reset();
+			this->texcoords_.reset();
 			this->indices_.shrink_to_fit();
 		}
 	}
-}
\ No newline at end of file
+}
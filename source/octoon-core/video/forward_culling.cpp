@@ -0,0 +1,161 @@
+#include <octoon/video/forward_culling.h>
+#include <octoon/runtime/job_system.h>
+#include <octoon/runtime/profiler.h>
+
+#include <algorithm>
+#include <cmath>
+
+namespace octoon::video
+{
+	constexpr std::size_t BatchSize = 4;
+	constexpr std::size_t ParallelThreshold = 1024;
+	constexpr std::size_t ParallelGrain = 256;
+
+	ForwardCulling::ForwardCulling() noexcept
+		: statistics_{}
+	{
+	}
+
+	ForwardCulling::~ForwardCulling() noexcept
+	{
+	}
+
+	void
+	ForwardCulling::cull(const camera::Camera& camera, const std::vector<geometry::Geometry*>& geometries, std::vector<geometry::Geometry*>& visible) noexcept
+	{
+		OCTOON_PROFILE_ZONE("ForwardCulling::cull");
+
+		visible.clear();
+		candidates_.clear();
+
+		for (auto& geometry : geometries)
+		{
+			if (camera.getLayer() != geometry->getLayer())
+				continue;
+
+			if (geometry->getVisible() && geometry->getMesh())
+				candidates_.push_back(geometry);
+		}
+
+		this->extractPlanes(camera.getViewProjection());
+
+		results_.resize(candidates_.size());
+
+		if (candidates_.size() > ParallelThreshold)
+		{
+			runtime::JobSystem::instance()->parallelFor(candidates_.size(), ParallelGrain, [this](std::size_t begin, std::size_t end)
+			{
+				this->testRange(begin, end);
+			});
+		}
+		else
+		{
+			this->testRange(0, candidates_.size());
+		}
+
+		visible.reserve(candidates_.size());
+
+		for (std::size_t i = 0; i < candidates_.size(); i++)
+		{
+			if (results_[i])
+			{
+				visible.push_back(candidates_[i]);
+			}
+			else
+			{
+				statistics_.culled++;
+				statistics_.skippedDraws += candidates_[i]->getMaterials().size();
+			}
+		}
+
+		statistics_.tested += candidates_.size();
+	}
+
+	const CullingStatistics&
+	ForwardCulling::getStatistics() const noexcept
+	{
+		return statistics_;
+	}
+
+	void
+	ForwardCulling::extractPlanes(const math::float4x4& m) noexcept
+	{
+		// Rows of the clip space x, y, z and w, a point is inside when -w <= x, y, z <= w.
+		Plane x{ m.a1, m.b1, m.c1, m.d1 };
+		Plane y{ m.a2, m.b2, m.c2, m.d2 };
+		Plane z{ m.a3, m.b3, m.c3, m.d3 };
+		Plane w{ m.a4, m.b4, m.c4, m.d4 };
+
+		planes_[0] = Plane{ w.x + x.x, w.y + x.y, w.z + x.z, w.w + x.w };
+		planes_[1] = Plane{ w.x - x.x, w.y - x.y, w.z - x.z, w.w - x.w };
+		planes_[2] = Plane{ w.x + y.x, w.y + y.y, w.z + y.z, w.w + y.w };
+		planes_[3] = Plane{ w.x - y.x, w.y - y.y, w.z - y.z, w.w - y.w };
+		planes_[4] = Plane{ w.x + z.x, w.y + z.y, w.z + z.z, w.w + z.w };
+		planes_[5] = Plane{ w.x - z.x, w.y - z.y, w.z - z.z, w.w - z.w };
+	}
+
+	void
+	ForwardCulling::testRange(std::size_t begin, std::size_t end) noexcept
+	{
+		for (std::size_t i = begin; i < end; i += BatchSize)
+		{
+			auto count = std::min(BatchSize, end - i);
+
+			// Lanes are laid out side by side so the plane loops below compile to one vector operation per line.
+			float cx[BatchSize], cy[BatchSize], cz[BatchSize];
+			float ex[BatchSize], ey[BatchSize], ez[BatchSize];
+			std::uint8_t inside[BatchSize];
+			std::uint8_t always[BatchSize];
+
+			for (std::size_t k = 0; k < BatchSize; k++)
+			{
+				cx[k] = cy[k] = cz[k] = 0.0f;
+				ex[k] = ey[k] = ez[k] = 0.0f;
+				inside[k] = 1;
+				always[k] = 0;
+
+				if (k >= count)
+					continue;
+
+				auto geometry = candidates_[i + k];
+				auto& box = geometry->getMesh()->getBoundingBoxAll().box();
+
+				if (geometry->getSkinningData() || box.empty())
+				{
+					always[k] = 1;
+					continue;
+				}
+
+				auto& m = geometry->getTransform();
+				auto center = box.center();
+				auto extents = box.extents();
+
+				cx[k] = m.a1 * center.x + m.b1 * center.y + m.c1 * center.z + m.d1;
+				cy[k] = m.a2 * center.x + m.b2 * center.y + m.c2 * center.z + m.d2;
+				cz[k] = m.a3 * center.x + m.b3 * center.y + m.c3 * center.z + m.d3;
+
+				ex[k] = std::abs(m.a1) * extents.x + std::abs(m.b1) * extents.y + std::abs(m.c1) * extents.z;
+				ey[k] = std::abs(m.a2) * extents.x + std::abs(m.b2) * extents.y + std::abs(m.c2) * extents.z;
+				ez[k] = std::abs(m.a3) * extents.x + std::abs(m.b3) * extents.y + std::abs(m.c3) * extents.z;
+			}
+
+			// A box is outside once its corner furthest along the normal of one plane is still behind it.
+			for (auto& plane : planes_)
+			{
+				auto nx = std::abs(plane.x);
+				auto ny = std::abs(plane.y);
+				auto nz = std::abs(plane.z);
+
+				for (std::size_t k = 0; k < BatchSize; k++)
+				{
+					auto distance = plane.x * cx[k] + plane.y * cy[k] + plane.z * cz[k] + plane.w;
+					auto radius = nx * ex[k] + ny * ey[k] + nz * ez[k];
+					inside[k] &= (distance + radius >= 0.0f) ? 1 : 0;
+				}
+			}
+
+			for (std::size_t k = 0; k < count; k++)
+				results_[i + k] = inside[k] | always[k];
+		}
+	}
+}
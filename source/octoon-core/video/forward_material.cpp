@@ -1841,10 +1841,18 @@ static std::unordered_map<std::string, std::string_view> ShaderChunk = {
 namespace octoon::video
 {
 	ForwardMaterial::ForwardMaterial() noexcept
+		: instancing_(false)
+		, pass_(0)
+		, revision_(0)
+		, geometry_(nullptr)
 	{
 	}
 
-	ForwardMaterial::ForwardMaterial(const material::MaterialPtr& material, const ForwardScene& context) noexcept
+	ForwardMaterial::ForwardMaterial(const material::MaterialPtr& material, const ForwardScene& context, bool instancing) noexcept
+		: instancing_(instancing)
+		, pass_(0)
+		, revision_(0)
+		, geometry_(nullptr)
 	{
 		this->setMaterial(material, context);
 	}
@@ -1863,6 +1871,7 @@ namespace octoon::video
 		envMap_.reset();
 		envMapIntensity_.reset();
 
+		camera_.reset();
 		viewMatrix_.reset();
 		normalMatrix_.reset();
 		modelMatrix_.reset();
@@ -1881,6 +1890,8 @@ namespace octoon::video
 		if (this->material_ != material)
 		{
 			this->material_ = material;
+			this->pass_ = 0;
+			this->geometry_ = nullptr;
 			this->updateMaterial(this->material_, context);
 		}
 	}
@@ -1891,6 +1902,12 @@ namespace octoon::video
 		return this->material_;
 	}
 
+	bool
+	ForwardMaterial::getInstancing() const noexcept
+	{
+		return this->instancing_;
+	}
+
 	const hal::GraphicsPipelinePtr&
 	ForwardMaterial::getPipeline() const noexcept
 	{
@@ -1903,71 +1920,103 @@ namespace octoon::video
 		return descriptorSet_;
 	}
 
-	void
-	ForwardMaterial::update(const camera::Camera& camera, const geometry::Geometry& geometry, const ForwardScene& context) noexcept
+	bool
+	ForwardMaterial::update(const camera::Camera& camera, const geometry::Geometry& geometry, const ForwardScene& context, std::uint64_t pass, const hal::GraphicsDataPtr& cameraBuffer) noexcept
 	{
-		if (this->material_)
+		if (!this->material_)
+			return false;
+
+		// Each ForwardMaterial of a material, such as the instancing one of the pipeline and the plain one of the Renderer's
+		// shadow path, compares the revision it uploaded, so a variant not drawn in the frame of a change still catches up.
+		auto changed = this->material_->getRevision() != this->revision_;
+
+		if (pass == 0 || this->pass_ != pass)
 		{
-			if (this->modelMatrix_)
-				this->modelMatrix_->uniform4fmat(geometry.getTransform());
-			
-			if (this->viewMatrix_)
-				this->viewMatrix_->uniform4fmat(camera.getView());
+			this->updatePass(camera, context, cameraBuffer);
+			this->pass_ = pass;
+			this->geometry_ = nullptr;
+			changed = true;
+		}
 
-			if (this->viewProjMatrix_)
-				this->viewProjMatrix_->uniform4fmat(camera.getViewProjection());
+		if (pass == 0 || this->geometry_ != &geometry)
+		{
+			this->updateObject(camera, geometry);
+			this->geometry_ = &geometry;
+			changed |= this->modelMatrix_ || this->modelViewMatrix_ || this->normalMatrix_;
+		}
 
-			if (this->modelViewMatrix_)
-				this->modelViewMatrix_->uniform4fmat(camera.getView() * geometry.getTransform());
-			
-			if (this->projectionMatrix_)
-				this->projectionMatrix_->uniform4fmat(camera.getProjection());
-			
-			if (this->normalMatrix_)
-				this->normalMatrix_->uniform3fmat((math::float3x3)(camera.getView() * geometry.getTransform()));
+		this->updateParameters();
 
-			if (this->ambientLightColor_)
-				this->ambientLightColor_->uniform3f(context.ambientLightColors);
+		return changed;
+	}
 
-			if (this->spotLights_)
-				this->spotLights_->uniformBuffer(context.spotLightBuffer);
+	void
+	ForwardMaterial::updatePass(const camera::Camera& camera, const ForwardScene& context, const hal::GraphicsDataPtr& cameraBuffer) noexcept
+	{
+		if (this->camera_)
+			this->camera_->uniformBuffer(cameraBuffer);
+
+		if (this->viewMatrix_)
+			this->viewMatrix_->uniform4fmat(camera.getView());
+
+		if (this->viewProjMatrix_)
+			this->viewProjMatrix_->uniform4fmat(camera.getViewProjection());
+
+		if (this->projectionMatrix_)
+			this->projectionMatrix_->uniform4fmat(camera.getProjection());
 
-			if (this->pointLights_)
-				this->pointLights_->uniformBuffer(context.pointLightBuffer);
+		if (this->ambientLightColor_)
+			this->ambientLightColor_->uniform3f(context.ambientLightColors);
 
-			if (this->rectAreaLights_)
-				this->rectAreaLights_->uniformBuffer(context.rectangleLightBuffer);
+		if (this->spotLights_)
+			this->spotLights_->uniformBuffer(context.spotLightBuffer);
 
-			if (this->directionalLights_)
-				this->directionalLights_->uniformBuffer(context.directionLightBuffer);
+		if (this->pointLights_)
+			this->pointLights_->uniformBuffer(context.pointLightBuffer);
 
-			if (this->flipEnvMap_)
-				this->flipEnvMap_->uniform1f(1.0f);
+		if (this->rectAreaLights_)
+			this->rectAreaLights_->uniformBuffer(context.rectangleLightBuffer);
 
-			if (this->envMap_)
-				this->envMap_->uniformTexture(context.environmentLights.front().radiance.lock());
+		if (this->directionalLights_)
+			this->directionalLights_->uniformBuffer(context.directionLightBuffer);
 
-			if (this->envMapIntensity_)
-				this->envMapIntensity_->uniform1f(context.environmentLights.front().intensity);
+		if (this->flipEnvMap_)
+			this->flipEnvMap_->uniform1f(1.0f);
 
-			if (this->directionalShadowMaps_.size() > 0)
+		if (this->envMap_)
+			this->envMap_->uniformTexture(context.environmentLights.front().radiance.lock());
+
+		if (this->envMapIntensity_)
+			this->envMapIntensity_->uniform1f(context.environmentLights.front().intensity);
+
+		if (this->directionalShadowMaps_.size() > 0)
+		{
+			for (std::size_t i = 0, j = 0; i < context.directionalLights.size(); i++)
 			{
-				for (std::size_t i = 0, j = 0; i < context.directionalLights.size(); i++)
+				auto& it = context.directionalLights[i];
+				if (it.shadow)
 				{
-					auto& it = context.directionalLights[i];
-					if (it.shadow)
-					{
-						this->directionalShadowMaps_[j]->uniformTexture(context.directionalShadows[i]);
-						this->directionalShadowMatrixs_[j]->uniform4fmat(context.directionalShadowMatrix[i]);
-						j++;
-					}
+					this->directionalShadowMaps_[j]->uniformTexture(context.directionalShadows[i]);
+					this->directionalShadowMatrixs_[j]->uniform4fmat(context.directionalShadowMatrix[i]);
+					j++;
 				}
 			}
-
-			this->updateParameters();
 		}
 	}
 
+	void
+	ForwardMaterial::updateObject(const camera::Camera& camera, const geometry::Geometry& geometry) noexcept
+	{
+		if (this->modelMatrix_)
+			this->modelMatrix_->uniform4fmat(geometry.getTransform());
+
+		if (this->modelViewMatrix_)
+			this->modelViewMatrix_->uniform4fmat(camera.getView() * geometry.getTransform());
+
+		if (this->normalMatrix_)
+			this->normalMatrix_->uniform3fmat((math::float3x3)(camera.getView() * geometry.getTransform()));
+	}
+
 	void
 	ForwardMaterial::parseIncludes(std::string& str)
 	{
@@ -2018,20 +2067,41 @@ namespace octoon::video
 		auto shader = material->getShader();
 
 		std::string vertexShader = "#version 330\n\t";
+		if (this->instancing_)
+			vertexShader += "#define USE_INSTANCING\n";
 		vertexShader += R"(
 				layout(location = 0) in vec4 POSITION0;
 				layout(location = 1) in vec2 TEXCOORD0;
 				layout(location = 2) in vec3 NORMAL0;
 				layout(location = 3) in vec2 TEXCOORD1;
 
-				uniform mat4 modelMatrix;
-				uniform mat4 modelViewMatrix;
-				uniform mat4 projectionMatrix;
-				uniform mat4 viewMatrix;
-				uniform mat4 viewProjMatrix;
-				uniform mat3 normalMatrix;
 				uniform vec3 cameraPosition;
 
+				#ifdef USE_INSTANCING
+					layout(std140) uniform Camera {
+						mat4 projectionMatrix;
+						mat4 viewMatrix;
+						mat4 viewProjMatrix;
+					};
+
+					layout(location = 4) in vec4 INSTANCE0;
+					layout(location = 5) in vec4 INSTANCE1;
+					layout(location = 6) in vec4 INSTANCE2;
+					layout(location = 7) in vec4 INSTANCE3;
+
+					#define modelMatrix mat4(INSTANCE0, INSTANCE1, INSTANCE2, INSTANCE3)
+					#define modelViewMatrix (viewMatrix * modelMatrix)
+					#define normalMatrix mat3(modelViewMatrix)
+				#else
+					uniform mat4 projectionMatrix;
+					uniform mat4 viewMatrix;
+					uniform mat4 viewProjMatrix;
+
+					uniform mat4 modelMatrix;
+					uniform mat4 modelViewMatrix;
+					uniform mat3 normalMatrix;
+				#endif
+
 				#ifdef USE_COLOR
 					attribute vec3 color;
 				#endif
@@ -2042,7 +2112,10 @@ namespace octoon::video
 
 		std::string fragmentShader = "#version 330\n\t";
 		fragmentShader += "layout(location  = 0) out vec4 fragColor;\n";
-		fragmentShader += "uniform mat4 viewMatrix;\n";
+		if (this->instancing_)
+			fragmentShader += "layout(std140) uniform Camera { mat4 projectionMatrix; mat4 viewMatrix; mat4 viewProjMatrix; };\n";
+		else
+			fragmentShader += "uniform mat4 viewMatrix;\n";
 		//fragmentShader += "#define TONE_MAPPING\n";
 		fragmentShader += "#define USE_ENVMAP\n";
 		fragmentShader += "#define ENVMAP_TYPE_LATLONG_UV\n";
@@ -2059,10 +2132,7 @@ namespace octoon::video
 		this->replaceLightNums(vertexShader, context);
 		this->replaceLightNums(fragmentShader, context);
 
-		hal::GraphicsProgramDesc programDesc;
-		programDesc.addShader(Renderer::instance()->createShader(hal::GraphicsShaderDesc(hal::GraphicsShaderStageFlagBits::VertexBit, vertexShader, "main", hal::GraphicsShaderLang::GLSL)));
-		programDesc.addShader(Renderer::instance()->createShader(hal::GraphicsShaderDesc(hal::GraphicsShaderStageFlagBits::FragmentBit, fragmentShader, "main", hal::GraphicsShaderLang::GLSL)));
-		this->program_ = Renderer::instance()->createProgram(programDesc);
+		this->program_ = Renderer::instance()->createProgram(vertexShader, fragmentShader);
 	}
 
 	void
@@ -2144,10 +2214,19 @@ namespace octoon::video
 			hal::GraphicsInputLayoutDesc layoutDesc;
 			layoutDesc.addVertexLayout(hal::GraphicsVertexLayout(0, "POSITION", 0, hal::GraphicsFormat::R32G32B32SFloat));
 			layoutDesc.addVertexLayout(hal::GraphicsVertexLayout(0, "NORMAL", 0, hal::GraphicsFormat::R32G32B32SFloat));
-			layoutDesc.addVertexLayout(hal::GraphicsVertexLayout(0, "TEXCOORD", 0, hal::GraphicsFormat::R32G32SFloat));
-			layoutDesc.addVertexLayout(hal::GraphicsVertexLayout(0, "TEXCOORD", 1, hal::GraphicsFormat::R32G32SFloat));
+			layoutDesc.addVertexLayout(hal::GraphicsVertexLayout(1, "TEXCOORD", 0, hal::GraphicsFormat::R32G32SFloat));
+			layoutDesc.addVertexLayout(hal::GraphicsVertexLayout(1, "TEXCOORD", 1, hal::GraphicsFormat::R32G32SFloat));
 
-			layoutDesc.addVertexBinding(hal::GraphicsVertexBinding(0, layoutDesc.getVertexSize()));
+			layoutDesc.addVertexBinding(hal::GraphicsVertexBinding(0, layoutDesc.getVertexSize(0)));
+			layoutDesc.addVertexBinding(hal::GraphicsVertexBinding(1, layoutDesc.getVertexSize(1)));
+
+			if (this->instancing_)
+			{
+				for (std::uint8_t i = 0; i < 4; i++)
+					layoutDesc.addVertexLayout(hal::GraphicsVertexLayout(2, "INSTANCE", i, hal::GraphicsFormat::R32G32B32A32SFloat));
+
+				layoutDesc.addVertexBinding(hal::GraphicsVertexBinding(2, layoutDesc.getVertexSize(2), hal::GraphicsVertexDivisor::Instance));
+			}
 
 			hal::GraphicsDescriptorSetLayoutDesc descriptor_set_layout;
 			descriptor_set_layout.setUniformComponents(this->program_->getActiveParams());
@@ -2174,6 +2253,10 @@ namespace octoon::video
 				if (modelMatrix != end)
 					modelMatrix_ = *modelMatrix;
 
+				auto camera = std::find_if(begin, end, [](const hal::GraphicsUniformSetPtr& set) { return set->getName() == "Camera"; });
+				if (camera != end)
+					camera_ = *camera;
+
 				auto viewMatrix = std::find_if(begin, end, [](const hal::GraphicsUniformSetPtr& set) { return set->getName() == "viewMatrix"; });
 				if (viewMatrix != end)
 					viewMatrix_ = *viewMatrix;
@@ -2256,8 +2339,12 @@ namespace octoon::video
 	void
 	ForwardMaterial::updateParameters(bool force) noexcept
 	{
-		if (this->material_->isDirty() || force)
+		// The material's dirty flag is cleared after every frame, a material changed while none of its geometries were drawn
+		// would never be uploaded, so the revision last uploaded is kept instead.
+		if (this->material_->getRevision() != this->revision_ || force)
 		{
+			this->revision_ = this->material_->getRevision();
+
 			auto begin = descriptorSet_->getUniformSets().begin();
 			auto end = descriptorSet_->getUniformSets().end();
 
@@ -22,10 +22,16 @@
 #include <octoon/material/mesh_depth_material.h>
 #include <octoon/material/mesh_standard_material.h>
 
+#include <algorithm>
+#include <cstring>
+
 namespace octoon::video
 {
 	ForwardPipeline::ForwardPipeline(const hal::GraphicsContextPtr& context) noexcept
 		: context_(context)
+		, skinning_(std::make_unique<ForwardSkinning>(context))
+		, pass_(0)
+		, statistics_{}
 		, depthMaterial_(material::MeshDepthMaterial::create())
 	{
 	}
@@ -40,36 +46,236 @@ namespace octoon::video
 		return this->fbo_;
 	}
 
+	const CullingStatistics&
+	ForwardPipeline::getCullingStatistics() const noexcept
+	{
+		return this->culling_.getStatistics();
+	}
+
+	const RenderQueueStatistics&
+	ForwardPipeline::getRenderQueueStatistics() const noexcept
+	{
+		return this->statistics_;
+	}
+
+	float
+	ForwardPipeline::getSkinningValidationError() const noexcept
+	{
+		return this->skinning_->getLastValidationError();
+	}
+
 	void
 	ForwardPipeline::renderObject(ForwardScene& scene, const geometry::Geometry& geometry, const camera::Camera& camera, const std::shared_ptr<material::Material>& overrideMaterial) noexcept
+	{
+		this->queue_.clear();
+		this->pushObject(scene, geometry, camera, overrideMaterial);
+		this->renderQueue(scene, camera);
+	}
+
+	void
+	ForwardPipeline::renderObjects(ForwardScene& scene, const std::vector<geometry::Geometry*>& geometries, const camera::Camera& camera, const std::shared_ptr<material::Material>& overrideMaterial) noexcept
+	{
+		this->queue_.clear();
+
+		for (auto& geometry : geometries)
+			this->pushObject(scene, *geometry, camera, overrideMaterial);
+
+		this->queue_.sort();
+		this->renderQueue(scene, camera);
+	}
+
+	void
+	ForwardPipeline::pushObject(ForwardScene& scene, const geometry::Geometry& geometry, const camera::Camera& camera, const std::shared_ptr<material::Material>& overrideMaterial) noexcept
 	{
 		if (camera.getLayer() != geometry.getLayer())
 			return;
 
-		if (geometry.getVisible())
+		auto& mesh = geometry.getMesh();
+		if (geometry.getVisible() && mesh)
 		{
+			if (geometry.getSkinningData())
+				this->skinning_->update(geometry);
+
+			auto& buffer = buffers_[((std::intptr_t)mesh.get())];
+			if (!buffer)
+				buffer = std::make_shared<ForwardBuffer>(mesh);
+			else
+				buffer->update();
+
+			auto& skinned = this->skinning_->getVertexBuffer(geometry);
+			auto vertexBuffer = skinned ? skinned.get() : buffer->getVertexBuffer().get();
+			auto depth = math::sqrDistance(geometry.getTranslate(), camera.getTranslate());
+
 			for (std::size_t i = 0; i < geometry.getMaterials().size(); i++)
 			{
-				if (!this->setProgram(scene, overrideMaterial ? overrideMaterial : geometry.getMaterials()[i], camera, geometry))
-					return;
+				auto& material = overrideMaterial ? overrideMaterial : geometry.getMaterials()[i];
+				if (!material)
+					break;
 
-				if (!this->setBuffer(scene, geometry.getMesh(), i))
-					return;
+				auto& pipeline = materials_[((std::intptr_t)material.get())];
+				if (!pipeline)
+					pipeline = std::make_shared<ForwardMaterial>(material, scene, true);
 
-				auto indices = currentBuffer_->getNumIndices(i);
-				if (indices > 0)
-					this->context_->drawIndexed((std::uint32_t)indices, 1, 0, 0, 0);
-				else
-					this->context_->draw((std::uint32_t)currentBuffer_->getNumVertices(), 1, 0, 0);
+				this->queue_.push(const_cast<geometry::Geometry&>(geometry), i, *pipeline, vertexBuffer, depth);
 			}
 		}
 	}
 
 	void
-	ForwardPipeline::renderObjects(ForwardScene& scene, const std::vector<geometry::Geometry*>& geometries, const camera::Camera& camera, const std::shared_ptr<material::Material>& overrideMaterial) noexcept
+	ForwardPipeline::renderQueue(ForwardScene& scene, const camera::Camera& camera) noexcept
 	{
-		for (auto& geometry : geometries)
-			this->renderObject(scene , *geometry, camera, overrideMaterial);
+		// Every pass starts from an unknown binding, skinning or another renderer may have bound their own since the last one.
+		this->pass_++;
+		this->boundPipeline_ = nullptr;
+		this->boundDescriptorSet_ = nullptr;
+		this->boundIndexBuffer_ = nullptr;
+
+		for (auto& it : this->boundVertexBuffers_)
+		{
+			it.data = nullptr;
+			it.offset = 0;
+		}
+
+		// The camera matrices are written once for the pass and the transforms of all its draws go into one buffer, so the
+		// uniforms of a material only change when the pass does. Passes take turns on a few buffers of each kind, so mapping
+		// one rarely waits for the draws of the pass before.
+		auto& cameraBuffer = this->cameraBuffers_[this->pass_ % PassBufferCount];
+		auto& instanceBuffer = this->instanceBuffers_[this->pass_ % PassBufferCount];
+
+		ForwardMaterial::CameraBlock block;
+		block.projectionMatrix = camera.getProjection();
+		block.viewMatrix = camera.getView();
+		block.viewProjMatrix = camera.getViewProjection();
+
+		if (!this->writeBuffer(cameraBuffer, hal::GraphicsDataType::UniformBuffer, &block, sizeof(block)))
+		{
+			this->renderFallback(scene, camera);
+			return;
+		}
+
+		this->prepareBatches();
+
+		if (!this->writeBuffer(instanceBuffer, hal::GraphicsDataType::StorageVertexBuffer, this->instances_.data(), this->instances_.size() * sizeof(math::float4x4)))
+		{
+			this->renderFallback(scene, camera);
+			return;
+		}
+
+		auto& items = this->queue_.getItems();
+
+		for (auto& batch : this->batches_)
+		{
+			auto& item = items[batch.first];
+			auto& geometry = *item.geometry;
+
+			this->setProgram(scene, *batch.material, camera, geometry);
+			this->setBuffer(scene, geometry, item.subset);
+			this->setVertexBuffer(2, instanceBuffer, batch.offset * sizeof(math::float4x4));
+
+			auto indices = currentBuffer_->getNumIndices(item.subset);
+			if (indices > 0)
+				this->context_->drawIndexed((std::uint32_t)indices, (std::uint32_t)batch.count, 0, 0, 0);
+			else
+				this->context_->draw((std::uint32_t)currentBuffer_->getNumVertices(), (std::uint32_t)batch.count, 0, 0);
+
+			this->statistics_.draws++;
+
+			if (batch.count > 1)
+			{
+				this->statistics_.instancedDraws++;
+				this->statistics_.instances += batch.count;
+			}
+		}
+	}
+
+	void
+	ForwardPipeline::renderFallback(ForwardScene& scene, const camera::Camera& camera) noexcept
+	{
+		// Without the shared buffers of the pass every item is drawn alone by a material that keeps its matrices in uniforms.
+		auto& items = this->queue_.getItems();
+
+		for (auto& item : items)
+		{
+			auto& material = this->fallbackMaterials_[((std::intptr_t)item.material->getMaterial().get())];
+			if (!material)
+				material = std::make_shared<ForwardMaterial>(item.material->getMaterial(), scene);
+
+			auto& geometry = *item.geometry;
+
+			this->setProgram(scene, *material, camera, geometry);
+			this->setBuffer(scene, geometry, item.subset);
+
+			auto indices = currentBuffer_->getNumIndices(item.subset);
+			if (indices > 0)
+				this->context_->drawIndexed((std::uint32_t)indices, 1, 0, 0, 0);
+			else
+				this->context_->draw((std::uint32_t)currentBuffer_->getNumVertices(), 1, 0, 0);
+
+			this->statistics_.draws++;
+			this->statistics_.fallbackDraws++;
+		}
+	}
+
+	void
+	ForwardPipeline::prepareBatches() noexcept
+	{
+		auto& items = this->queue_.getItems();
+
+		this->batches_.clear();
+		this->instances_.clear();
+
+		// Equal meshes and materials sit next to each other in the queue unless the render order or the blending separates them.
+		auto instanceable = [](const ForwardRenderQueue::Item& a, const ForwardRenderQueue::Item& b)
+		{
+			return
+				a.material == b.material &&
+				a.subset == b.subset &&
+				a.geometry->getMesh() == b.geometry->getMesh() &&
+				!a.geometry->getSkinningData() &&
+				!b.geometry->getSkinningData();
+		};
+
+		for (std::size_t i = 0, j = 0; i < items.size(); i = j)
+		{
+			for (j = i + 1; j < items.size() && instanceable(items[i], items[j]); j++)
+				;
+
+			this->batches_.push_back(Batch{ i, j - i, this->instances_.size(), items[i].material });
+
+			for (auto k = i; k < j; k++)
+				this->instances_.push_back(items[k].geometry->getTransform());
+		}
+	}
+
+	bool
+	ForwardPipeline::writeBuffer(hal::GraphicsDataPtr& buffer, hal::GraphicsDataType type, const void* data, std::size_t size) noexcept
+	{
+		if (size == 0)
+			return true;
+
+		if (!buffer || buffer->getDataDesc().getStreamSize() < size)
+		{
+			std::size_t capacity = buffer ? buffer->getDataDesc().getStreamSize() : 0;
+
+			hal::GraphicsDataDesc dataDesc;
+			dataDesc.setType(type);
+			dataDesc.setStream(nullptr);
+			dataDesc.setStreamSize(std::max(size, capacity * 2));
+			dataDesc.setUsage(hal::GraphicsUsageFlagBits::WriteBit);
+
+			buffer = this->context_->getDevice()->createGraphicsData(dataDesc);
+			if (!buffer)
+				return false;
+		}
+
+		void* mapped = nullptr;
+		if (!buffer->map(0, size, &mapped))
+			return false;
+
+		std::memcpy(mapped, data, size);
+		buffer->unmap();
+
+		return true;
 	}
 
 	void
@@ -111,6 +317,19 @@ namespace octoon::video
 				}
 			}
 
+			if (faceCount > 0)
+			{
+				this->culling_.cull(*camera, geometries, this->shadowCasters_);
+
+				auto primitiveType = this->depthMaterial_->getPrimitiveType();
+				auto it = std::remove_if(this->shadowCasters_.begin(), this->shadowCasters_.end(), [primitiveType](const geometry::Geometry* geometry)
+				{
+					return geometry->getMaterial()->getPrimitiveType() != primitiveType;
+				});
+
+				this->shadowCasters_.erase(it, this->shadowCasters_.end());
+			}
+
 			for (std::uint32_t face = 0; face < faceCount; face++)
 			{
 				auto framebuffer = camera->getFramebuffer();
@@ -119,11 +338,7 @@ namespace octoon::video
 				this->context_->clearFramebuffer(0, camera->getClearFlags(), camera->getClearColor(), 1.0f, 0);
 				this->context_->setViewport(0, camera->getPixelViewport());
 
-				for (auto& geometry : geometries)
-				{
-					if (geometry->getMaterial()->getPrimitiveType() == this->depthMaterial_->getPrimitiveType())
-						this->renderObject(scene, *geometry, *camera, this->depthMaterial_);
-				}
+				this->renderObjects(scene, this->shadowCasters_, *camera, this->depthMaterial_);
 
 				if (camera->getRenderToScreen())
 				{
@@ -152,6 +367,7 @@ namespace octoon::video
 		this->context_->clearFramebuffer(0, camera->getClearFlags(), camera->getClearColor(), 1.0f, 0);
 		this->context_->setViewport(0, camera->getPixelViewport());
 
+		this->skinning_->collect();
 		this->renderObjects(*compiled, compiled->geometries, *camera, this->overrideMaterial_);
 
 		if (camera->getRenderToScreen())
@@ -240,47 +456,75 @@ namespace octoon::video
 		}
 	}
 
-	bool
-	ForwardPipeline::setBuffer(ForwardScene& scene, const std::shared_ptr<mesh::Mesh>& mesh, std::size_t subset)
+	void
+	ForwardPipeline::setBuffer(ForwardScene& scene, const geometry::Geometry& geometry, std::size_t subset) noexcept
 	{
-		if (mesh)
-		{
-			auto& buffer = buffers_[((std::intptr_t)mesh.get())];
-			if (!buffer)
-				buffer = std::make_shared<ForwardBuffer>(mesh);
+		auto& buffer = buffers_[((std::intptr_t)geometry.getMesh().get())];
+		auto& skinned = this->skinning_->getVertexBuffer(geometry);
 
-			this->context_->setVertexBufferData(0, buffer->getVertexBuffer(), 0);
-			this->context_->setIndexBufferData(buffer->getIndexBuffer(subset), 0, hal::GraphicsIndexType::UInt32);
+		if (skinned)
+			this->setVertexBuffer(0, skinned, 0);
+		else
+			this->setVertexBuffer(0, buffer->getVertexBuffer(), buffer->getVertexOffset());
 
-			this->currentBuffer_ = buffer;
+		this->setVertexBuffer(1, buffer->getTexcoordBuffer(), 0);
 
-			return true;
+		auto& indexBuffer = buffer->getIndexBuffer(subset);
+		if (this->boundIndexBuffer_ != indexBuffer || !indexBuffer)
+		{
+			this->context_->setIndexBufferData(indexBuffer, 0, hal::GraphicsIndexType::UInt32);
+			this->boundIndexBuffer_ = indexBuffer;
 		}
 		else
 		{
-			return false;
+			this->statistics_.indexBufferBindsAvoided++;
 		}
+
+		this->currentBuffer_ = buffer;
 	}
 
-	bool
-	ForwardPipeline::setProgram(ForwardScene& scene, const std::shared_ptr<material::Material>& material, const camera::Camera& camera, const geometry::Geometry& geometry)
+	void
+	ForwardPipeline::setVertexBuffer(std::uint32_t i, const hal::GraphicsDataPtr& data, std::intptr_t offset) noexcept
 	{
-		if (material)
+		auto& bound = this->boundVertexBuffers_[i];
+		if (bound.data != data || bound.offset != offset || !data)
 		{
-			auto& pipeline = materials_[((std::intptr_t)material.get())];
-			if (!pipeline)
-				pipeline = std::make_shared<ForwardMaterial>(material, dynamic_cast<ForwardScene&>(scene));
+			this->context_->setVertexBufferData(i, data, offset);
+			bound.data = data;
+			bound.offset = offset;
+		}
+		else
+		{
+			this->statistics_.vertexBufferBindsAvoided++;
+		}
+	}
 
-			pipeline->update(camera, geometry, scene);
+	void
+	ForwardPipeline::setProgram(ForwardScene& scene, ForwardMaterial& material, const camera::Camera& camera, const geometry::Geometry& geometry) noexcept
+	{
+		auto changed = material.update(camera, geometry, scene, this->pass_, this->cameraBuffers_[this->pass_ % PassBufferCount]);
 
-			this->context_->setRenderPipeline(pipeline->getPipeline());
-			this->context_->setDescriptorSet(pipeline->getDescriptorSet());
+		auto& pipeline = material.getPipeline();
+		if (this->boundPipeline_ != pipeline || !pipeline)
+		{
+			this->context_->setRenderPipeline(pipeline);
+			this->boundPipeline_ = pipeline;
+		}
+		else
+		{
+			this->statistics_.pipelineBindsAvoided++;
+		}
 
-			return true;
+		// The uniforms live in the set, so a set whose values changed is bound again for the context to upload them.
+		auto& descriptorSet = material.getDescriptorSet();
+		if (this->boundDescriptorSet_ != descriptorSet || changed)
+		{
+			this->context_->setDescriptorSet(descriptorSet);
+			this->boundDescriptorSet_ = descriptorSet;
 		}
 		else
 		{
-			return false;
+			this->statistics_.descriptorSetBindsAvoided++;
 		}
 	}
 }
\ No newline at end of file
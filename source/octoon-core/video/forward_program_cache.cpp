@@ -0,0 +1,157 @@
+#include <octoon/video/forward_program_cache.h>
+#include <octoon/runtime/profiler.h>
+
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+
+namespace octoon::video
+{
+	constexpr std::uint32_t BinaryMagic = 0x4250434F; // "OCPB"
+
+	static std::uint64_t
+	hashSource(std::uint64_t hash, std::string_view source) noexcept
+	{
+		// 64 bit FNV-1a, the separator keeps "ab" + "c" apart from "a" + "bc".
+		for (auto c : source)
+		{
+			hash ^= static_cast<std::uint8_t>(c);
+			hash *= 0x100000001B3ull;
+		}
+
+		hash ^= 0xFF;
+		hash *= 0x100000001B3ull;
+
+		return hash;
+	}
+
+	ForwardProgramCache::ForwardProgramCache() noexcept
+		: statistics_{}
+	{
+	}
+
+	ForwardProgramCache::~ForwardProgramCache() noexcept
+	{
+	}
+
+	void
+	ForwardProgramCache::setDirectory(std::string_view path) noexcept
+	{
+		this->directory_ = path;
+	}
+
+	const std::string&
+	ForwardProgramCache::getDirectory() const noexcept
+	{
+		return this->directory_;
+	}
+
+	hal::GraphicsProgramPtr
+	ForwardProgramCache::getProgram(const hal::GraphicsDevicePtr& device, const std::string& vertexShader, const std::string& fragmentShader) noexcept
+	{
+		OCTOON_PROFILE_ZONE("ForwardProgramCache::getProgram");
+
+		this->statistics_.requests++;
+
+		auto hash = hashSource(hashSource(0xCBF29CE484222325ull, vertexShader), fragmentShader);
+
+		auto& program = this->programs_[hash];
+		if (program)
+			return program;
+
+		program = this->loadProgram(device, hash);
+		if (program)
+		{
+			this->statistics_.loaded++;
+			return program;
+		}
+
+		hal::GraphicsProgramDesc programDesc;
+		programDesc.addShader(device->createShader(hal::GraphicsShaderDesc(hal::GraphicsShaderStageFlagBits::VertexBit, vertexShader, "main", hal::GraphicsShaderLang::GLSL)));
+		programDesc.addShader(device->createShader(hal::GraphicsShaderDesc(hal::GraphicsShaderStageFlagBits::FragmentBit, fragmentShader, "main", hal::GraphicsShaderLang::GLSL)));
+
+		program = device->createProgram(programDesc);
+		if (program)
+		{
+			this->statistics_.compiled++;
+			this->saveProgram(*program, hash);
+		}
+
+		return program;
+	}
+
+	void
+	ForwardProgramCache::clear() noexcept
+	{
+		this->programs_.clear();
+	}
+
+	const ProgramCacheStatistics&
+	ForwardProgramCache::getStatistics() const noexcept
+	{
+		return this->statistics_;
+	}
+
+	hal::GraphicsProgramPtr
+	ForwardProgramCache::loadProgram(const hal::GraphicsDevicePtr& device, std::uint64_t hash) noexcept
+	{
+		if (this->directory_.empty())
+			return nullptr;
+
+		std::ifstream stream(this->getPath(hash), std::ios_base::in | std::ios_base::binary);
+		if (!stream)
+			return nullptr;
+
+		std::uint32_t magic = 0;
+		std::uint32_t format = 0;
+		stream.read((char*)&magic, sizeof(magic));
+		stream.read((char*)&format, sizeof(format));
+		if (!stream || magic != BinaryMagic)
+			return nullptr;
+
+		std::vector<std::uint8_t> binary((std::istreambuf_iterator<char>(stream)), std::istreambuf_iterator<char>());
+		if (binary.empty())
+			return nullptr;
+
+		hal::GraphicsProgramDesc programDesc;
+		programDesc.setProgramBinary(std::move(binary), format);
+
+		return device->createProgram(programDesc);
+	}
+
+	void
+	ForwardProgramCache::saveProgram(const hal::GraphicsProgram& program, std::uint64_t hash) noexcept
+	{
+		if (this->directory_.empty())
+			return;
+
+		std::uint32_t format = 0;
+		std::vector<std::uint8_t> binary;
+		if (!program.getProgramBinary(binary, format))
+			return;
+
+		std::ofstream stream(this->getPath(hash), std::ios_base::out | std::ios_base::binary | std::ios_base::trunc);
+		if (!stream)
+			return;
+
+		stream.write((const char*)&BinaryMagic, sizeof(BinaryMagic));
+		stream.write((const char*)&format, sizeof(format));
+		stream.write((const char*)binary.data(), binary.size());
+
+		if (stream)
+			this->statistics_.saved++;
+	}
+
+	std::string
+	ForwardProgramCache::getPath(std::uint64_t hash) const noexcept
+	{
+		char name[32];
+		std::snprintf(name, sizeof(name), "%016llx.bin", (unsigned long long)hash);
+
+		auto path = this->directory_;
+		if (path.back() != '/' && path.back() != '\\')
+			path += '/';
+
+		return path + name;
+	}
+}
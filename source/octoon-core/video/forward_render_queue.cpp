@@ -0,0 +1,159 @@
+#include <octoon/video/forward_render_queue.h>
+#include <octoon/runtime/profiler.h>
+
+#include <algorithm>
+#include <cstring>
+
+namespace octoon::video
+{
+	constexpr std::uint32_t StateBits = 13;
+	constexpr std::uint32_t DepthBits = 16;
+	constexpr std::uint32_t MaxState = (1u << StateBits) - 1;
+	constexpr std::uint32_t MaxDepth = (1u << DepthBits) - 1;
+	constexpr std::uint32_t MaxRank = 0xFF;
+
+	constexpr std::uint32_t RankShift = 56;
+	constexpr std::uint32_t TransparentShift = 55;
+
+	static std::uint32_t
+	quantizeDepth(float depth) noexcept
+	{
+		// The bits of a positive float grow with its value, the upper 16 keep the exponent and 7 bits of the mantissa.
+		std::uint32_t bits;
+		depth = std::max(depth, 0.0f);
+		std::memcpy(&bits, &depth, sizeof(bits));
+		return std::min(bits >> 15, MaxDepth);
+	}
+
+	ForwardRenderQueue::ForwardRenderQueue() noexcept
+	{
+	}
+
+	ForwardRenderQueue::~ForwardRenderQueue() noexcept
+	{
+	}
+
+	void
+	ForwardRenderQueue::clear() noexcept
+	{
+		items_.clear();
+		orders_.clear();
+		pipelines_.clear();
+		materials_.clear();
+		buffers_.clear();
+	}
+
+	bool
+	ForwardRenderQueue::empty() const noexcept
+	{
+		return items_.empty();
+	}
+
+	void
+	ForwardRenderQueue::push(geometry::Geometry& geometry, std::size_t subset, ForwardMaterial& material, const hal::GraphicsData* vertexBuffer, float depth) noexcept
+	{
+		auto transparent = false;
+		if (material.getMaterial())
+		{
+			for (auto& blend : material.getMaterial()->getColorBlends())
+				transparent |= blend.getBlendEnable();
+		}
+
+		std::uint64_t pipelineIndex = this->getIndex(pipelines_, material.getPipeline().get());
+		std::uint64_t materialIndex = this->getIndex(materials_, &material);
+		std::uint64_t bufferIndex = this->getIndex(buffers_, vertexBuffer);
+		std::uint64_t depthIndex = quantizeDepth(depth);
+
+		std::uint64_t key = 0;
+
+		if (transparent)
+		{
+			key |= 1ull << TransparentShift;
+			key |= (MaxDepth - depthIndex) << (StateBits * 3);
+			key |= pipelineIndex << (StateBits * 2);
+			key |= materialIndex << StateBits;
+			key |= bufferIndex;
+		}
+		else
+		{
+			key |= pipelineIndex << (StateBits * 2 + DepthBits);
+			key |= materialIndex << (StateBits + DepthBits);
+			key |= bufferIndex << DepthBits;
+			key |= depthIndex;
+		}
+
+		items_.push_back(Item{ key, &geometry, subset, &material });
+		orders_.push_back(geometry.getRenderOrder());
+	}
+
+	void
+	ForwardRenderQueue::sort() noexcept
+	{
+		OCTOON_PROFILE_ZONE("ForwardRenderQueue::sort");
+
+		if (items_.size() < 2)
+			return;
+
+		// Render orders are arbitrary integers, their rank among the orders of this pass fits the top byte.
+		ranks_ = orders_;
+		std::sort(ranks_.begin(), ranks_.end());
+		ranks_.erase(std::unique(ranks_.begin(), ranks_.end()), ranks_.end());
+
+		if (ranks_.size() > 1)
+		{
+			for (std::size_t i = 0; i < items_.size(); i++)
+			{
+				std::uint64_t rank = std::lower_bound(ranks_.begin(), ranks_.end(), orders_[i]) - ranks_.begin();
+				items_[i].key |= std::min<std::uint64_t>(rank, MaxRank) << RankShift;
+			}
+		}
+
+		// Least significant digit radix sort on bytes, skipping the bytes that are equal in every key.
+		std::uint64_t same = ~0ull;
+		for (auto& it : items_)
+			same &= ~(it.key ^ items_.front().key);
+
+		sorted_.resize(items_.size());
+
+		for (std::uint32_t shift = 0; shift < 64; shift += 8)
+		{
+			if (((same >> shift) & 0xFF) == 0xFF)
+				continue;
+
+			std::size_t offsets[256] = {};
+			for (auto& it : items_)
+				offsets[(it.key >> shift) & 0xFF]++;
+
+			std::size_t offset = 0;
+			for (auto& it : offsets)
+			{
+				auto count = it;
+				it = offset;
+				offset += count;
+			}
+
+			for (auto& it : items_)
+				sorted_[offsets[(it.key >> shift) & 0xFF]++] = it;
+
+			items_.swap(sorted_);
+		}
+	}
+
+	const std::vector<ForwardRenderQueue::Item>&
+	ForwardRenderQueue::getItems() const noexcept
+	{
+		return items_;
+	}
+
+	std::uint32_t
+	ForwardRenderQueue::getIndex(std::unordered_map<const void*, std::uint32_t>& indices, const void* state) noexcept
+	{
+		auto it = indices.find(state);
+		if (it != indices.end())
+			return it->second;
+
+		auto index = std::min(static_cast<std::uint32_t>(indices.size()), MaxState);
+		indices.emplace(state, index);
+		return index;
+	}
+}
@@ -40,6 +40,32 @@ namespace octoon::video
 		return this->pipeline_->getFramebuffer();
 	}
 
+	CullingStatistics
+	ForwardRenderer::getCullingStatistics() const noexcept
+	{
+		auto& scene = this->controller_->getCullingStatistics();
+		auto& shadow = this->pipeline_->getCullingStatistics();
+
+		CullingStatistics statistics;
+		statistics.tested = scene.tested + shadow.tested;
+		statistics.culled = scene.culled + shadow.culled;
+		statistics.skippedDraws = scene.skippedDraws + shadow.skippedDraws;
+
+		return statistics;
+	}
+
+	const RenderQueueStatistics&
+	ForwardRenderer::getRenderQueueStatistics() const noexcept
+	{
+		return this->pipeline_->getRenderQueueStatistics();
+	}
+
+	float
+	ForwardRenderer::getSkinningValidationError() const noexcept
+	{
+		return this->pipeline_->getSkinningValidationError();
+	}
+
 	void
 	ForwardRenderer::prepareScene(RenderScene* scene) noexcept
 	{
@@ -1,4 +1,5 @@
 #include <octoon/video/forward_scene_controller.h>
+#include <octoon/runtime/profiler.h>
 
 #include <octoon/camera/perspective_camera.h>
 #include <octoon/light/ambient_light.h>
@@ -24,6 +25,8 @@ namespace octoon::video
 	void
 	ForwardSceneController::compileScene(RenderScene* scene) noexcept
 	{
+		OCTOON_PROFILE_ZONE("ForwardSceneController::compileScene");
+
 		auto iter = sceneCache_.find(scene);
 		if (iter != sceneCache_.cend())
 		{
@@ -52,17 +55,23 @@ namespace octoon::video
 			throw std::runtime_error("Scene has not been compiled");
 	}
 
+	const CullingStatistics&
+	ForwardSceneController::getCullingStatistics() const noexcept
+	{
+		return culling_.getStatistics();
+	}
+
 	void
 	ForwardSceneController::updateCamera(const RenderScene* scene, ForwardScene& out) const
 	{
 		out.camera = scene->getMainCamera();
 	}
 
-    void
-    ForwardSceneController::updateIntersector(const RenderScene* scene, ForwardScene& out) const
-    {
-		out.geometries = scene->getGeometries();
-    }
+	void
+	ForwardSceneController::updateIntersector(const RenderScene* scene, ForwardScene& out) noexcept
+	{
+		culling_.cull(*out.camera, scene->getGeometries(), out.geometries);
+	}
 
 	void
 	ForwardSceneController::updateLights(const RenderScene* scene, ForwardScene& out) noexcept
@@ -0,0 +1,407 @@
+#include <octoon/video/forward_skinning.h>
+#include <octoon/video/renderer.h>
+#include <octoon/hal/graphics_device.h>
+#include <octoon/runtime/except.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+namespace octoon::video
+{
+	constexpr std::uint32_t SkinningGroupSize = 64;
+
+	constexpr std::size_t VertexStreamStride = 6;
+
+	// Bones are read as two 16-bit indices per uint, joints as column major mat4 which matches the row vectors of math::float4x4.
+	static const char* SkinningShader = R"(
+		#version 430
+		layout(local_size_x = 64) in;
+
+		layout(std430) readonly buffer BindPose { float bindPose[]; };
+		layout(std430) readonly buffer Weights { vec4 weights[]; };
+		layout(std430) readonly buffer Bones { uint bones[]; };
+		layout(std430) readonly buffer Joints { mat4 joints[]; };
+		layout(std430) readonly buffer MorphRows { uint morphRows[]; };
+		layout(std430) readonly buffer MorphTargets { uint morphTargets[]; };
+		layout(std430) readonly buffer MorphDeltas { float morphDeltas[]; };
+		layout(std430) readonly buffer MorphWeights { float morphWeights[]; };
+		layout(std430) writeonly buffer Vertices { float vertices[]; };
+
+		uniform uint numVertices;
+
+		void main()
+		{
+			uint i = gl_GlobalInvocationID.x;
+			if (i >= numVertices)
+				return;
+
+			vec3 position = vec3(bindPose[i * 6], bindPose[i * 6 + 1], bindPose[i * 6 + 2]);
+			vec3 normal = vec3(bindPose[i * 6 + 3], bindPose[i * 6 + 4], bindPose[i * 6 + 5]);
+
+			for (uint k = morphRows[i]; k < morphRows[i + 1]; k++)
+				position += vec3(morphDeltas[k * 3], morphDeltas[k * 3 + 1], morphDeltas[k * 3 + 2]) * morphWeights[morphTargets[k]];
+
+			uint b0 = bones[i * 2];
+			uint b1 = bones[i * 2 + 1];
+			vec4 w = weights[i];
+
+			mat4 m = joints[b0 & 0xFFFFu] * w.x + joints[b0 >> 16] * w.y + joints[b1 & 0xFFFFu] * w.z + joints[b1 >> 16] * w.w;
+
+			position = (m * vec4(position, 1.0)).xyz;
+			normal = mat3(m) * normal;
+
+			vertices[i * 6] = position.x;
+			vertices[i * 6 + 1] = position.y;
+			vertices[i * 6 + 2] = position.z;
+			vertices[i * 6 + 3] = normal.x;
+			vertices[i * 6 + 4] = normal.y;
+			vertices[i * 6 + 5] = normal.z;
+		})";
+
+	struct ForwardSkinning::SkinnedBuffer
+	{
+		std::weak_ptr<skelecton::SkinningData> data;
+
+		std::uint32_t numVertices = 0;
+		std::uint32_t streamRevision = std::numeric_limits<std::uint32_t>::max();
+		std::uint32_t positionRevision = std::numeric_limits<std::uint32_t>::max();
+		std::uint32_t poseRevision = std::numeric_limits<std::uint32_t>::max();
+
+		std::vector<float> bindPoseStream;
+
+		hal::GraphicsDataPtr bindPose;
+		hal::GraphicsDataPtr weights;
+		hal::GraphicsDataPtr bones;
+		hal::GraphicsDataPtr morphRows;
+		hal::GraphicsDataPtr morphTargets;
+		hal::GraphicsDataPtr morphDeltas;
+
+		hal::GraphicsDataPtr joints;
+		hal::GraphicsDataPtr morphWeights;
+
+		hal::GraphicsDataPtr vertices;
+		hal::GraphicsDescriptorSetPtr descriptorSet;
+	};
+
+	static hal::GraphicsDataPtr
+	createStorageBuffer(const void* stream, std::size_t size, hal::GraphicsUsageFlags usage) noexcept(false)
+	{
+		hal::GraphicsDataDesc dataDesc;
+		dataDesc.setType(hal::GraphicsDataType::StorageBuffer);
+		dataDesc.setStream((std::uint8_t*)stream);
+		dataDesc.setStreamSize(size);
+		dataDesc.setUsage(usage);
+
+		auto data = Renderer::instance()->createGraphicsData(dataDesc);
+		if (!data)
+			throw runtime::runtime_error::create("createGraphicsData() failed");
+
+		return data;
+	}
+
+	static void
+	setStorageBuffer(const hal::GraphicsDescriptorSetPtr& descriptorSet, std::string_view name, const hal::GraphicsDataPtr& data) noexcept
+	{
+		for (auto& it : descriptorSet->getUniformSets())
+		{
+			if (it->getName() == name)
+			{
+				it->uniformBuffer(data);
+				break;
+			}
+		}
+	}
+
+	// Writes into the buffer in place, a new one is created and bound only when the size changes.
+	static void
+	writeStorageBuffer(const hal::GraphicsDescriptorSetPtr& descriptorSet, std::string_view name, hal::GraphicsDataPtr& data, const void* stream, std::size_t size) noexcept(false)
+	{
+		if (!data || data->getDataDesc().getStreamSize() != size)
+		{
+			data = createStorageBuffer(stream, size, hal::GraphicsUsageFlagBits::WriteBit);
+			setStorageBuffer(descriptorSet, name, data);
+			return;
+		}
+
+		void* dst = nullptr;
+		if (data->map(0, size, &dst))
+		{
+			std::memcpy(dst, stream, size);
+			data->unmap();
+		}
+	}
+
+	ForwardSkinning::ForwardSkinning(const hal::GraphicsContextPtr& context) noexcept
+		: context_(context)
+		, validationError_(-1.0f)
+	{
+		this->setupPipeline();
+	}
+
+	ForwardSkinning::~ForwardSkinning() noexcept
+	{
+	}
+
+	bool
+	ForwardSkinning::isComputeSupported() const noexcept
+	{
+		return this->pipeline_ != nullptr;
+	}
+
+	void
+	ForwardSkinning::setupPipeline() noexcept
+	{
+		if (this->context_->getDevice()->getDeviceDesc().getDeviceType() != hal::GraphicsDeviceType::OpenGL45)
+			return;
+
+		hal::GraphicsProgramDesc programDesc;
+		programDesc.addShader(Renderer::instance()->createShader(hal::GraphicsShaderDesc(hal::GraphicsShaderStageFlagBits::ComputeBit, SkinningShader, "main", hal::GraphicsShaderLang::GLSL)));
+
+		auto program = Renderer::instance()->createProgram(programDesc);
+		if (!program)
+			return;
+
+		hal::GraphicsDescriptorSetLayoutDesc descriptorSetLayout;
+		descriptorSetLayout.setUniformComponents(program->getActiveParams());
+
+		hal::GraphicsPipelineDesc pipelineDesc;
+		pipelineDesc.setGraphicsInputLayout(Renderer::instance()->createInputLayout(hal::GraphicsInputLayoutDesc()));
+		pipelineDesc.setGraphicsState(Renderer::instance()->createRenderState(hal::GraphicsStateDesc()));
+		pipelineDesc.setGraphicsProgram(program);
+		pipelineDesc.setGraphicsDescriptorSetLayout(Renderer::instance()->createDescriptorSetLayout(descriptorSetLayout));
+
+		this->pipeline_ = Renderer::instance()->createRenderPipeline(pipelineDesc);
+	}
+
+	void
+	ForwardSkinning::update(const geometry::Geometry& geometry) noexcept(false)
+	{
+		auto& data = geometry.getSkinningData();
+		auto& mesh = geometry.getMesh();
+		if (!data || !mesh)
+			return;
+
+		// A new entry also when the address is reused by skinning data created after the old one died.
+		auto& buffer = buffers_[(std::intptr_t)data.get()];
+		if (!buffer || buffer->data.lock() != data)
+		{
+			buffer = std::make_shared<SkinnedBuffer>();
+			buffer->data = data;
+		}
+
+		if (buffer->streamRevision == data->streamRevision && buffer->positionRevision == data->positionRevision && buffer->poseRevision == data->poseRevision)
+			return;
+
+		auto numVertices = data->streams.getNumVertices();
+		if (numVertices == 0 || data->streams.weights.size() != numVertices || data->joints.empty())
+			return;
+
+		if (this->isComputeSupported() && data->streams.isLinearOnly())
+		{
+			auto streamChanged = !buffer->vertices || buffer->streamRevision != data->streamRevision || buffer->numVertices != numVertices;
+			if (streamChanged)
+				this->updateStreams(*buffer, *data);
+			if (streamChanged || buffer->positionRevision != data->positionRevision)
+				this->updatePositions(*buffer, *data);
+
+			this->updatePose(*buffer, *data);
+
+			this->context_->setRenderPipeline(this->pipeline_);
+			this->context_->setDescriptorSet(buffer->descriptorSet);
+			this->context_->dispatch((buffer->numVertices + SkinningGroupSize - 1) / SkinningGroupSize, 1, 1);
+
+			if (streamChanged && this->context_->getDevice()->getDeviceDesc().isEnabledDebugControl())
+			{
+				float maxError = 0.0f;
+				this->validate(geometry, maxError);
+				validationError_ = std::max(validationError_, maxError);
+			}
+		}
+		else
+		{
+			buffer->vertices.reset();
+
+			skelecton::skinning(*data, mesh->getVertexArray(), mesh->getNormalArray());
+			mesh->markVertexDirty();
+		}
+
+		buffer->streamRevision = data->streamRevision;
+		buffer->positionRevision = data->positionRevision;
+		buffer->poseRevision = data->poseRevision;
+	}
+
+	const hal::GraphicsDataPtr&
+	ForwardSkinning::getVertexBuffer(const geometry::Geometry& geometry) const noexcept
+	{
+		static const hal::GraphicsDataPtr empty;
+
+		auto& data = geometry.getSkinningData();
+		if (!data)
+			return empty;
+
+		auto it = buffers_.find((std::intptr_t)data.get());
+		if (it != buffers_.end())
+			return it->second->vertices;
+
+		return empty;
+	}
+
+	void
+	ForwardSkinning::collect() noexcept
+	{
+		for (auto it = buffers_.begin(); it != buffers_.end();)
+		{
+			if (it->second->data.expired())
+				it = buffers_.erase(it);
+			else
+				++it;
+		}
+	}
+
+	float
+	ForwardSkinning::getLastValidationError() const noexcept
+	{
+		return validationError_;
+	}
+
+	bool
+	ForwardSkinning::validate(const geometry::Geometry& geometry, float& maxError, float tolerance) const noexcept
+	{
+		maxError = std::numeric_limits<float>::infinity();
+
+		auto& data = geometry.getSkinningData();
+		auto& vertices = this->getVertexBuffer(geometry);
+		if (!data || !vertices)
+			return false;
+
+		math::float3s expectVertices;
+		math::float3s expectNormals;
+		skelecton::skinning(*data, expectVertices, expectNormals);
+
+		auto size = expectVertices.size() * VertexStreamStride * sizeof(float);
+		if (vertices->getDataDesc().getStreamSize() < size)
+			return false;
+
+		void* stream = nullptr;
+		if (!vertices->map(0, size, &stream))
+			return false;
+
+		maxError = 0.0f;
+
+		auto v = static_cast<const float*>(stream);
+		for (std::size_t i = 0; i < expectVertices.size(); i++, v += VertexStreamStride)
+		{
+			auto& p = expectVertices[i];
+			auto& n = expectNormals[i];
+
+			maxError = std::max({ maxError, std::abs(v[0] - p.x), std::abs(v[1] - p.y), std::abs(v[2] - p.z) });
+			maxError = std::max({ maxError, std::abs(v[3] - n.x), std::abs(v[4] - n.y), std::abs(v[5] - n.z) });
+		}
+
+		vertices->unmap();
+
+		return maxError <= tolerance;
+	}
+
+	void
+	ForwardSkinning::updateStreams(SkinnedBuffer& buffer, const skelecton::SkinningData& data) noexcept(false)
+	{
+		auto& streams = data.streams;
+		auto& morphs = data.morphs;
+		auto numVertices = streams.getNumVertices();
+
+		// Vertices without morphs still need an empty row, and unused morph buffers are kept one element long so every binding is valid.
+		std::vector<std::uint32_t> rows = morphs.rows;
+		rows.resize(numVertices + 1, rows.empty() ? 0 : rows.back());
+
+		std::vector<std::uint32_t> targets = morphs.targets;
+		std::vector<float> deltas(std::max<std::size_t>(morphs.deltas.size(), 1) * 3);
+		for (std::size_t i = 0; i < morphs.deltas.size(); i++)
+		{
+			deltas[i * 3] = morphs.deltas[i].x;
+			deltas[i * 3 + 1] = morphs.deltas[i].y;
+			deltas[i * 3 + 2] = morphs.deltas[i].z;
+		}
+
+		if (targets.empty())
+			targets.push_back(0);
+
+		if (!buffer.descriptorSet)
+		{
+			hal::GraphicsDescriptorSetDesc descriptorSetDesc;
+			descriptorSetDesc.setGraphicsDescriptorSetLayout(this->pipeline_->getPipelineDesc().getDescriptorSetLayout());
+
+			buffer.descriptorSet = Renderer::instance()->createDescriptorSet(descriptorSetDesc);
+			if (!buffer.descriptorSet)
+				throw runtime::runtime_error::create("createDescriptorSet() failed");
+		}
+
+		buffer.numVertices = static_cast<std::uint32_t>(numVertices);
+
+		for (auto& it : buffer.descriptorSet->getUniformSets())
+		{
+			if (it->getName() == "numVertices")
+				it->uniform1ui(buffer.numVertices);
+		}
+
+		writeStorageBuffer(buffer.descriptorSet, "Weights", buffer.weights, streams.weights.data(), numVertices * sizeof(math::float4));
+		writeStorageBuffer(buffer.descriptorSet, "Bones", buffer.bones, streams.bones.data(), numVertices * 4 * sizeof(std::uint16_t));
+		writeStorageBuffer(buffer.descriptorSet, "MorphRows", buffer.morphRows, rows.data(), rows.size() * sizeof(std::uint32_t));
+		writeStorageBuffer(buffer.descriptorSet, "MorphTargets", buffer.morphTargets, targets.data(), targets.size() * sizeof(std::uint32_t));
+		writeStorageBuffer(buffer.descriptorSet, "MorphDeltas", buffer.morphDeltas, deltas.data(), deltas.size() * sizeof(float));
+
+		auto vertexSize = numVertices * VertexStreamStride * sizeof(float);
+		if (!buffer.vertices || buffer.vertices->getDataDesc().getStreamSize() != vertexSize)
+		{
+			hal::GraphicsDataDesc dataDesc;
+			dataDesc.setType(hal::GraphicsDataType::StorageVertexBuffer);
+			dataDesc.setStream(nullptr);
+			dataDesc.setStreamSize(vertexSize);
+			dataDesc.setUsage(hal::GraphicsUsageFlagBits::ReadBit);
+
+			buffer.vertices = Renderer::instance()->createGraphicsData(dataDesc);
+			if (!buffer.vertices)
+				throw runtime::runtime_error::create("createGraphicsData() failed");
+
+			setStorageBuffer(buffer.descriptorSet, "Vertices", buffer.vertices);
+		}
+	}
+
+	void
+	ForwardSkinning::updatePositions(SkinnedBuffer& buffer, const skelecton::SkinningData& data) noexcept(false)
+	{
+		auto& streams = data.streams;
+		auto numVertices = streams.getNumVertices();
+
+		auto& bindPose = buffer.bindPoseStream;
+		bindPose.resize(numVertices * VertexStreamStride);
+
+		for (std::size_t i = 0; i < numVertices; i++)
+		{
+			auto v = bindPose.data() + i * VertexStreamStride;
+			v[0] = streams.positionX[i];
+			v[1] = streams.positionY[i];
+			v[2] = streams.positionZ[i];
+			v[3] = i < streams.normalX.size() ? streams.normalX[i] : 0.0f;
+			v[4] = i < streams.normalY.size() ? streams.normalY[i] : 0.0f;
+			v[5] = i < streams.normalZ.size() ? streams.normalZ[i] : 0.0f;
+		}
+
+		writeStorageBuffer(buffer.descriptorSet, "BindPose", buffer.bindPose, bindPose.data(), bindPose.size() * sizeof(float));
+	}
+
+	void
+	ForwardSkinning::updatePose(SkinnedBuffer& buffer, const skelecton::SkinningData& data) noexcept(false)
+	{
+		float zero = 0.0f;
+
+		writeStorageBuffer(buffer.descriptorSet, "Joints", buffer.joints, data.joints.data(), data.joints.size() * sizeof(math::float4x4));
+
+		if (data.morphWeights.empty())
+			writeStorageBuffer(buffer.descriptorSet, "MorphWeights", buffer.morphWeights, &zero, sizeof(float));
+		else
+			writeStorageBuffer(buffer.descriptorSet, "MorphWeights", buffer.morphWeights, data.morphWeights.data(), data.morphWeights.size() * sizeof(float));
+	}
+}
@@ -17,6 +17,7 @@
 #include <octoon/material/mesh_standard_material.h>
 
 #include <octoon/runtime/except.h>
+#include <octoon/runtime/profiler.h>
 
 #include "rtx_manager.h"
 #include "offline_renderer.h"
@@ -45,9 +46,15 @@ namespace octoon::video
 	{
 		context_ = context;
 		depthMaterial_ = material::MeshDepthMaterial::create();
-		montecarlo_ = std::make_unique<MonteCarlo>(w, h);
-		montecarlo_->setGraphicsContext(context);
-		rtxManager_ = std::make_unique<RtxManager>();
+
+		// The path tracers need OpenCL and GL interop, a null device only ever renders forward.
+		if (context->getDevice()->getDeviceDesc().getDeviceType() != GraphicsDeviceType::Null)
+		{
+			montecarlo_ = std::make_unique<MonteCarlo>(w, h);
+			montecarlo_->setGraphicsContext(context);
+			rtxManager_ = std::make_unique<RtxManager>();
+		}
+
 		forwardRenderer_ = std::make_unique<ForwardRenderer>(context);
 
 		this->setFramebufferSize(w, h);
@@ -59,6 +66,7 @@ namespace octoon::video
 		this->profile_.reset();
 		this->buffers_.clear();
 		this->materials_.clear();
+		this->programCache_.clear();
 		currentBuffer_.reset();
 		context_.reset();
 	}
@@ -88,6 +96,56 @@ namespace octoon::video
 		return this->forwardRenderer_->getFramebuffer();
 	}
 
+	CullingStatistics
+	Renderer::getCullingStatistics() const noexcept
+	{
+		auto statistics = this->culling_.getStatistics();
+
+		if (this->forwardRenderer_)
+		{
+			auto forward = this->forwardRenderer_->getCullingStatistics();
+			statistics.tested += forward.tested;
+			statistics.culled += forward.culled;
+			statistics.skippedDraws += forward.skippedDraws;
+		}
+
+		return statistics;
+	}
+
+	RenderQueueStatistics
+	Renderer::getRenderQueueStatistics() const noexcept
+	{
+		if (this->forwardRenderer_)
+			return this->forwardRenderer_->getRenderQueueStatistics();
+		return RenderQueueStatistics{};
+	}
+
+	float
+	Renderer::getSkinningValidationError() const noexcept
+	{
+		if (this->forwardRenderer_)
+			return this->forwardRenderer_->getSkinningValidationError();
+		return -1.0f;
+	}
+
+	void
+	Renderer::setProgramCacheDirectory(std::string_view path) noexcept
+	{
+		this->programCache_.setDirectory(path);
+	}
+
+	const std::string&
+	Renderer::getProgramCacheDirectory() const noexcept
+	{
+		return this->programCache_.getDirectory();
+	}
+
+	const ProgramCacheStatistics&
+	Renderer::getProgramCacheStatistics() const noexcept
+	{
+		return this->programCache_.getStatistics();
+	}
+
 	void
 	Renderer::setSortObjects(bool sortObject) noexcept
 	{
@@ -172,6 +230,12 @@ namespace octoon::video
 		return this->context_->getDevice()->createProgram(desc);
 	}
 
+	GraphicsProgramPtr
+	Renderer::createProgram(const std::string& vertexShader, const std::string& fragmentShader) noexcept
+	{
+		return this->programCache_.getProgram(this->context_->getDevice(), vertexShader, fragmentShader);
+	}
+
 	GraphicsStatePtr
 	Renderer::createRenderState(const GraphicsStateDesc& desc) noexcept
 	{
@@ -297,6 +361,9 @@ namespace octoon::video
 				}
 			}
 
+			if (faceCount > 0)
+				this->culling_.cull(*camera, geometries, this->shadowCasters_);
+
 			for (std::uint32_t face = 0; face < faceCount; face++)
 			{
 				auto framebuffer = camera->getFramebuffer();
@@ -305,7 +372,7 @@ namespace octoon::video
 				this->context_->clearFramebuffer(0, camera->getClearFlags(), camera->getClearColor(), 1.0f, 0);
 				this->context_->setViewport(0, camera->getPixelViewport());
 
-				for (auto& geometry : geometries)
+				for (auto& geometry : this->shadowCasters_)
 				{
 					if (geometry->getMaterial()->getPrimitiveType() == this->depthMaterial_->getPrimitiveType())
 						this->renderObject(*geometry, *camera, this->depthMaterial_);
@@ -331,6 +398,8 @@ namespace octoon::video
 	void
 	Renderer::render(RenderScene& scene) noexcept
 	{
+		OCTOON_PROFILE_ZONE("Renderer::render");
+
 		if (this->sortObjects_)
 		{
 			scene.sortCameras();
@@ -357,7 +426,7 @@ namespace octoon::video
 			if (this->sortObjects_)
 				scene.sortGeometries();
 
-			if (this->enableGlobalIllumination_)
+			if (this->enableGlobalIllumination_ && this->rtxManager_)
 			{
 #if 1
 				this->rtxManager_->render(&scene);
@@ -413,8 +482,11 @@ namespace octoon::video
 			auto& buffer = buffers_[((std::intptr_t)mesh.get())];
 			if (!buffer)
 				buffer = std::make_shared<ForwardBuffer>(mesh);
+			else
+				buffer->update();
 
-			this->context_->setVertexBufferData(0, buffer->getVertexBuffer(), 0);
+			this->context_->setVertexBufferData(0, buffer->getVertexBuffer(), buffer->getVertexOffset());
+			this->context_->setVertexBufferData(1, buffer->getTexcoordBuffer(), 0);
 			this->context_->setIndexBufferData(buffer->getIndexBuffer(subset), 0, hal::GraphicsIndexType::UInt32);
 
 			this->currentBuffer_ = buffer;
@@ -3,6 +3,9 @@
 #include <octoon/solver_component.h>
 #include <octoon/timer_feature.h>
 #include <octoon/rigidbody_component.h>
+#include <octoon/game_object_manager.h>
+
+#include <limits>
 
 namespace octoon
 {
@@ -11,7 +14,12 @@ namespace octoon
 	AnimatorComponent::AnimatorComponent() noexcept
 		: enableAnimation_(true)
 		, enableAnimOnVisableOnly_(false)
+		, writeAccess_(GameAccess::None)
+		, writeAccessRevision_(std::numeric_limits<std::size_t>::max())
 	{
+		posesState_.finish = false;
+		posesState_.time = 0.0f;
+		posesState_.timeLength = 0.0f;
 	}
 
 	AnimatorComponent::AnimatorComponent(animation::Animation<float>&& animation, GameObjects&& avatar) noexcept
@@ -45,13 +53,13 @@ namespace octoon
 	AnimatorComponent::AnimatorComponent(animation::Animation<float>&& animation) noexcept
 		: AnimatorComponent()
 	{
-		animation_ = std::move(animation);
+		this->setAnimation(std::move(animation));
 	}
 
 	AnimatorComponent::AnimatorComponent(const animation::Animation<float>& animation) noexcept
 		: AnimatorComponent()
 	{
-		animation_ = animation;
+		this->setAnimation(animation);
 	}
 
 	AnimatorComponent::AnimatorComponent(GameObjects&& avatar) noexcept
@@ -97,20 +105,29 @@ namespace octoon
 	void
 	AnimatorComponent::setTime(float time) noexcept
 	{
-		animation_.setTime(time);
+		if (this->isBaked())
+		{
+			auto last = posesState_.time;
+			posesState_.time = time;
+			posesState_.finish = last >= posesState_.timeLength && time >= posesState_.timeLength;
+		}
+		else
+		{
+			compiled_.setTime(time);
+		}
 	}
 
 	float
 	AnimatorComponent::getTime() const noexcept
 	{
-		return animation_.getTime();
+		return this->getCurrentAnimatorStateInfo().time;
 	}
 
 	void
 	AnimatorComponent::sample(float delta) noexcept
 	{
 		if (delta != 0.0f)
-			animation_.evaluate(delta);
+			this->setTime(this->getTime() + delta);
 
 		if (!avatar_.empty())
 		{
@@ -124,8 +141,7 @@ namespace octoon
 					if (rigidbody)
 					{
 						auto transform = child->getComponent<octoon::TransformComponent>();
-						rigidbody->movePosition(transform->getTranslate());
-						rigidbody->rotation(transform->getQuaternion());
+						rigidbody->movePositionAndRotation(transform->getTranslate(), transform->getQuaternion());
 					}
 				}
 			}
@@ -140,7 +156,7 @@ namespace octoon
 	AnimatorComponent::evaluate(float delta) noexcept
 	{
 		if (delta != 0.0f)
-			animation_.evaluate(delta);
+			this->setTime(this->getTime() + delta);
 
 		if (!avatar_.empty())
 			this->updateAvatar();
@@ -152,12 +168,16 @@ namespace octoon
 	AnimatorComponent::setAnimation(animation::Animation<float>&& clips) noexcept
 	{
 		animation_ = std::move(clips);
+		compiled_.compile(animation_);
+		this->updateClipBones();
 	}
 
 	void
 	AnimatorComponent::setAnimation(const animation::Animation<float>& clips) noexcept
 	{
 		animation_ = clips;
+		compiled_.compile(animation_);
+		this->updateClipBones();
 	}
 
 	const animation::Animation<float>&
@@ -189,7 +209,90 @@ namespace octoon
 	const animation::AnimatorStateInfo<float>&
 	AnimatorComponent::getCurrentAnimatorStateInfo() const noexcept
 	{
-		return animation_.state;
+		return this->isBaked() ? posesState_ : compiled_.state;
+	}
+
+	void
+	AnimatorComponent::bake(float frameRate) noexcept
+	{
+		if (avatar_.empty() || frameRate <= 0.0f)
+			return;
+
+		this->clearPoseBuffer();
+
+		std::vector<std::shared_ptr<CCDSolverComponent>> solvers;
+		for (auto& bone : avatar_)
+		{
+			auto solver = bone->getComponent<CCDSolverComponent>();
+			if (solver && solver->getActive())
+				solvers.push_back(std::move(solver));
+		}
+
+		CCDSolverSchedule schedule(solvers);
+
+		auto numFrames = static_cast<std::size_t>(std::ceil(compiled_.state.timeLength * frameRate)) + 1;
+
+		animation::PoseBuffer poses(avatar_.size(), frameRate);
+		posesTranslate_.resize(avatar_.size());
+		posesRotation_.resize(avatar_.size());
+
+		// Frames are evaluated in order, so the IK solvers start each frame from the previous result as they do during playback.
+		for (std::size_t frame = 0; frame < numFrames; frame++)
+		{
+			compiled_.setTime(frame / frameRate);
+
+			this->updateAvatarCurves();
+
+			schedule.solve();
+
+			for (std::size_t i = 0; i < avatar_.size(); i++)
+			{
+				auto transform = avatar_[i]->getComponent<TransformComponent>();
+				posesTranslate_[i] = transform->getLocalTranslate();
+				posesRotation_[i] = transform->getLocalQuaternion();
+			}
+
+			poses.addFrame(posesTranslate_.data(), posesRotation_.data());
+		}
+
+		compiled_.setTime(0.0f);
+
+		this->setPoseBuffer(std::move(poses));
+	}
+
+	bool
+	AnimatorComponent::isBaked() const noexcept
+	{
+		return !poses_.empty() && poses_.getNumBones() == avatar_.size();
+	}
+
+	void
+	AnimatorComponent::setPoseBuffer(animation::PoseBuffer&& poses) noexcept
+	{
+		poses_ = std::move(poses);
+		posesState_.finish = false;
+		posesState_.time = 0.0f;
+		posesState_.timeLength = poses_.getTimeLength();
+		this->setSolverActive(!this->isBaked());
+	}
+
+	void
+	AnimatorComponent::setPoseBuffer(const animation::PoseBuffer& poses) noexcept
+	{
+		this->setPoseBuffer(animation::PoseBuffer(poses));
+	}
+
+	const animation::PoseBuffer&
+	AnimatorComponent::getPoseBuffer() const noexcept
+	{
+		return poses_;
+	}
+
+	void
+	AnimatorComponent::clearPoseBuffer() noexcept
+	{
+		if (!poses_.empty())
+			this->setPoseBuffer(animation::PoseBuffer());
 	}
 
 	GameComponentPtr
@@ -199,19 +302,44 @@ namespace octoon
 		instance->setName(this->getName());
 		instance->setAvatar(this->getAvatar());
 		instance->setAnimation(this->getAnimation());
+		instance->setPoseBuffer(this->getPoseBuffer());
 
 		return instance;
 	}
 
+	GameAccessFlags
+	AnimatorComponent::getReadAccess() const noexcept
+	{
+		return GameAccess::None;
+	}
+
+	GameAccessFlags
+	AnimatorComponent::getWriteAccess() const noexcept
+	{
+		if (writeAccessRevision_ != GameObjectManager::instance()->getHierarchyRevision())
+			this->updateWriteAccess();
+
+		return writeAccess_;
+	}
+
+	void
+	AnimatorComponent::getLinkedObjects(GameObjectRaws& objects) const noexcept
+	{
+		for (auto& bone : avatar_)
+			objects.push_back(bone.get());
+	}
+
 	void 
 	AnimatorComponent::onActivate() except
 	{
+		this->setSolverScheduled(true);
 	}
 
 	void
 	AnimatorComponent::onDeactivate() noexcept
 	{
 		this->removeComponentDispatch(GameDispatchType::FixedUpdate);
+		this->setSolverScheduled(false);
 	}
 
 	void
@@ -224,7 +352,7 @@ namespace octoon
 			{
 				auto delta = timeFeature->getTimeInterval();
 				if (delta != 0.0f)
-					animation_.evaluate(delta);
+					this->setTime(this->getTime() + delta);
 
 				if (!avatar_.empty())
 					this->updateAvatar();
@@ -234,13 +362,153 @@ namespace octoon
 		}
 	}
 
+	void
+	AnimatorComponent::onLateUpdate() noexcept
+	{
+		auto timeFeature = this->getFeature<TimerFeature>();
+		solvers_.update(timeFeature ? timeFeature->delta() : 0.0f);
+	}
+
+	void
+	AnimatorComponent::updateWriteAccess() const noexcept
+	{
+		writeAccess_ = GameAccess::None;
+		writeAccessRevision_ = GameObjectManager::instance()->getHierarchyRevision();
+
+		// Kinematic bodies follow the objects they hang from, moving those writes to the physics scene.
+		if (!avatar_.empty())
+		{
+			for (auto& bone : avatar_)
+			{
+				for (auto& child : bone->getChildren())
+				{
+					if (child->getComponent<RigidbodyComponent>())
+					{
+						writeAccess_ = GameAccess::Physics;
+						return;
+					}
+				}
+			}
+		}
+		else
+		{
+			auto object = this->getGameObject();
+			if (object && (object->getComponent<RigidbodyComponent>() || object->getComponentInChildren<RigidbodyComponent>()))
+				writeAccess_ = GameAccess::Physics;
+		}
+	}
+
 	void
 	AnimatorComponent::onAttachAvatar(const GameObjects& avatar) noexcept
 	{
 		bindpose_.resize(avatar.size());
+		hierarchy_.setObjects(avatar);
+		this->updateWriteAccess();
+
+		this->updateClipBones();
+
+		auto object = this->getGameObject();
+		if (object && object->getActive() && this->getActive())
+			this->setSolverScheduled(true);
 
 		for (std::size_t i = 0; i < avatar.size(); i++)
 			bindpose_[i] = avatar[i]->getComponent<TransformComponent>()->getLocalTranslate();
+
+		if (!poses_.empty())
+			this->setSolverActive(!this->isBaked());
+	}
+
+	bool
+	AnimatorComponent::hasEulerBinding(const animation::CompiledAnimation<float>::Clip& clip) const noexcept
+	{
+		return
+			compiled_.hasBinding(clip, animation::AnimationBinding::LocalEulerAnglesRawX) ||
+			compiled_.hasBinding(clip, animation::AnimationBinding::LocalEulerAnglesRawY) ||
+			compiled_.hasBinding(clip, animation::AnimationBinding::LocalEulerAnglesRawZ);
+	}
+
+	void
+	AnimatorComponent::updateClipBones() noexcept
+	{
+		std::unordered_map<std::string_view, std::size_t> bones;
+		for (std::size_t i = 0; i < avatar_.size(); i++)
+			bones.emplace(avatar_[i]->getName(), i);
+
+		// Unnamed clips keep binding to the bone of the same index, named ones without a matching bone are not played.
+		clipBones_.resize(compiled_.clips.size());
+
+		for (std::size_t i = 0; i < clipBones_.size(); i++)
+		{
+			auto& name = animation_.clips[i].name;
+			if (name.empty())
+			{
+				clipBones_[i] = i < avatar_.size() ? i : std::string::npos;
+			}
+			else
+			{
+				auto it = bones.find(name);
+				clipBones_[i] = it != bones.end() ? it->second : std::string::npos;
+			}
+		}
+	}
+
+	void
+	AnimatorComponent::setSolverActive(bool active) noexcept
+	{
+		// Only the solvers switched off here are switched on again, those the user had deactivated stay so.
+		if (active)
+		{
+			for (auto& it : suspendedSolvers_)
+			{
+				auto solver = it.lock();
+				if (solver)
+					solver->setActive(true);
+			}
+
+			suspendedSolvers_.clear();
+		}
+		else
+		{
+			for (auto& bone : avatar_)
+			{
+				auto solver = bone->getComponent<CCDSolverComponent>();
+				if (solver && solver->getActive())
+				{
+					solver->setActive(false);
+					suspendedSolvers_.push_back(solver);
+				}
+			}
+		}
+	}
+
+	void
+	AnimatorComponent::setSolverScheduled(bool scheduled) noexcept
+	{
+		for (auto& solver : solvers_.getSolvers())
+			solver->setScheduled(false);
+
+		solvers_.clear();
+
+		if (scheduled)
+		{
+			std::vector<std::shared_ptr<CCDSolverComponent>> solvers;
+			for (auto& bone : avatar_)
+			{
+				auto solver = bone->getComponent<CCDSolverComponent>();
+				if (solver)
+				{
+					solver->setScheduled(true);
+					solvers.push_back(std::move(solver));
+				}
+			}
+
+			solvers_.setSolvers(solvers);
+		}
+
+		if (solvers_.empty())
+			this->tryRemoveComponentDispatch(GameDispatchType::LateUpdate);
+		else
+			this->tryAddComponentDispatch(GameDispatchType::LateUpdate);
 	}
 
 	void
@@ -249,103 +517,130 @@ namespace octoon
 		if (this->getCurrentAnimatorStateInfo().finish)
 			return;
 
-		for (std::size_t i = 0; i < animation_.clips.size(); i++)
+		if (this->isBaked())
+			this->updateAvatarPoses();
+		else
+			this->updateAvatarCurves();
+
+		this->sendMessage("octoon:animation:update");
+	}
+
+	void
+	AnimatorComponent::updateAvatarPoses() noexcept
+	{
+		posesTranslate_.resize(avatar_.size());
+		posesRotation_.resize(avatar_.size());
+
+		poses_.sample(posesState_.time, posesTranslate_.data(), posesRotation_.data());
+
+		for (std::size_t i = 0; i < avatar_.size(); i++)
 		{
-			auto transform = avatar_[i]->getComponent<TransformComponent>();
+			hierarchy_.setLocalTranslate(i, posesTranslate_[i]);
+			hierarchy_.setLocalQuaternion(i, posesRotation_[i]);
+		}
 
-			auto scale = transform->getLocalScale();
-			auto quat = transform->getLocalQuaternion();
-			auto translate = transform->getLocalTranslate();
-			auto euler = math::eulerAngles(quat);
+		hierarchy_.update();
+	}
+
+	void
+	AnimatorComponent::updateAvatarCurves() noexcept
+	{
+		// Picks up bones moved by IK, rotation links or physics since the last frame.
+		hierarchy_.fetch();
+
+		for (std::size_t index = 0; index < compiled_.clips.size(); index++)
+		{
+			auto& clip = compiled_.clips[index];
+			if (clip.count == 0 && clip.rotationCount == 0)
+				continue;
+
+			auto i = clipBones_[index];
+			if (i == std::string::npos)
+				continue;
+
+			auto scale = hierarchy_.getLocalScale(i);
+			auto quat = clip.rotationCount > 0 ? compiled_.rotations[clip.rotationFirst] : hierarchy_.getLocalQuaternion(i);
+			auto translate = hierarchy_.getLocalTranslate(i);
+			auto eulerBinding = this->hasEulerBinding(clip);
+			auto euler = eulerBinding ? math::eulerAngles(quat) : math::float3::Zero;
 
-			for (auto& curve : animation_.clips[i].curves)
+			for (std::uint32_t n = clip.first; n < clip.first + clip.count; n++)
 			{
-				if (curve.first == "LocalPosition.x")
-					translate.x = curve.second.value + bindpose_[i].x;
-				else if (curve.first == "LocalPosition.y")
-					translate.y = curve.second.value + bindpose_[i].y;
-				else if (curve.first == "LocalPosition.z")
-					translate.z = curve.second.value + bindpose_[i].z;
-				else if (curve.first == "LocalScale.x")
-					scale.x = curve.second.value;
-				else if (curve.first == "LocalScale.y")
-					scale.y = curve.second.value;
-				else if (curve.first == "LocalScale.z")
-					scale.z = curve.second.value;
-				else if (curve.first == "LocalRotation.x")
-					quat.x = curve.second.value;
-				else if (curve.first == "LocalRotation.y")
-					quat.y = curve.second.value;
-				else if (curve.first == "LocalRotation.z")
-					quat.z = curve.second.value;
-				else if (curve.first == "LocalRotation.w")
-					quat.w = curve.second.value;
-				else if (curve.first == "LocalEulerAnglesRaw.x")
-					euler.x = curve.second.value;
-				else if (curve.first == "LocalEulerAnglesRaw.y")
-					euler.y = curve.second.value;
-				else if (curve.first == "LocalEulerAnglesRaw.z")
-					euler.z = curve.second.value;
+				auto value = compiled_.values[n];
+
+				switch (compiled_.channels[n].binding)
+				{
+				case animation::AnimationBinding::LocalPositionX: translate.x = value + bindpose_[i].x; break;
+				case animation::AnimationBinding::LocalPositionY: translate.y = value + bindpose_[i].y; break;
+				case animation::AnimationBinding::LocalPositionZ: translate.z = value + bindpose_[i].z; break;
+				case animation::AnimationBinding::LocalScaleX: scale.x = value; break;
+				case animation::AnimationBinding::LocalScaleY: scale.y = value; break;
+				case animation::AnimationBinding::LocalScaleZ: scale.z = value; break;
+				case animation::AnimationBinding::LocalRotationX: quat.x = value; break;
+				case animation::AnimationBinding::LocalRotationY: quat.y = value; break;
+				case animation::AnimationBinding::LocalRotationZ: quat.z = value; break;
+				case animation::AnimationBinding::LocalRotationW: quat.w = value; break;
+				case animation::AnimationBinding::LocalEulerAnglesRawX: euler.x = value; break;
+				case animation::AnimationBinding::LocalEulerAnglesRawY: euler.y = value; break;
+				case animation::AnimationBinding::LocalEulerAnglesRawZ: euler.z = value; break;
+				default:
+					break;
+				}
 			}
 
-			transform->setLocalScale(scale);
-			transform->setLocalTranslate(translate);
-			transform->setLocalQuaternion(math::Quaternion(euler));
+			hierarchy_.setLocalScale(i, scale);
+			hierarchy_.setLocalTranslate(i, translate);
+			hierarchy_.setLocalQuaternion(i, eulerBinding ? math::Quaternion(euler) : quat);
 		}
 
-		this->sendMessage("octoon:animation:update");
+		hierarchy_.update();
 	}
 
 	void
 	AnimatorComponent::updateAnimation(float delta) noexcept
 	{
-		for (auto& clip : animation_.clips)
+		auto transform = this->getComponent<TransformComponent>();
+
+		for (auto& clip : compiled_.clips)
 		{
-			if (clip.finish)
+			if (clip.finish || (clip.count == 0 && clip.rotationCount == 0))
 				continue;
 
-			auto transform = this->getComponent<TransformComponent>();
 			auto scale = transform->getLocalScale();
-			auto quat = transform->getLocalQuaternion();
+			auto quat = clip.rotationCount > 0 ? compiled_.rotations[clip.rotationFirst] : transform->getLocalQuaternion();
 			auto translate = transform->getLocalTranslate();
-			auto euler = math::eulerAngles(quat);
+			auto eulerBinding = this->hasEulerBinding(clip);
+			auto euler = eulerBinding ? math::eulerAngles(quat) : math::float3::Zero;
 			auto move = 0.0f;
 
-			for (auto& curve : clip.curves)
+			for (std::uint32_t n = clip.first; n < clip.first + clip.count; n++)
 			{
-				if (curve.first == "LocalScale.x")
-					scale.x = curve.second.value;
-				else if (curve.first == "LocalScale.y")
-					scale.y = curve.second.value;
-				else if (curve.first == "LocalScale.z")
-					scale.z = curve.second.value;
-				else if (curve.first == "LocalPosition.x")
-					translate.x = curve.second.value;
-				else if (curve.first == "LocalPosition.y")
-					translate.y = curve.second.value;
-				else if (curve.first == "LocalPosition.z")
-					translate.z = curve.second.value;
-				else if (curve.first == "LocalRotation.x")
-					quat.x = curve.second.value;
-				else if (curve.first == "LocalRotation.y")
-					quat.y = curve.second.value;
-				else if (curve.first == "LocalRotation.z")
-					quat.z = curve.second.value;
-				else if (curve.first == "LocalRotation.w")
-					quat.w = curve.second.value;
-				else if (curve.first == "LocalEulerAnglesRaw.x")
-					euler.x = curve.second.value;
-				else if (curve.first == "LocalEulerAnglesRaw.y")
-					euler.y = curve.second.value;
-				else if (curve.first == "LocalEulerAnglesRaw.z")
-					euler.z = curve.second.value;
-				else if (curve.first == "Transform:move")
-					move = curve.second.value;
-				else
-					this->sendMessage(curve.first, curve.second.value);
+				auto& channel = compiled_.channels[n];
+				auto value = compiled_.values[n];
+
+				switch (channel.binding)
+				{
+				case animation::AnimationBinding::LocalPositionX: translate.x = value; break;
+				case animation::AnimationBinding::LocalPositionY: translate.y = value; break;
+				case animation::AnimationBinding::LocalPositionZ: translate.z = value; break;
+				case animation::AnimationBinding::LocalScaleX: scale.x = value; break;
+				case animation::AnimationBinding::LocalScaleY: scale.y = value; break;
+				case animation::AnimationBinding::LocalScaleZ: scale.z = value; break;
+				case animation::AnimationBinding::LocalRotationX: quat.x = value; break;
+				case animation::AnimationBinding::LocalRotationY: quat.y = value; break;
+				case animation::AnimationBinding::LocalRotationZ: quat.z = value; break;
+				case animation::AnimationBinding::LocalRotationW: quat.w = value; break;
+				case animation::AnimationBinding::LocalEulerAnglesRawX: euler.x = value; break;
+				case animation::AnimationBinding::LocalEulerAnglesRawY: euler.y = value; break;
+				case animation::AnimationBinding::LocalEulerAnglesRawZ: euler.z = value; break;
+				case animation::AnimationBinding::TransformMove: move = value; break;
+				default:
+					this->sendMessage(compiled_.names[channel.name], value);
+					break;
+				}
 			}
 
-			auto rotation = math::Quaternion(euler);
+			auto rotation = eulerBinding ? math::Quaternion(euler) : quat;
 
 			transform->setLocalScale(scale);
 			transform->setLocalTranslate(translate + math::rotate(rotation, math::float3::Forward) * move);
@@ -32,8 +32,8 @@ namespace octoon
 
 	ClothFeature::ClothFeature() except
 		: factory_(nullptr)
-		, needUpdate_(false)
 		, timeInterval_(0.02f)
+		, fixedSteps_(0)
 		, iterationCounts_(6)
 		, defaultAllocatorCallback(std::make_unique<physx::PxDefaultAllocator>())
 		, defaultErrorCallback(std::make_unique<physx::PxDefaultErrorCallback>())
@@ -82,7 +82,7 @@ namespace octoon
     void
 	ClothFeature::onFrame() except
     {
-		if (needUpdate_)
+		for (; fixedSteps_ > 0; fixedSteps_--)
 		{
 			for (std::size_t i = 0; i < iterationCounts_; i++)
 			{
@@ -93,8 +93,6 @@ namespace octoon
 					solver_->endSimulation();
 				}
 			}
-
-			needUpdate_ = false;
 		}
     }
 
@@ -110,7 +108,7 @@ namespace octoon
 		{
 			timeInterval_ = std::any_cast<float>(data);
 			if (timeInterval_ > 0.0f)
-				needUpdate_ = true;
+				fixedSteps_++;
 		}
 	}
 
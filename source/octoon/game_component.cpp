@@ -332,6 +332,23 @@ namespace octoon
 		return instantiate(&component);
 	}
 
+	GameAccessFlags
+	GameComponent::getReadAccess() const noexcept
+	{
+		return GameAccess::All;
+	}
+
+	GameAccessFlags
+	GameComponent::getWriteAccess() const noexcept
+	{
+		return GameAccess::All;
+	}
+
+	void
+	GameComponent::getLinkedObjects(GameObjectRaws& objects) const noexcept
+	{
+	}
+
 	void
 	GameComponent::onAttach() except
 	{
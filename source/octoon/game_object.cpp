@@ -3,11 +3,25 @@
 #include <octoon/game_component.h>
 #include <octoon/game_scene_manager.h>
 #include <octoon/transform_component.h>
+#include <octoon/mesh_filter_component.h>
+#if OCTOON_FEATURE_PHYSICS_ENABLE
+#	include <octoon/rigidbody_component.h>
+#endif
 
 namespace octoon
 {
 	OctoonImplementSubClass(GameObject, runtime::RttiInterface, "Object")
 
+	// Types fetched in the inner loops of skinning, IK and physics sync, each owns one of the hot slots of a GameObject.
+	static const runtime::Rtti* HotComponentTypes[] =
+	{
+		&TransformComponent::RTTI,
+		&MeshFilterComponent::RTTI,
+#if OCTOON_FEATURE_PHYSICS_ENABLE
+		&RigidbodyComponent::RTTI,
+#endif
+	};
+
 	GameObject::GameObject() noexcept
 		: active_(true)
 		, layer_(0)
@@ -160,6 +174,8 @@ namespace octoon
 
 			this->getComponent<TransformComponent>()->updateLocalChildren();
 			this->onMoveAfter();
+
+			GameObjectManager::instance()->_changeHierarchy();
 		}
 	}
 
@@ -244,6 +260,8 @@ namespace octoon
 			it.reset();
 
 		children_.clear();
+
+		GameObjectManager::instance()->_changeHierarchy();
 	}
 
 	GameObjectPtr
@@ -313,6 +331,10 @@ namespace octoon
 				component->onAttachComponent(gameComponent);
 
 			components_.push_back(gameComponent);
+
+			this->indexComponent(gameComponent);
+
+			GameObjectManager::instance()->_changeHierarchy();
 		}
 	}
 
@@ -334,23 +356,9 @@ namespace octoon
 	{
 		assert(type);
 
-		auto it = std::find_if(components_.begin(), components_.end(), [type](const GameComponentPtr& it) { return it->isA(type); });
-		if (it != components_.end())
-		{
-			components_.erase(it);
-
-			for (auto& compoent : components_)
-				compoent->onDetachComponent(*it);
-
-			for (auto& component : components_)
-				(*it)->onDetachComponent(component);
-
-			if (this->getActive() && (*it)->getActive())
-				(*it)->onDeactivate();
-
-			(*it)->onDetach();
-			(*it)->_setGameObject(nullptr);
-		}
+		auto component = this->getComponent(type);
+		if (component)
+			this->removeComponent(component);
 	}
 
 	void
@@ -370,6 +378,8 @@ namespace octoon
 		{
 			components_.erase(it);
 
+			this->rebuildComponentIndex();
+
 			for (auto& compoent : components_)
 				compoent->onDetachComponent(gameComponent);
 
@@ -383,6 +393,8 @@ namespace octoon
 			gameComponent->_setGameObject(nullptr);
 
 			this->removeComponentDispatchs(gameComponent.get());
+
+			GameObjectManager::instance()->_changeHierarchy();
 		}
 	}
 
@@ -394,6 +406,8 @@ namespace octoon
 			auto gameComponent = *it;
 			auto nextComponent = components_.erase(it);
 
+			this->rebuildComponentIndex();
+
 			for (auto& compoent : components_)
 				compoent->onDetachComponent(gameComponent);
 
@@ -417,12 +431,16 @@ namespace octoon
 	{
 		assert(type);
 
-		for (auto& it : components_)
+		for (std::size_t i = 0; i < std::size(HotComponentTypes); i++)
 		{
-			if (it->isA(type))
-				return it;
+			if (HotComponentTypes[i] == type)
+				return hotComponents_[i];
 		}
 
+		auto it = componentIndex_.find(type);
+		if (it != componentIndex_.end())
+			return it->second;
+
 		return nullptr;
 	}
 
@@ -457,13 +475,11 @@ namespace octoon
 
 		for (auto& it : children_)
 		{
-			for (auto& component : it->components_)
-			{
-				if (component->isA(type))
-					return component;
-			}
+			auto component = it->getComponent(type);
+			if (component)
+				return component;
 
-			auto component = it->getComponentInChildren(type);
+			component = it->getComponentInChildren(type);
 			if (component)
 				return component;
 		}
@@ -490,7 +506,7 @@ namespace octoon
 					components.push_back(component);
 			}
 
-			it->getComponentInChildren(type);
+			it->getComponentsInChildren(type, components);
 		}
 	}
 
@@ -569,6 +585,34 @@ namespace octoon
 		}
 	}
 
+	void
+	GameObject::indexComponent(const GameComponentPtr& component) noexcept
+	{
+		static_assert(std::size(HotComponentTypes) <= HotComponentSlots);
+
+		// emplace keeps an existing entry, so every type resolves to its first component as the linear scan did.
+		for (auto type = component->rtti(); type; type = type->getParent())
+			componentIndex_.emplace(type, component);
+
+		for (std::size_t i = 0; i < std::size(HotComponentTypes); i++)
+		{
+			if (!hotComponents_[i] && component->isA(HotComponentTypes[i]))
+				hotComponents_[i] = component;
+		}
+	}
+
+	void
+	GameObject::rebuildComponentIndex() noexcept
+	{
+		componentIndex_.clear();
+
+		for (auto& it : hotComponents_)
+			it = nullptr;
+
+		for (auto& it : components_)
+			this->indexComponent(it);
+	}
+
 	void
 	GameObject::removeComponentDispatchs(const GameComponent* component) noexcept
 	{
@@ -722,6 +766,20 @@ namespace octoon
 			it->onLateUpdate();
 	}
 
+	void
+	GameObject::getDispatchAccess(GameDispatchTypes type, GameAccessFlags& reads, GameAccessFlags& writes, GameObjectRaws& objects) const noexcept
+	{
+		if (dispatchComponents_.empty())
+			return;
+
+		for (auto& it : dispatchComponents_[type])
+		{
+			reads |= it->getReadAccess();
+			writes |= it->getWriteAccess();
+			it->getLinkedObjects(objects);
+		}
+	}
+
 	void
 	GameObject::onActivate() except
 	{
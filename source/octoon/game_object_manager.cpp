@@ -1,12 +1,24 @@
 #include <octoon/game_object_manager.h>
 #include <octoon/mesh_filter_component.h>
 #include <octoon/transform_component.h>
+#include <octoon/runtime/job_system.h>
+#include <octoon/runtime/profiler.h>
+
+#include <limits>
 
 namespace octoon
 {
 	OctoonImplementSingleton(GameObjectManager)
 
+	// Access that keeps an object on the main thread, in its place between the groups updated before and after it.
+	constexpr GameAccessFlags ExclusiveAccess = GameAccess::Scene | GameAccess::Physics | GameAccess::MainThread;
+
+	constexpr std::size_t InvalidIndex = std::numeric_limits<std::size_t>::max();
+
 	GameObjectManager::GameObjectManager() noexcept
+		: hasEmptyActors_(false)
+		, parallelDispatch_(true)
+		, hierarchyRevision_(0)
 	{
 	}
 
@@ -48,6 +60,9 @@ namespace octoon
 	void
 	GameObjectManager::_activeObject(GameObject* entity, bool active) noexcept
 	{
+		// Components updated on the worker threads may still add or remove their dispatch.
+		std::lock_guard<std::mutex> guard_lock(activeLock_);
+
 		if (active)
 		{
 			assert(std::find(activeActors_.begin(), activeActors_.end(), entity) == activeActors_.end());
@@ -64,6 +79,12 @@ namespace octoon
 		}
 	}
 
+	void
+	GameObjectManager::_changeHierarchy() noexcept
+	{
+		hierarchyRevision_.fetch_add(1, std::memory_order_relaxed);
+	}
+
 	GameObjectPtr
 	GameObjectManager::find(std::string_view name) noexcept
 	{
@@ -113,34 +134,43 @@ namespace octoon
 			(*it).second.disconnect(listener);
 	}
 
+	void
+	GameObjectManager::setParallelDispatch(bool enable) noexcept
+	{
+		parallelDispatch_ = enable;
+	}
+
+	bool
+	GameObjectManager::getParallelDispatch() const noexcept
+	{
+		return parallelDispatch_;
+	}
+
+	std::size_t
+	GameObjectManager::getHierarchyRevision() const noexcept
+	{
+		return hierarchyRevision_.load(std::memory_order_relaxed);
+	}
+
 	void
 	GameObjectManager::onFixedUpdate() except
 	{
-		for (std::size_t i = 0; i < activeActors_.size(); i++)
-		{
-			if (activeActors_[i])
-				activeActors_[i]->onFixedUpdate();
-		}
+		OCTOON_PROFILE_ZONE("GameObjectManager::onFixedUpdate");
+		this->dispatch(GameDispatchType::FixedUpdate);
 	}
 
 	void
 	GameObjectManager::onUpdate() except
 	{
-		for (std::size_t i = 0; i < activeActors_.size(); i++)
-		{
-			if (activeActors_[i])
-				activeActors_[i]->onUpdate();
-		}
+		OCTOON_PROFILE_ZONE("GameObjectManager::onUpdate");
+		this->dispatch(GameDispatchType::Frame);
 	}
 
 	void
 	GameObjectManager::onLateUpdate() except
 	{
-		for (std::size_t i = 0; i < activeActors_.size(); i++)
-		{
-			if (activeActors_[i])
-				activeActors_[i]->onLateUpdate();
-		}
+		OCTOON_PROFILE_ZONE("GameObjectManager::onLateUpdate");
+		this->dispatch(GameDispatchType::LateUpdate);
 
 		if (hasEmptyActors_)
 		{
@@ -156,6 +186,196 @@ namespace octoon
 		}
 	}
 
+	void
+	GameObjectManager::dispatch(GameDispatchTypes type) except
+	{
+		std::size_t count = 0;
+
+		if (parallelDispatch_ && runtime::JobSystem::instance()->getThreadCount() > 0)
+		{
+			count = activeActors_.size();
+
+			this->buildDispatchNodes(type, count);
+
+			// Objects are walked in order and collected into one group per tree until one of them conflicts with the
+			// groups collected so far. Only objects of different trees with compatible access change their order.
+			for (std::size_t i = 0; i < count; i++)
+			{
+				if (dispatchNodes_[i] == InvalidIndex || !activeActors_[i])
+					continue;
+
+				auto reads = dispatchReads_[i];
+				auto writes = dispatchWrites_[i];
+
+				if ((reads | writes) & ExclusiveAccess)
+				{
+					this->dispatchGroups(type);
+					this->dispatch(activeActors_[i], type);
+					continue;
+				}
+
+				auto node = dispatchNodes_[i];
+				auto index = dispatchGroupIndices_[node];
+
+				for (std::size_t n = 0; n < dispatchGroups_.size(); n++)
+				{
+					auto& group = dispatchGroups_[n];
+					if (n != index && ((writes & (group.reads | group.writes)) || (reads & group.writes)))
+					{
+						this->dispatchGroups(type);
+						index = InvalidIndex;
+						break;
+					}
+				}
+
+				if (index == InvalidIndex)
+				{
+					index = dispatchGroups_.size();
+					dispatchGroupIndices_[node] = index;
+					dispatchGroups_.push_back(DispatchGroup{ node, GameAccess::None, GameAccess::None });
+				}
+
+				auto& group = dispatchGroups_[index];
+				group.reads |= reads;
+				group.writes |= writes;
+				group.actors.push_back(i);
+			}
+
+			this->dispatchGroups(type);
+		}
+
+		// Objects activated by the callbacks are updated in the same pass, as they always were.
+		for (std::size_t i = count; i < activeActors_.size(); i++)
+		{
+			if (activeActors_[i])
+				this->dispatch(activeActors_[i], type);
+		}
+	}
+
+	void
+	GameObjectManager::dispatch(GameObject* actor, GameDispatchTypes type) except
+	{
+		switch (type)
+		{
+		case GameDispatchType::FixedUpdate: actor->onFixedUpdate(); break;
+		case GameDispatchType::Frame: actor->onUpdate(); break;
+		case GameDispatchType::LateUpdate: actor->onLateUpdate(); break;
+		default:
+			assert(false);
+			break;
+		}
+	}
+
+	void
+	GameObjectManager::buildDispatchNodes(GameDispatchTypes type, std::size_t count) noexcept
+	{
+		dispatchGroups_.clear();
+		dispatchRoots_.clear();
+		dispatchParents_.clear();
+		dispatchNodes_.assign(count, InvalidIndex);
+		dispatchReads_.assign(count, GameAccess::None);
+		dispatchWrites_.assign(count, GameAccess::None);
+
+		auto find = [this](std::size_t node)
+		{
+			while (dispatchParents_[node] != node)
+			{
+				dispatchParents_[node] = dispatchParents_[dispatchParents_[node]];
+				node = dispatchParents_[node];
+			}
+
+			return node;
+		};
+
+		auto root = [this, &find](const GameObject* object)
+		{
+			while (object->getParent())
+				object = object->getParent();
+
+			auto it = dispatchRoots_.emplace(object, dispatchParents_.size());
+			if (it.second)
+				dispatchParents_.push_back(it.first->second);
+
+			return find(it.first->second);
+		};
+
+		// Every tree is a node, trees linked by a component are merged into one.
+		for (std::size_t i = 0; i < count; i++)
+		{
+			auto actor = activeActors_[i];
+			if (!actor)
+				continue;
+
+			dispatchLinks_.clear();
+			actor->getDispatchAccess(type, dispatchReads_[i], dispatchWrites_[i], dispatchLinks_);
+
+			auto node = root(actor);
+
+			for (auto& it : dispatchLinks_)
+			{
+				if (!it)
+					continue;
+
+				auto link = root(it);
+				if (link != node)
+				{
+					dispatchParents_[std::max(link, node)] = std::min(link, node);
+					node = std::min(link, node);
+				}
+			}
+
+			dispatchNodes_[i] = node;
+		}
+
+		for (auto& node : dispatchNodes_)
+		{
+			if (node != InvalidIndex)
+				node = find(node);
+		}
+
+		dispatchGroupIndices_.assign(dispatchParents_.size(), InvalidIndex);
+	}
+
+	void
+	GameObjectManager::dispatchGroups(GameDispatchTypes type) except
+	{
+		if (dispatchGroups_.size() == 1)
+		{
+			// Reads the list again for every object, an earlier callback may have deactivated or destroyed it.
+			for (auto index : dispatchGroups_.front().actors)
+			{
+				if (activeActors_[index])
+					this->dispatch(activeActors_[index], type);
+			}
+		}
+		else if (dispatchGroups_.size() > 1)
+		{
+			// The workers may append to the list of active objects, each group takes its objects beforehand.
+			for (auto& group : dispatchGroups_)
+			{
+				for (auto index : group.actors)
+					group.objects.push_back(activeActors_[index]);
+			}
+
+			runtime::JobSystem::instance()->parallelFor(dispatchGroups_.size(), 1, [this, type](std::size_t begin, std::size_t end)
+			{
+				for (std::size_t i = begin; i < end; i++)
+				{
+					for (auto actor : dispatchGroups_[i].objects)
+					{
+						if (actor)
+							this->dispatch(actor, type);
+					}
+				}
+			});
+		}
+
+		for (auto& group : dispatchGroups_)
+			dispatchGroupIndices_[group.node] = InvalidIndex;
+
+		dispatchGroups_.clear();
+	}
+
 	void
 	GameObjectManager::onGui() except
 	{
@@ -3,6 +3,7 @@
 #include <octoon/game_feature.h>
 #include <octoon/game_listener.h>
 #include <octoon/io/json_reader.h>
+#include <octoon/runtime/profiler.h>
 
 namespace octoon
 {
@@ -408,14 +409,41 @@ namespace octoon
 		{
 			if (!isQuitRequest_)
 			{
-				for (auto& it : features_)
-					it->onFrameBegin();
+				auto profiler = runtime::Profiler::instance();
+				profiler->beginFrame();
 
-				for (auto& it : features_)
-					it->onFrame();
+				{
+					OCTOON_PROFILE_ZONE("GameServer::update");
+
+					{
+						OCTOON_PROFILE_ZONE("onFrameBegin");
+						for (auto& it : features_)
+						{
+							OCTOON_PROFILE_ZONE(it->type_name());
+							it->onFrameBegin();
+						}
+					}
+
+					{
+						OCTOON_PROFILE_ZONE("onFrame");
+						for (auto& it : features_)
+						{
+							OCTOON_PROFILE_ZONE(it->type_name());
+							it->onFrame();
+						}
+					}
+
+					{
+						OCTOON_PROFILE_ZONE("onFrameEnd");
+						for (auto& it : features_)
+						{
+							OCTOON_PROFILE_ZONE(it->type_name());
+							it->onFrameEnd();
+						}
+					}
+				}
 
-				for (auto& it : features_)
-					it->onFrameEnd();
+				profiler->endFrame();
 			}
 		}
 		catch (const std::exception& e)
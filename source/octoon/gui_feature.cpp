@@ -11,6 +11,7 @@
 #include <octoon/ui/imgui_system.h>
 
 #include <octoon/runtime/except.h>
+#include <octoon/runtime/profiler.h>
 #include <octoon/hal_feature.h>
 
 #include <octoon/game_object_manager.h>
@@ -25,6 +26,7 @@ namespace octoon
 		, height_(0)
 		, framebuffer_w_(0)
 		, framebuffer_h_(0)
+		, profilerVisible_(false)
 	{
 	}
 
@@ -34,6 +36,7 @@ namespace octoon
 		, height_(h)
 		, framebuffer_w_(framebuffer_w)
 		, framebuffer_h_(framebuffer_h)
+		, profilerVisible_(false)
 	{
 	}
 
@@ -77,6 +80,20 @@ namespace octoon
 		system_->setFramebufferScale(w, h);
 	}
 
+	void
+	GuiFeature::setProfilerVisible(bool visible) noexcept
+	{
+		if (visible)
+			runtime::Profiler::instance()->setEnable(true);
+		profilerVisible_ = visible;
+	}
+
+	bool
+	GuiFeature::getProfilerVisible() const noexcept
+	{
+		return profilerVisible_;
+	}
+
 	void
 	GuiFeature::onActivate() except
 	{
@@ -178,6 +195,9 @@ namespace octoon
 		{
 			GameObjectManager::instance()->onGui();
 
+			if (profilerVisible_)
+				imgui::showProfilerWindow(&profilerVisible_);
+
 			auto graphics = this->getFeature<GraphicsFeature>();
 			if (graphics)
 				system_->render(*graphics->getContext());
@@ -12,6 +12,11 @@ namespace octoon
 		: window_(0)
 		, framebuffer_w_(0)
 		, framebuffer_h_(0)
+#if defined(OCTOON_BUILD_PLATFORM_EMSCRIPTEN)
+		, deviceType_(hal::GraphicsDeviceType::OpenGL20)
+#else
+		, deviceType_(hal::GraphicsDeviceType::OpenGL33)
+#endif
 	{
 	}
 
@@ -19,6 +24,11 @@ namespace octoon
 		: window_(window)
 		, framebuffer_w_(framebuffer_w)
 		, framebuffer_h_(framebuffer_h)
+#if defined(OCTOON_BUILD_PLATFORM_EMSCRIPTEN)
+		, deviceType_(hal::GraphicsDeviceType::OpenGL20)
+#else
+		, deviceType_(hal::GraphicsDeviceType::OpenGL33)
+#endif
 	{
 	}
 
@@ -46,6 +56,19 @@ namespace octoon
 		h = framebuffer_h_;
 	}
 
+	void
+	GraphicsFeature::setDeviceType(hal::GraphicsDeviceType type) noexcept
+	{
+		assert(!device_);
+		deviceType_ = type;
+	}
+
+	hal::GraphicsDeviceType
+	GraphicsFeature::getDeviceType() const noexcept
+	{
+		return deviceType_;
+	}
+
 	const hal::GraphicsDevicePtr&
 	GraphicsFeature::getDevice() const noexcept
 	{
@@ -70,11 +93,7 @@ namespace octoon
 		this->addMessageListener("feature:input:event", std::bind(&GraphicsFeature::onInputEvent, this, std::placeholders::_1));
 
 		hal::GraphicsDeviceDesc deviceDesc;
-#if defined(OCTOON_BUILD_PLATFORM_EMSCRIPTEN)
-		deviceDesc.setDeviceType(hal::GraphicsDeviceType::OpenGL20);
-#else
-		deviceDesc.setDeviceType(hal::GraphicsDeviceType::OpenGL33);
-#endif
+		deviceDesc.setDeviceType(deviceType_);
 
 #if defined(__DEBUG__)
 		deviceDesc.setDebugControl(true);
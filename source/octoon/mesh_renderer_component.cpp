@@ -162,11 +162,24 @@ namespace octoon
 			this->geometry_->setLayer(this->getGameObject()->getLayer());
 	}
 
+	const std::shared_ptr<geometry::Geometry>&
+	MeshRendererComponent::getGeometry() const noexcept
+	{
+		return this->geometry_;
+	}
+
 	void
 	MeshRendererComponent::uploadMeshData(const mesh::MeshPtr& mesh) noexcept
 	{
 		if (mesh)
 		{
+			if (geometry_)
+			{
+				geometry_->setBoundingBox(mesh->getBoundingBoxAll());
+				geometry_->setMesh(mesh);
+				return;
+			}
+
 			geometry_ = std::make_shared<geometry::Geometry>();
 			geometry_->setActive(true);
 			geometry_->setOwnerListener(this);
@@ -1,5 +1,10 @@
 #include <octoon/physics_feature.h>
 #include <octoon/physics/physics_system.h>
+#include <octoon/runtime/profiler.h>
+
+#include <algorithm>
+#include <cassert>
+#include <chrono>
 
 namespace octoon
 {
@@ -8,10 +13,18 @@ namespace octoon
 	PhysicsFeature::PhysicsFeature() except
 		: physics_context(nullptr)
 		, physics_scene(nullptr)
-		, needUpdate_(false)
+		, needFetch_(false)
+		, asyncSimulation_(false)
+		, interpolation_(false)
+		, fixedSteps_(0)
+		, alpha_(0.0f)
 		, iterationCounts_(1)
+		, threadCount_(4)
 		, timeInterval_(0.02f)
+		, simulationTime_(0.0f)
+		, waitTime_(0.0f)
 		, gravity_(0.0f, -9.8f, 0.0f)
+		, kinematicGeneration_(1)
 	{
 	}
 
@@ -45,13 +58,90 @@ namespace octoon
 		return iterationCounts_;
 	}
 
+	void
+	PhysicsFeature::setThreadCount(std::uint32_t count) noexcept
+	{
+		threadCount_ = count;
+	}
+
+	std::uint32_t
+	PhysicsFeature::getThreadCount() const noexcept
+	{
+		return threadCount_;
+	}
+
+	void
+	PhysicsFeature::setAsyncSimulation(bool enable) noexcept
+	{
+		asyncSimulation_ = enable;
+	}
+
+	bool
+	PhysicsFeature::getAsyncSimulation() const noexcept
+	{
+		return asyncSimulation_;
+	}
+
+	std::size_t
+	PhysicsFeature::addKinematicTarget(const physics::PhysicsKinematicTarget& target) noexcept
+	{
+		kinematicTargets_.push_back(target);
+		return kinematicTargets_.size() - 1;
+	}
+
+	physics::PhysicsKinematicTarget&
+	PhysicsFeature::getKinematicTarget(std::size_t slot) noexcept
+	{
+		assert(slot < kinematicTargets_.size());
+		return kinematicTargets_[slot];
+	}
+
+	std::uint32_t
+	PhysicsFeature::getKinematicGeneration() const noexcept
+	{
+		return kinematicGeneration_;
+	}
+
+	void
+	PhysicsFeature::setInterpolation(bool enable) noexcept
+	{
+		interpolation_ = enable;
+		previousPoses_.clear();
+	}
+
+	bool
+	PhysicsFeature::getInterpolation() const noexcept
+	{
+		return interpolation_;
+	}
+
+	float
+	PhysicsFeature::getSimulationTime() const noexcept
+	{
+		return simulationTime_;
+	}
+
+	float
+	PhysicsFeature::getWaitTime() const noexcept
+	{
+		return waitTime_;
+	}
+
+	float
+	PhysicsFeature::getHiddenTime() const noexcept
+	{
+		return std::max(0.0f, simulationTime_ - waitTime_);
+	}
+
     void
 	PhysicsFeature::onActivate() except
     {
 		this->addMessageListener("feature:timer:fixed", std::bind(&PhysicsFeature::onFixedUpdate, this, std::placeholders::_1));
+		this->addMessageListener("feature:timer:interpolate", std::bind(&PhysicsFeature::onInterpolate, this, std::placeholders::_1));
 
 		physics::PhysicsSceneDesc physicsSceneDesc;
 		physicsSceneDesc.gravity = gravity_;
+		physicsSceneDesc.threadCount = threadCount_;
 
 		physics_context = physics::PhysicsSystem::instance()->createContext();
 		physics_scene = physics_context->createScene(physicsSceneDesc);
@@ -61,6 +151,20 @@ namespace octoon
 	PhysicsFeature::onDeactivate() noexcept
     {
 		this->removeMessageListener("feature:timer:fixed", std::bind(&PhysicsFeature::onFixedUpdate, this, std::placeholders::_1));
+		this->removeMessageListener("feature:timer:interpolate", std::bind(&PhysicsFeature::onInterpolate, this, std::placeholders::_1));
+
+		if (needFetch_)
+		{
+			physics_scene->fetchResults();
+			needFetch_ = false;
+		}
+
+		kinematicTargets_.clear();
+		kinematicGeneration_++;
+
+		activePoses_.clear();
+		previousPoses_.clear();
+		fixedSteps_ = 0;
 
 		physics_scene.reset();
 		physics_context.reset();
@@ -74,25 +178,145 @@ namespace octoon
     void
 	PhysicsFeature::onFrameBegin() noexcept
     {
+		simulationTime_ = 0.0f;
+		waitTime_ = 0.0f;
+
+		// The timer sends its fixed steps before this, so the steps due this frame are already counted.
+		// Only the first sub step runs next to the frame, the rest follows in fetchResults().
+		if (asyncSimulation_ && fixedSteps_ > 0 && !needFetch_ && iterationCounts_ > 0)
+		{
+			this->flushKinematicTargets();
+			physics_scene->simulate(timeInterval_ / iterationCounts_);
+			fixedSteps_--;
+			needFetch_ = true;
+		}
     }
 	
     void
 	PhysicsFeature::onFrame() except
     {
-		if (needUpdate_)
+		if (needFetch_)
+		{
+			this->fetchResults();
+		}
+		else if (iterationCounts_ > 0)
 		{
-			for (std::uint8_t i = 0; i < iterationCounts_; i++)
+			auto stepped = fixedSteps_ > 0;
+			this->simulateSteps();
+			this->fetchActivePoses(stepped);
+		}
+		else
+		{
+			fixedSteps_ = 0;
+		}
+    }
+
+	void
+	PhysicsFeature::fetchResults() except
+	{
+		if (!needFetch_)
+			return;
+
+		OCTOON_PROFILE_ZONE("PhysicsFeature::fetchResults");
+
+		auto start = std::chrono::steady_clock::now();
+		physics_scene->fetchResults();
+		waitTime_ += std::chrono::duration<float>(std::chrono::steady_clock::now() - start).count();
+		simulationTime_ += physics_scene->getSimulationTime();
+
+		// Further sub steps depend on the first one, nothing is left to run next to them.
+		for (std::uint32_t i = 1; i < iterationCounts_; i++)
+			this->step();
+
+		needFetch_ = false;
+
+		this->simulateSteps();
+		this->fetchActivePoses(true);
+	}
+
+	void
+	PhysicsFeature::step() except
+	{
+		OCTOON_PROFILE_ZONE("PhysicsFeature::step");
+
+		this->flushKinematicTargets();
+
+		auto start = std::chrono::steady_clock::now();
+		physics_scene->simulate(timeInterval_ / iterationCounts_);
+		physics_scene->fetchResults();
+		waitTime_ += std::chrono::duration<float>(std::chrono::steady_clock::now() - start).count();
+		simulationTime_ += physics_scene->getSimulationTime();
+	}
+
+	void
+	PhysicsFeature::simulateSteps() except
+	{
+		for (; fixedSteps_ > 0; fixedSteps_--)
+		{
+			// The poses before the last step of a frame are the ones interpolated from.
+			if (interpolation_ && fixedSteps_ == 1)
 			{
-				physics_scene->simulate(timeInterval_ / iterationCounts_);
-				physics_scene->fetchResults();
+				physics_scene->fetchActivePoses(activePoses_);
+				std::sort(activePoses_.begin(), activePoses_.end(), [](auto& a, auto& b) { return a.listener < b.listener; });
 			}
 
-			needUpdate_ = false;
+			for (std::uint32_t i = 0; i < iterationCounts_; i++)
+				this->step();
 		}
+	}
 
-		if (iterationCounts_ > 0)
-			physics_scene->fetchFinish();
-    }
+	void
+	PhysicsFeature::flushKinematicTargets() noexcept
+	{
+		if (!kinematicTargets_.empty())
+		{
+			physics_scene->setKinematicTargets(kinematicTargets_.data(), kinematicTargets_.size());
+			kinematicTargets_.clear();
+			kinematicGeneration_++;
+		}
+	}
+
+	void
+	PhysicsFeature::fetchActivePoses(bool stepped) noexcept
+	{
+		OCTOON_PROFILE_ZONE("PhysicsFeature::fetchActivePoses");
+
+		if (!interpolation_)
+		{
+			physics_scene->fetchActivePoses(activePoses_);
+
+			for (auto& it : activePoses_)
+				it.listener->onFetchResult(it.position, it.rotation);
+		}
+		else
+		{
+			// Both buffers are sorted by listener. The previous one is only searched, a listener gone since then is never called.
+			if (stepped)
+				std::swap(previousPoses_, activePoses_);
+
+			physics_scene->fetchActivePoses(activePoses_);
+			std::sort(activePoses_.begin(), activePoses_.end(), [](auto& a, auto& b) { return a.listener < b.listener; });
+
+			auto previous = previousPoses_.begin();
+
+			for (auto& it : activePoses_)
+			{
+				while (previous != previousPoses_.end() && previous->listener < it.listener)
+					++previous;
+
+				if (previous != previousPoses_.end() && previous->listener == it.listener)
+				{
+					auto position = math::lerp(previous->position, it.position, alpha_);
+					auto rotation = math::slerp(previous->rotation, it.rotation, alpha_);
+					it.listener->onFetchResult(position, rotation);
+				}
+				else
+				{
+					it.listener->onFetchResult(it.position, it.rotation);
+				}
+			}
+		}
+	}
 
     void
 	PhysicsFeature::onFrameEnd() noexcept
@@ -106,10 +330,17 @@ namespace octoon
 		{
 			timeInterval_ = std::any_cast<float>(data);
 			if (timeInterval_ > 0.0f)
-				needUpdate_ = true;
+				fixedSteps_++;
 		}
 	}
 
+	void
+	PhysicsFeature::onInterpolate(const std::any& data) noexcept
+	{
+		if (data.type() == typeid(float))
+			alpha_ = std::any_cast<float>(data);
+	}
+
 	std::shared_ptr<physics::PhysicsContext>
 	PhysicsFeature::getContext()
 	{
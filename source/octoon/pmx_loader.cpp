@@ -157,6 +157,7 @@ namespace octoon
 						if (!stream.read((char*)& vertex.weight.weight3, sizeof(vertex.weight.weight3))) return false;
 						if (!stream.read((char*)& vertex.weight.weight4, sizeof(vertex.weight.weight4))) return false;
 					}
+					break;
 					default:
 						return false;
 				}
@@ -636,14 +637,28 @@ namespace octoon
 		float3s normals_;
 		float2s texcoords_;
 		skelecton::VertexWeights weights;
+		skelecton::SkinningModes skinningModes;
+		skelecton::SphericalDeforms sphericalDeforms;
 
 		vertices_.resize(pmx.numVertices);
 		normals_.resize(pmx.numVertices);
 		texcoords_.resize(pmx.numVertices);
 
 		if (pmx.numBones)
+		{
 			weights.resize(pmx.numVertices);
 
+			for (std::size_t i = 0; i < pmx.numVertices; i++)
+			{
+				if (pmx.vertices[i].type == PMX_SDEF || pmx.vertices[i].type == PMX_QDEF)
+				{
+					skinningModes.resize(pmx.numVertices, skelecton::SkinningMode::Linear);
+					sphericalDeforms.resize(pmx.numVertices);
+					break;
+				}
+			}
+		}
+
 		for (std::size_t i = 0; i < pmx.numVertices; i++)
 		{
 			auto& v = pmx.vertices[i];
@@ -665,6 +680,21 @@ namespace octoon
 				weight.bone4 = v.weight.bone4 < pmx.numBones ? v.weight.bone4 : 0;
 
 				weights[i] = weight;
+
+				if (!skinningModes.empty())
+				{
+					if (v.type == PMX_SDEF)
+					{
+						skinningModes[i] = skelecton::SkinningMode::Spherical;
+						sphericalDeforms[i].center = v.weight.SDEF_C;
+						sphericalDeforms[i].r0 = v.weight.SDEF_R0;
+						sphericalDeforms[i].r1 = v.weight.SDEF_R1;
+					}
+					else if (v.type == PMX_QDEF)
+					{
+						skinningModes[i] = skelecton::SkinningMode::DualQuaternion;
+					}
+				}
 			}
 		}
 
@@ -674,6 +704,8 @@ namespace octoon
 		mesh->setNormalArray(std::move(normals_));
 		mesh->setTexcoordArray(std::move(texcoords_));
 		mesh->setWeightArray(std::move(weights));
+		mesh->setSkinningModeArray(std::move(skinningModes));
+		mesh->setSphericalDeformArray(std::move(sphericalDeforms));
 
 		PmxUInt32 startIndices = 0;
 
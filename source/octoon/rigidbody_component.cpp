@@ -24,6 +24,8 @@ namespace octoon
 		, enableCCD_(false)
 		, position_(math::float3::Zero)
 		, rotation_(math::Quaternion::Zero)
+		, kinematicSlot_(0)
+		, kinematicGeneration_(0)
     {
     }
 
@@ -46,9 +48,8 @@ namespace octoon
 	{
 		if (position_ != position)
 		{
-			if (rigidbody_)
-				rigidbody_->setPosition(position);
 			position_ = position;
+			this->updateKinematicTarget();
 		}
 	}
 
@@ -57,9 +58,19 @@ namespace octoon
 	{
 		if (rotation_ != quat)
 		{
-			if (rigidbody_)
-				rigidbody_->setRotation(quat);
 			rotation_ = quat;
+			this->updateKinematicTarget();
+		}
+	}
+
+	void
+	RigidbodyComponent::movePositionAndRotation(const math::float3& position, const math::Quaternion& quat) noexcept
+	{
+		if (position_ != position || rotation_ != quat)
+		{
+			position_ = position;
+			rotation_ = quat;
+			this->updateKinematicTarget();
 		}
 	}
 
@@ -307,6 +318,9 @@ namespace octoon
 		if (rigidbody_)
 		{
 			auto physicsFeature = this->getFeature<PhysicsFeature>();
+			if (physicsFeature && physicsFeature->getKinematicGeneration() == kinematicGeneration_)
+				physicsFeature->getKinematicTarget(kinematicSlot_).rigidbody = nullptr;
+
 			if (physicsFeature && !rigidbody_)
 				physicsFeature->getScene()->removeRigidbody(rigidbody_);
 
@@ -339,6 +353,13 @@ namespace octoon
 
 	void 
 	RigidbodyComponent::onFetchResult() noexcept
+	{
+		if (rigidbody_)
+			this->onFetchResult(rigidbody_->getPosition(), rigidbody_->getRotation());
+	}
+
+	void
+	RigidbodyComponent::onFetchResult(const math::float3& position, const math::Quaternion& rotation) noexcept
 	{
 		if (rigidbody_)
 		{
@@ -348,8 +369,8 @@ namespace octoon
 				auto parent = this->getGameObject()->getParent();
 				if (parent)
 				{
-					this->position_ = rigidbody_->getPosition();
-					this->rotation_ = rigidbody_->getRotation();
+					this->position_ = position;
+					this->rotation_ = rotation;
 					parent->getComponent<TransformComponent>()->setTransform(math::float4x4(this->rotation_, this->position_) * transform->getLocalTransformInverse());
 				}
 			}
@@ -371,7 +392,34 @@ namespace octoon
 			auto transform = this->getComponent<TransformComponent>();
 			rotation_ = transform->getQuaternion();
 			position_ = transform->getTranslate();
-			rigidbody_->setPositionAndRotation(transform->getTranslate(), transform->getQuaternion());
+			this->updateKinematicTarget();
+		}
+	}
+
+	void
+	RigidbodyComponent::updateKinematicTarget() noexcept
+	{
+		if (!rigidbody_)
+			return;
+
+		auto physicsFeature = this->tryGetFeature<PhysicsFeature>();
+		if (physicsFeature)
+		{
+			if (physicsFeature->getKinematicGeneration() == kinematicGeneration_)
+			{
+				auto& target = physicsFeature->getKinematicTarget(kinematicSlot_);
+				target.position = position_;
+				target.rotation = rotation_;
+			}
+			else
+			{
+				kinematicSlot_ = physicsFeature->addKinematicTarget({ rigidbody_.get(), position_, rotation_ });
+				kinematicGeneration_ = physicsFeature->getKinematicGeneration();
+			}
+		}
+		else
+		{
+			rigidbody_->setPositionAndRotation(position_, rotation_);
 		}
 	}
 
@@ -2,6 +2,7 @@
 #include <octoon/skinned_morph_component.h>
 #include <octoon/skinned_texture_component.h>
 #include <octoon/transform_component.h>
+#include <octoon/runtime/profiler.h>
 
 namespace octoon
 {
@@ -12,6 +13,10 @@ namespace octoon
 		, clothEnable_(true)
 		, morphEnable_(true)
 		, textureEnable_(true)
+		, gpuSkinningEnable_(false)
+		, blendDirty_(false)
+		, morphDirty_(false)
+		, skinningData_(std::make_shared<skelecton::SkinningData>())
 	{
 	}
 
@@ -101,36 +106,73 @@ namespace octoon
 		return textureEnable_;
 	}
 
+	void
+	SkinnedMeshRendererComponent::setGpuSkinningEnable(bool enable) noexcept
+	{
+		if (gpuSkinningEnable_ != enable)
+		{
+			gpuSkinningEnable_ = enable;
+			blendDirty_ = true;
+			needUpdate_ = true;
+		}
+	}
+
+	bool
+	SkinnedMeshRendererComponent::getGpuSkinningEnable() const noexcept
+	{
+		return gpuSkinningEnable_;
+	}
+
 	void
 	SkinnedMeshRendererComponent::uploadMeshData(const mesh::MeshPtr& mesh) noexcept
 	{
 		mesh_ = mesh;
 		needUpdate_ = false;
+		this->updateStreamData();
 		this->updateMeshData();
 	}
 
 	void
 	SkinnedMeshRendererComponent::updateMeshData() noexcept
 	{
+		OCTOON_PROFILE_ZONE("SkinnedMeshRendererComponent::updateMeshData");
+
 		if (mesh_)
 		{
-			if (this->skinnedMesh_)
-			{
-				this->skinnedMesh_->setVertexArray(mesh_->getVertexArray());
-				this->skinnedMesh_->setNormalArray(mesh_->getNormalArray());
-			}
-			else
-			{
+			if (!this->skinnedMesh_)
 				skinnedMesh_ = mesh_->clone();
+
+			if (morphDirty_)
+				this->updateMorphStreamData();
+
+			if (blendDirty_)
+			{
+				skinningData_->streams.setVertexArray(mesh_->getVertexArray());
+				skinningData_->positionRevision++;
+				morphWeights_.clear();
+				blendDirty_ = false;
 			}
 
 			this->updateJointData();
 			this->updateClothBlendData();
 			this->updateMorphBlendData();
 			this->updateTextureBlendData();
-			this->updateBoneData();
+
+			if (gpuSkinningEnable_)
+			{
+				skinningData_->poseRevision++;
+			}
+			else
+			{
+				this->updateBoneData();
+				skinnedMesh_->markVertexDirty();
+			}
 
 			MeshRendererComponent::uploadMeshData(skinnedMesh_);
+
+			auto& geometry = this->getGeometry();
+			if (geometry)
+				geometry->setSkinningData(gpuSkinningEnable_ ? skinningData_ : nullptr);
 		}
 		else
 		{
@@ -149,6 +191,19 @@ namespace octoon
 		return instance;
 	}
 
+	GameAccessFlags
+	SkinnedMeshRendererComponent::getReadAccess() const noexcept
+	{
+		return GameAccess::None;
+	}
+
+	GameAccessFlags
+	SkinnedMeshRendererComponent::getWriteAccess() const noexcept
+	{
+		// The fixed update only flags the mesh, skinning itself runs in onPreRender.
+		return GameAccess::None;
+	}
+
 	void
 	SkinnedMeshRendererComponent::onActivate() noexcept
 	{
@@ -162,6 +217,8 @@ namespace octoon
 	{
 		mesh_.reset();
 		skinnedMesh_.reset();
+		skinningData_->streams.clear();
+		skinningData_->morphs.clear();
 		this->removeComponentDispatch(GameDispatchType::FixedUpdate);
 		this->removeMessageListener("octoon:animation:update", std::bind(&SkinnedMeshRendererComponent::onAnimationUpdate, this, std::placeholders::_1));
 		MeshRendererComponent::onDeactivate();
@@ -183,7 +240,10 @@ namespace octoon
 	SkinnedMeshRendererComponent::onAttachComponent(const GameComponentPtr& component) noexcept
 	{
 		if (component->isInstanceOf<SkinnedMorphComponent>())
+		{
 			morphComponents_.push_back(component.get()->downcast<SkinnedMorphComponent>());
+			morphDirty_ = true;
+		}
 		else if (component->isInstanceOf<SkinnedTextureComponent>())
 			textureComponents_.push_back(component.get()->downcast<SkinnedTextureComponent>());
 		else if (component->isInstanceOf<ClothComponent>())
@@ -197,7 +257,10 @@ namespace octoon
 		{
 			auto it = std::find(morphComponents_.begin(), morphComponents_.end(), component.get());
 			if (it != morphComponents_.end())
+			{
 				morphComponents_.erase(it);
+				morphDirty_ = true;
+			}
 		}
 		else if (component->isInstanceOf<SkinnedTextureComponent>())
 		{
@@ -229,63 +292,70 @@ namespace octoon
 		}
 	}
 
+	void
+	SkinnedMeshRendererComponent::updateStreamData() noexcept
+	{
+		auto& streams = skinningData_->streams;
+		streams.clear();
+		morphWeights_.clear();
+		blendDirty_ = false;
+		morphDirty_ = true;
+
+		if (mesh_)
+		{
+			streams.setVertexArray(mesh_->getVertexArray());
+			streams.setNormalArray(mesh_->getNormalArray());
+			streams.setWeightArray(mesh_->getWeightArray());
+			streams.setSkinningModeArray(mesh_->getSkinningModeArray(), mesh_->getSphericalDeformArray());
+		}
+
+		skinningData_->streamRevision++;
+	}
+
+	void
+	SkinnedMeshRendererComponent::updateMorphStreamData() noexcept
+	{
+		std::vector<std::pair<const math::uint1s*, const math::float3s*>> morphs;
+		morphs.reserve(morphComponents_.size());
+
+		for (auto& it : morphComponents_)
+			morphs.emplace_back(&it->getIndices(), &it->getOffsets());
+
+		skinningData_->morphs.setMorphArray(skinningData_->streams.getNumVertices(), morphs);
+		skinningData_->streamRevision++;
+
+		// The streams may still hold offsets of the previous morphs.
+		blendDirty_ |= !morphWeights_.empty();
+		morphDirty_ = false;
+	}
+
 	void
 	SkinnedMeshRendererComponent::updateJointData() noexcept
 	{
-		joints_.resize(skinnedMesh_->getBindposes().size());
+		auto& joints = skinningData_->joints;
+		joints.resize(skinnedMesh_->getBindposes().size());
 
 		auto& bindposes = skinnedMesh_->getBindposes();
 		if (bindposes.size() != transforms_.size())
 		{
-			for (std::size_t i = 0; i < transforms_.size(); ++i)
-				joints_[i].makeIdentity();
+			for (std::size_t i = 0; i < joints.size(); ++i)
+				joints[i].makeIdentity();
 		}
 		else
 		{
 			for (std::size_t i = 0; i < transforms_.size(); ++i)
-				joints_[i] = math::transformMultiply(transforms_[i]->getComponent<TransformComponent>()->getTransform(), bindposes[i]);
+				joints[i] = math::transformMultiply(transforms_[i]->getComponent<TransformComponent>()->getTransform(), bindposes[i]);
 		}
-
-		/*if (!jointData_)
-		{
-			hal::GraphicsDataDesc jointDesc;
-			jointDesc.setStreamSize(sizeof(math::float4x4) * static_cast<std::uint16_t>(joints_.size()));
-			jointDesc.setUsage(hal::GraphicsUsageFlagBits::WriteBit);
-			jointDesc.setType(hal::GraphicsDataType::UniformBuffer);
-
-			jointData_ = video::Renderer::instance()->createGraphicsData(jointDesc);
-		}*/
 	}
 
 	void
 	SkinnedMeshRendererComponent::updateBoneData() noexcept
 	{
-		auto& vertices = skinnedMesh_->getVertexArray();
-		auto& normals = skinnedMesh_->getNormalArray();
-		auto& weights = skinnedMesh_->getWeightArray();
-
-		auto numVertices = skinnedMesh_->getNumVertices();
-
-#		pragma omp parallel for num_threads(4)
-		for (std::int32_t i = 0; i < numVertices; i++)
-		{
-			auto& blend = weights[i];
-
-			math::float3 v = math::float3::Zero;
-			math::float3 n = math::float3::Zero;
-
-			for (std::uint8_t j = 0; j < 4; j++)
-			{
-				auto w = blend.weights[j];
-				if (w == 0.0f)
-					break;
-				v += (joints_[blend.bones[j]] * vertices[i]) * w;
-				n += ((math::float3x3)joints_[blend.bones[j]] * normals[i]) * w;
-			}
+		auto& streams = skinningData_->streams;
+		if (streams.weights.size() != streams.getNumVertices())
+			return;
 
-			vertices[i] = v;
-			normals[i] = n;
-		}
+		skelecton::skinning(skinningData_->joints, streams, skinnedMesh_->getVertexArray(), skinnedMesh_->getNormalArray());
 	}
 
 	void
@@ -293,7 +363,7 @@ namespace octoon
 	{
 		if (clothEnable_)
 		{
-			auto& dstVertices = skinnedMesh_->getVertexArray();
+			auto& streams = skinningData_->streams;
 
 			for (auto& it : clothComponents_)
 			{
@@ -302,7 +372,17 @@ namespace octoon
 
 				std::size_t numIndices = indices.size();
 				for (std::size_t i = 0; i < numIndices; i++)
-					dstVertices[indices[i]] = partices[i].xyz();
+				{
+					streams.positionX[indices[i]] = partices[i].x;
+					streams.positionY[indices[i]] = partices[i].y;
+					streams.positionZ[indices[i]] = partices[i].z;
+				}
+
+				if (numIndices > 0)
+				{
+					skinningData_->positionRevision++;
+					blendDirty_ = true;
+				}
 			}
 		}
 	}
@@ -310,25 +390,29 @@ namespace octoon
 	void
 	SkinnedMeshRendererComponent::updateMorphBlendData() noexcept
 	{
-		if (morphEnable_)
+		auto& weights = skinningData_->morphWeights;
+		weights.resize(morphComponents_.size());
+
+		for (std::size_t i = 0; i < morphComponents_.size(); i++)
 		{
-			auto& dstVertices = skinnedMesh_->getVertexArray();
+			auto control = morphEnable_ ? morphComponents_[i]->getControl() : 0.0f;
+			weights[i] = control > 0.0f ? control : 0.0f;
+		}
 
-			for (auto& it : morphComponents_)
-			{
-				auto control = it->getControl();
-				if (control > 0.0f)
-				{
-					auto& indices = it->getIndices();
-					auto& offsets = it->getOffsets();
+		// The GPU path accumulates the morphs from the weights, only the CPU path writes them into the streams.
+		if (gpuSkinningEnable_ || skinningData_->morphs.empty())
+			return;
 
-					auto numIndices = indices.size();
+		// After a restore the streams hold no morph at all, otherwise they hold the morphs at morphWeights_
+		// and only the vertices of morphs whose weight moved are recomputed. Nothing runs when no weight changed.
+		if (morphWeights_.empty())
+			skelecton::morphing(skinningData_->morphs, weights, skinningData_->streams);
+		else if (morphWeights_ != weights)
+			skelecton::morphing(skinningData_->morphs, weights, morphWeights_, mesh_->getVertexArray(), skinningData_->streams);
+		else
+			return;
 
-					for (std::size_t i = 0; i < numIndices; i++)
-						dstVertices[indices[i]] += offsets[i] * control;
-				}
-			}
-		}
+		morphWeights_ = weights;
 	}
 
 	void
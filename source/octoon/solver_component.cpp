@@ -4,6 +4,11 @@
 #include <octoon/rotation_limit_component.h>
 #include <octoon/rotation_link_component.h>
 #include <octoon/rotation_link_limit_component.h>
+#include <octoon/rigidbody_component.h>
+#include <octoon/game_object_manager.h>
+#include <octoon/runtime/profiler.h>
+
+#include <limits>
 
 namespace octoon
 {
@@ -15,6 +20,9 @@ namespace octoon
 		, time_(0)
 		, timeStep_(0)
 		, enableAxisLimit_(true)
+		, scheduled_(false)
+		, writeAccess_(GameAccess::None)
+		, writeAccessRevision_(std::numeric_limits<std::size_t>::max())
 	{
 	}
 
@@ -41,7 +49,7 @@ namespace octoon
 	{
 		if (target_ != target)
 		{
-			if (target)
+			if (target && !scheduled_)
 				this->tryAddComponentDispatch(GameDispatchType::LateUpdate);
 			else
 				this->tryRemoveComponentDispatch(GameDispatchType::LateUpdate);
@@ -108,24 +116,28 @@ namespace octoon
 	CCDSolverComponent::addBone(GameObjectPtr&& bone) noexcept
 	{
 		bones_.emplace_back(std::move(bone));
+		this->updateWriteAccess();
 	}
 
 	void
 	CCDSolverComponent::addBone(const GameObjectPtr& bone) noexcept
 	{
 		bones_.push_back(bone);
+		this->updateWriteAccess();
 	}
 
 	void
 	CCDSolverComponent::setBones(GameObjects&& bones) noexcept
 	{
 		bones_ = std::move(bones);
+		this->updateWriteAccess();
 	}
 
 	void
 	CCDSolverComponent::setBones(const GameObjects& bones) noexcept
 	{
 		bones_ = bones;
+		this->updateWriteAccess();
 	}
 
 	const GameObjects&
@@ -134,6 +146,26 @@ namespace octoon
 		return bones_;
 	}
 
+	void
+	CCDSolverComponent::setScheduled(bool scheduled) noexcept
+	{
+		if (scheduled_ != scheduled)
+		{
+			if (scheduled)
+				this->tryRemoveComponentDispatch(GameDispatchType::LateUpdate);
+			else if (target_ && this->getActive() && this->getGameObject() && this->getGameObject()->getActive())
+				this->addComponentDispatch(GameDispatchType::LateUpdate);
+
+			scheduled_ = scheduled;
+		}
+	}
+
+	bool
+	CCDSolverComponent::getScheduled() const noexcept
+	{
+		return scheduled_;
+	}
+
 	GameComponentPtr
 	CCDSolverComponent::clone() const noexcept
 	{
@@ -149,10 +181,45 @@ namespace octoon
 		return instance;
 	}
 
+	GameAccessFlags
+	CCDSolverComponent::getReadAccess() const noexcept
+	{
+		return GameAccess::None;
+	}
+
+	GameAccessFlags
+	CCDSolverComponent::getWriteAccess() const noexcept
+	{
+		if (writeAccessRevision_ != GameObjectManager::instance()->getHierarchyRevision())
+			this->updateWriteAccess();
+
+		return writeAccess_;
+	}
+
 	void
-	CCDSolverComponent::onActivate() noexcept
+	CCDSolverComponent::getLinkedObjects(GameObjectRaws& objects) const noexcept
+	{
+		if (target_)
+			objects.push_back(target_.get());
+
+		for (auto& bone : bones_)
+			objects.push_back(bone.get());
+	}
+
+	void
+	CCDSolverComponent::solve() noexcept
 	{
 		if (this->getTarget())
+		{
+			this->evaluateIK();
+			this->evaluateRotationLink();
+		}
+	}
+
+	void
+	CCDSolverComponent::onActivate() noexcept
+	{
+		if (this->getTarget() && !scheduled_)
 			this->addComponentDispatch(GameDispatchType::LateUpdate);
 	}
 
@@ -190,107 +257,115 @@ namespace octoon
 	void
 	CCDSolverComponent::evaluateIK() noexcept
 	{
+		OCTOON_PROFILE_ZONE("CCDSolverComponent::evaluateIK");
+
 		auto end = this->getComponent<TransformComponent>();
 		auto target = this->getTarget()->getComponent<TransformComponent>();
 
+		std::vector<std::pair<std::shared_ptr<TransformComponent>, std::shared_ptr<RotationLimitComponent>>> joints;
+		joints.reserve(bones_.size());
+
+		for (auto& bone : bones_)
+			joints.emplace_back(bone->getComponent<TransformComponent>(), this->enableAxisLimit_ ? bone->getComponent<RotationLimitComponent>() : nullptr);
+
 		for (std::uint32_t i = 0; i < this->getIterations(); i++)
 		{
-			for (auto& bone : bones_)
+			for (auto& [transform, limit] : joints)
 			{
 				auto& jointEnd = end->getTranslate();
 				auto& jointTarget = target->getTranslate();
 				if (math::sqrDistance(jointEnd, jointTarget) < tolerance_)
 					return;
 
-				auto transform = bone->getComponent<TransformComponent>();
-				math::Vector3 localJointEnd = math::rotate(math::inverse(transform->getQuaternion()), jointEnd - transform->getTranslate());
-				math::Vector3 localJointTarget = math::rotate(math::inverse(transform->getQuaternion()), jointTarget - transform->getTranslate());
-
-				localJointEnd = math::normalize(localJointEnd);
-				localJointTarget = math::normalize(localJointTarget);
+				auto inverse = math::inverse(transform->getQuaternion());
+				auto localJointEnd = math::normalize(math::rotate(inverse, jointEnd - transform->getTranslate()));
+				auto localJointTarget = math::normalize(math::rotate(inverse, jointTarget - transform->getTranslate()));
 
-				math::Vector3 axis = math::normalize(math::cross(localJointTarget, localJointEnd));
-
-				if (this->enableAxisLimit_)
-				{
-					auto limit = bone->getComponent<RotationLimitComponent>();
-					if (limit)
-					{
-						auto& low = limit->getMinimumAxis();
-						auto& upper = limit->getMaximumAxis();
-
-						if ((low.x != 0 || upper.x != 0) && low.y == 0 && upper.y == 0 && low.z == 0 && upper.z == 0)
-						{
-							float cosDeltaAngle = localJointTarget.y * localJointEnd.y + localJointTarget.z * localJointEnd.z;
-							float deltaAngle = math::clamp(math::safe_acos(cosDeltaAngle), limit->getMininumAngle(), limit->getMaximumAngle());
+				math::Quaternion rotation;
+				if (rotateJoint(transform->getLocalQuaternion(), localJointEnd, localJointTarget, limit.get(), rotation))
+					transform->setLocalQuaternion(rotation);
+			}
+		}
+	}
 
-							if (std::abs(deltaAngle) > math::EPSILON_E5)
-							{
-								auto spin = transform->getLocalQuaternion() * math::Quaternion(math::float3::UnitX, math::sign(axis.x) * deltaAngle);
-								spin = math::Quaternion(math::float3::UnitX, math::clamp(math::sign(axis.x) * math::angle(spin), low.x, upper.x));
+	bool
+	CCDSolverComponent::rotateJoint(const math::Quaternion& rotation, const math::float3& localJointEnd, const math::float3& localJointTarget, const RotationLimitComponent* limit, math::Quaternion& result) noexcept
+	{
+		math::Vector3 axis = math::normalize(math::cross(localJointTarget, localJointEnd));
 
-								transform->setLocalQuaternion(math::normalize(spin));
-							}
-						}
-						else if ((low.y != 0 || upper.y != 0) && low.x == 0 && upper.x == 0 && low.z == 0 && upper.z == 0)
-						{
-							float cosDeltaAngle = localJointTarget.x * localJointEnd.x + localJointTarget.z * localJointEnd.z;
-							float deltaAngle = math::clamp(math::safe_acos(cosDeltaAngle), limit->getMininumAngle(), limit->getMaximumAngle());
+		if (limit)
+		{
+			auto& low = limit->getMinimumAxis();
+			auto& upper = limit->getMaximumAxis();
 
-							if (std::abs(deltaAngle) > math::EPSILON_E5)
-							{
-								auto spin = transform->getLocalQuaternion() * math::Quaternion(math::float3::UnitY, math::sign(axis.y) * deltaAngle);
-								spin = math::Quaternion(math::float3::UnitY, math::clamp(math::sign(axis.y) * math::angle(spin), low.y, upper.y));
+			if ((low.x != 0 || upper.x != 0) && low.y == 0 && upper.y == 0 && low.z == 0 && upper.z == 0)
+			{
+				float cosDeltaAngle = localJointTarget.y * localJointEnd.y + localJointTarget.z * localJointEnd.z;
+				float deltaAngle = math::clamp(math::safe_acos(cosDeltaAngle), limit->getMininumAngle(), limit->getMaximumAngle());
 
-								transform->setLocalQuaternion(math::normalize(spin));
-							}
-						}
-						else if ((low.z != 0 || upper.z != 0) && low.x == 0 && upper.x == 0 && low.y == 0 && upper.y == 0)
-						{
-							float cosDeltaAngle = localJointTarget.x * localJointEnd.x + localJointTarget.y * localJointEnd.y;
-							float deltaAngle = math::clamp(math::safe_acos(cosDeltaAngle), limit->getMininumAngle(), limit->getMaximumAngle());
+				if (std::abs(deltaAngle) > math::EPSILON_E5)
+				{
+					auto spin = rotation * math::Quaternion(math::float3::UnitX, math::sign(axis.x) * deltaAngle);
+					spin = math::Quaternion(math::float3::UnitX, math::clamp(math::sign(axis.x) * math::angle(spin), low.x, upper.x));
 
-							if (std::abs(deltaAngle) > math::EPSILON_E5)
-							{
-								auto spin = transform->getLocalQuaternion() * math::Quaternion(math::float3::UnitZ, math::sign(axis.z) * deltaAngle);
-								spin = math::Quaternion(math::float3::UnitZ, math::clamp(math::sign(axis.z) * math::angle(spin), low.z, upper.z));
+					result = math::normalize(spin);
+					return true;
+				}
+			}
+			else if ((low.y != 0 || upper.y != 0) && low.x == 0 && upper.x == 0 && low.z == 0 && upper.z == 0)
+			{
+				float cosDeltaAngle = localJointTarget.x * localJointEnd.x + localJointTarget.z * localJointEnd.z;
+				float deltaAngle = math::clamp(math::safe_acos(cosDeltaAngle), limit->getMininumAngle(), limit->getMaximumAngle());
 
-								transform->setLocalQuaternion(math::normalize(spin));
-							}
-						}
-						else
-						{
-							float cosDeltaAngle = math::dot(localJointTarget, localJointEnd);
-							float deltaAngle = math::safe_acos(cosDeltaAngle);
+				if (std::abs(deltaAngle) > math::EPSILON_E5)
+				{
+					auto spin = rotation * math::Quaternion(math::float3::UnitY, math::sign(axis.y) * deltaAngle);
+					spin = math::Quaternion(math::float3::UnitY, math::clamp(math::sign(axis.y) * math::angle(spin), low.y, upper.y));
 
-							if (std::abs(deltaAngle) > math::EPSILON_E5)
-							{
-								auto angle = math::clamp(deltaAngle, limit->getMininumAngle(), limit->getMaximumAngle());
-								auto spin = transform->getLocalQuaternion() * math::Quaternion(axis, angle);
+					result = math::normalize(spin);
+					return true;
+				}
+			}
+			else if ((low.z != 0 || upper.z != 0) && low.x == 0 && upper.x == 0 && low.y == 0 && upper.y == 0)
+			{
+				float cosDeltaAngle = localJointTarget.x * localJointEnd.x + localJointTarget.y * localJointEnd.y;
+				float deltaAngle = math::clamp(math::safe_acos(cosDeltaAngle), limit->getMininumAngle(), limit->getMaximumAngle());
 
-								transform->setLocalQuaternion(math::normalize(spin));
-							}
-						}					
-					}
-					else
-					{
-						float cosDeltaAngle = math::dot(localJointTarget, localJointEnd);
-						float deltaAngle = math::safe_acos(cosDeltaAngle);
+				if (std::abs(deltaAngle) > math::EPSILON_E5)
+				{
+					auto spin = rotation * math::Quaternion(math::float3::UnitZ, math::sign(axis.z) * deltaAngle);
+					spin = math::Quaternion(math::float3::UnitZ, math::clamp(math::sign(axis.z) * math::angle(spin), low.z, upper.z));
 
-						if (std::abs(deltaAngle) > math::EPSILON_E5)
-							transform->setLocalQuaternion(math::normalize(transform->getLocalQuaternion() * math::Quaternion(axis, deltaAngle)));
-					}
+					result = math::normalize(spin);
+					return true;
 				}
-				else
-				{
-					float cosDeltaAngle = math::dot(localJointTarget, localJointEnd);
-					float deltaAngle = math::safe_acos(cosDeltaAngle);
+			}
+			else
+			{
+				float cosDeltaAngle = math::dot(localJointTarget, localJointEnd);
+				float deltaAngle = math::safe_acos(cosDeltaAngle);
 
-					if (std::abs(deltaAngle) > math::EPSILON_E5)
-						transform->setLocalQuaternion(math::normalize(transform->getLocalQuaternion() * math::Quaternion(axis, deltaAngle)));
+				if (std::abs(deltaAngle) > math::EPSILON_E5)
+				{
+					auto angle = math::clamp(deltaAngle, limit->getMininumAngle(), limit->getMaximumAngle());
+					result = math::normalize(rotation * math::Quaternion(axis, angle));
+					return true;
 				}
 			}
 		}
+		else
+		{
+			float cosDeltaAngle = math::dot(localJointTarget, localJointEnd);
+			float deltaAngle = math::safe_acos(cosDeltaAngle);
+
+			if (std::abs(deltaAngle) > math::EPSILON_E5)
+			{
+				result = math::normalize(rotation * math::Quaternion(axis, deltaAngle));
+				return true;
+			}
+		}
+
+		return false;
 	}
 
 	void
@@ -331,4 +406,24 @@ namespace octoon
 			}
 		}
 	}
+
+	void
+	CCDSolverComponent::updateWriteAccess() const noexcept
+	{
+		writeAccess_ = GameAccess::None;
+		writeAccessRevision_ = GameObjectManager::instance()->getHierarchyRevision();
+
+		// Kinematic bodies follow the bones they hang from, rotating those writes to the physics scene.
+		for (auto& bone : bones_)
+		{
+			for (auto& child : bone->getChildren())
+			{
+				if (child->getComponent<RigidbodyComponent>())
+				{
+					writeAccess_ = GameAccess::Physics;
+					return;
+				}
+			}
+		}
+	}
 }
\ No newline at end of file
@@ -0,0 +1,432 @@
+#include <octoon/solver_schedule.h>
+#include <octoon/rotation_link_component.h>
+#include <octoon/runtime/job_system.h>
+#include <octoon/runtime/profiler.h>
+
+#include <algorithm>
+#include <unordered_map>
+
+namespace octoon
+{
+	static void
+	addAncestors(const GameObject* object, std::vector<const GameObject*>& objects) noexcept
+	{
+		for (; object; object = object->getParent())
+			objects.push_back(object);
+	}
+
+	static bool
+	intersects(const std::vector<const GameObject*>& a, const std::vector<const GameObject*>& b) noexcept
+	{
+		auto first = a.begin();
+		auto second = b.begin();
+
+		while (first != a.end() && second != b.end())
+		{
+			if (*first < *second)
+				++first;
+			else if (*second < *first)
+				++second;
+			else
+				return true;
+		}
+
+		return false;
+	}
+
+	static bool
+	isActive(const CCDSolverComponent& solver) noexcept
+	{
+		auto object = solver.getGameObject();
+		return solver.getActive() && object && object->getActive() && solver.getTarget();
+	}
+
+	CCDSolverSchedule::CCDSolverSchedule() noexcept
+	{
+	}
+
+	CCDSolverSchedule::CCDSolverSchedule(const std::vector<std::shared_ptr<CCDSolverComponent>>& solvers) noexcept
+	{
+		this->setSolvers(solvers);
+	}
+
+	CCDSolverSchedule::~CCDSolverSchedule() noexcept
+	{
+	}
+
+	void
+	CCDSolverSchedule::setSolvers(const std::vector<std::shared_ptr<CCDSolverComponent>>& solvers) noexcept
+	{
+		auto copy = solvers;
+
+		this->clear();
+
+		solvers_ = std::move(copy);
+		chains_.resize(solvers_.size());
+
+		std::vector<std::vector<const GameObject*>> reads(solvers_.size());
+		std::vector<std::vector<const GameObject*>> writes(solvers_.size());
+
+		GameObjects joints;
+		std::unordered_map<const GameObject*, std::size_t> jointIndices;
+
+		for (std::size_t i = 0; i < solvers_.size(); i++)
+		{
+			auto& solver = solvers_[i];
+			auto& bones = solver->getBones();
+			auto& target = solver->getTarget();
+			auto object = solver->getGameObject();
+
+			auto& chain = chains_[i];
+			chain.solver = solver.get();
+			chain.object = object;
+			chain.target = target.get();
+			chain.numBones = bones.size();
+			chain.cached = false;
+			chain.due = false;
+			chain.dirty = 0;
+
+			if (!object || !target)
+				continue;
+
+			addAncestors(object, reads[i]);
+			addAncestors(target.get(), reads[i]);
+
+			for (auto& bone : bones)
+			{
+				addAncestors(bone.get(), reads[i]);
+				writes[i].push_back(bone.get());
+
+				auto link = bone->getComponent<RotationLinkComponent>();
+				if (link)
+				{
+					for (auto& it : link->getBones())
+						writes[i].push_back(it.get());
+				}
+			}
+
+			// Walks up from the end until every joint was passed, the nodes in between move with the chain as well.
+			std::vector<const GameObject*> path;
+			std::size_t found = 0;
+
+			for (const GameObject* node = target.get(); node && found < bones.size(); node = node->getParent())
+			{
+				path.push_back(node);
+				found += std::count_if(bones.begin(), bones.end(), [node](const GameObjectPtr& bone) { return bone.get() == node; });
+			}
+
+			std::reverse(path.begin(), path.end());
+
+			chain.cached = !bones.empty() && found == bones.size();
+
+			for (const GameObject* node = object; node && chain.cached; node = node->getParent())
+			{
+				if (std::find(path.begin(), path.end(), node) != path.end())
+					chain.cached = false;
+			}
+
+			for (auto& bone : bones)
+			{
+				auto it = std::find(path.begin(), path.end(), bone.get());
+				if (it == path.end())
+					chain.cached = false;
+				else
+					chain.links.push_back(it - path.begin());
+			}
+
+			if (!chain.cached)
+			{
+				chain.links.clear();
+				continue;
+			}
+
+			auto parent = path.front()->getParent();
+
+			chain.goal = object->getComponent<TransformComponent>();
+			chain.parent = parent ? parent->getComponent<TransformComponent>() : nullptr;
+
+			for (auto& node : path)
+			{
+				chain.nodes.push_back(node->getComponent<TransformComponent>());
+				chain.parentObjects.push_back(node->getParent());
+			}
+
+			for (auto& bone : bones)
+			{
+				auto it = jointIndices.find(bone.get());
+				if (it == jointIndices.end())
+				{
+					it = jointIndices.emplace(bone.get(), joints.size()).first;
+					joints.push_back(bone);
+				}
+
+				chain.indices.push_back(it->second);
+				chain.limits.push_back(bone->getComponent<RotationLimitComponent>());
+			}
+
+			auto count = chain.nodes.size();
+			chain.localTranslates.resize(count);
+			chain.localScales.resize(count);
+			chain.localRotations.resize(count);
+			chain.locals.resize(count);
+			chain.worlds.resize(count);
+			chain.translates.resize(count);
+			chain.rotations.resize(count);
+		}
+
+		// A solver runs after every earlier solver that writes what it reads or reads what it writes.
+		std::vector<std::size_t> levels(solvers_.size(), 0);
+
+		for (std::size_t i = 0; i < solvers_.size(); i++)
+		{
+			std::sort(reads[i].begin(), reads[i].end());
+			std::sort(writes[i].begin(), writes[i].end());
+
+			for (std::size_t j = 0; j < i; j++)
+			{
+				if (intersects(writes[j], reads[i]) || intersects(writes[j], writes[i]) || intersects(reads[j], writes[i]))
+					levels[i] = std::max(levels[i], levels[j] + 1);
+			}
+
+			if (levels_.size() <= levels[i])
+				levels_.resize(levels[i] + 1);
+
+			levels_[levels[i]].push_back(i);
+		}
+
+		pending_.reserve(solvers_.size());
+		hierarchy_.setObjects(joints);
+	}
+
+	const std::vector<std::shared_ptr<CCDSolverComponent>>&
+	CCDSolverSchedule::getSolvers() const noexcept
+	{
+		return solvers_;
+	}
+
+	void
+	CCDSolverSchedule::clear() noexcept
+	{
+		solvers_.clear();
+		chains_.clear();
+		levels_.clear();
+		pending_.clear();
+		hierarchy_.clear();
+	}
+
+	bool
+	CCDSolverSchedule::empty() const noexcept
+	{
+		return solvers_.empty();
+	}
+
+	void
+	CCDSolverSchedule::solve() noexcept
+	{
+		for (auto& chain : chains_)
+			chain.due = chain.solver->getTarget() != nullptr;
+
+		this->solveLevels();
+	}
+
+	void
+	CCDSolverSchedule::update(float delta) noexcept
+	{
+		for (auto& chain : chains_)
+		{
+			auto solver = chain.solver;
+
+			chain.due = false;
+
+			if (!isActive(*solver))
+				continue;
+
+			if (solver->timeStep_ > 0)
+			{
+				solver->time_ += delta;
+
+				if (solver->time_ > solver->timeStep_)
+				{
+					solver->time_ = 0;
+					chain.due = true;
+				}
+			}
+			else
+			{
+				chain.due = true;
+			}
+		}
+
+		this->solveLevels();
+	}
+
+	bool
+	CCDSolverSchedule::validate() const noexcept
+	{
+		for (auto& chain : chains_)
+		{
+			auto solver = chain.solver;
+			if (chain.object != solver->getGameObject() || chain.target != solver->getTarget().get() || chain.numBones != solver->getBones().size())
+				return false;
+
+			for (std::size_t i = 0; i < chain.nodes.size(); i++)
+			{
+				if (chain.nodes[i]->getGameObject()->getParent() != chain.parentObjects[i])
+					return false;
+			}
+		}
+
+		return true;
+	}
+
+	void
+	CCDSolverSchedule::solveLevels() noexcept
+	{
+		OCTOON_PROFILE_ZONE("CCDSolverSchedule::solve");
+
+		if (!this->validate())
+		{
+			auto due = std::vector<bool>(chains_.size());
+			for (std::size_t i = 0; i < chains_.size(); i++)
+				due[i] = chains_[i].due;
+
+			this->setSolvers(solvers_);
+
+			for (std::size_t i = 0; i < chains_.size(); i++)
+				chains_[i].due = due[i];
+		}
+
+		for (auto& level : levels_)
+		{
+			pending_.clear();
+
+			// Reading the components may resolve their world matrices lazily, so loading stays on this thread.
+			for (auto index : level)
+			{
+				auto& chain = chains_[index];
+				if (chain.due && chain.cached)
+				{
+					load(chain);
+					pending_.push_back(&chain);
+				}
+			}
+
+			if (pending_.size() > 1)
+			{
+				runtime::JobSystem::instance()->parallelFor(pending_.size(), 1, [this](std::size_t begin, std::size_t end)
+				{
+					for (std::size_t i = begin; i < end; i++)
+						solveChain(*pending_[i]);
+				});
+			}
+			else if (pending_.size() == 1)
+			{
+				solveChain(*pending_.front());
+			}
+
+			if (!pending_.empty())
+			{
+				hierarchy_.fetch();
+
+				for (auto chain : pending_)
+				{
+					for (std::size_t i = 0; i < chain->links.size(); i++)
+						hierarchy_.setLocalQuaternion(chain->indices[i], chain->localRotations[chain->links[i]]);
+				}
+
+				hierarchy_.update();
+			}
+
+			for (auto index : level)
+			{
+				auto& chain = chains_[index];
+				if (chain.due)
+				{
+					if (!chain.cached)
+						chain.solver->evaluateIK();
+
+					chain.solver->evaluateRotationLink();
+				}
+			}
+		}
+	}
+
+	void
+	CCDSolverSchedule::load(Chain& chain) noexcept
+	{
+		chain.goalTranslate = chain.goal->getTranslate();
+		chain.parentWorld = chain.parent ? chain.parent->getTransform() : math::float4x4::One;
+
+		for (std::size_t i = 0; i < chain.nodes.size(); i++)
+		{
+			auto& transform = chain.nodes[i];
+			chain.localTranslates[i] = transform->getLocalTranslate();
+			chain.localScales[i] = transform->getLocalScale();
+			chain.localRotations[i] = transform->getLocalQuaternion();
+			chain.locals[i] = transform->getLocalTransform();
+			chain.worlds[i] = transform->getTransform();
+			chain.translates[i] = transform->getTranslate();
+			chain.rotations[i] = transform->getQuaternion();
+		}
+
+		chain.dirty = chain.nodes.size();
+	}
+
+	void
+	CCDSolverSchedule::solveChain(Chain& chain) noexcept
+	{
+		auto solver = chain.solver;
+		auto end = chain.nodes.size() - 1;
+
+		for (std::uint32_t i = 0; i < solver->maxIterations_; i++)
+		{
+			for (std::size_t j = 0; j < chain.links.size(); j++)
+			{
+				updateWorlds(chain, end);
+
+				auto& jointEnd = chain.goalTranslate;
+				auto& jointTarget = chain.translates[end];
+				if (math::sqrDistance(jointEnd, jointTarget) < solver->tolerance_)
+					return;
+
+				auto node = chain.links[j];
+				auto inverse = math::inverse(chain.rotations[node]);
+				auto localJointEnd = math::normalize(math::rotate(inverse, jointEnd - chain.translates[node]));
+				auto localJointTarget = math::normalize(math::rotate(inverse, jointTarget - chain.translates[node]));
+
+				math::Quaternion rotation;
+				auto limit = solver->enableAxisLimit_ ? chain.limits[j].get() : nullptr;
+
+				if (CCDSolverComponent::rotateJoint(chain.localRotations[node], localJointEnd, localJointTarget, limit, rotation) && chain.localRotations[node] != rotation)
+				{
+					chain.localRotations[node] = rotation;
+					chain.locals[node].makeTransform(chain.localTranslates[node], rotation, chain.localScales[node]);
+					chain.dirty = std::min(chain.dirty, node);
+				}
+			}
+		}
+	}
+
+	void
+	CCDSolverSchedule::updateWorlds(Chain& chain, std::size_t node) noexcept
+	{
+		// Same products and decomposition as TransformComponent, so the joints see the values the components would return.
+		for (auto i = chain.dirty; i <= node; i++)
+		{
+			if (i > 0 || chain.parent)
+			{
+				math::float3 scale;
+				chain.worlds[i] = math::transformMultiply(i > 0 ? chain.worlds[i - 1] : chain.parentWorld, chain.locals[i]);
+				chain.worlds[i].getTransform(chain.translates[i], chain.rotations[i], scale);
+			}
+			else
+			{
+				chain.worlds[i] = chain.locals[i];
+				chain.translates[i] = chain.localTranslates[i];
+				chain.rotations[i] = chain.localRotations[i];
+			}
+		}
+
+		chain.dirty = std::max(chain.dirty, node + 1);
+	}
+}
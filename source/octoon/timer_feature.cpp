@@ -1,6 +1,8 @@
 ﻿#if defined(OCTOON_FEATURE_TIMER_ENABLE)
 #include <octoon/timer_feature.h>
 
+#include <algorithm>
+
 namespace octoon
 {
 	OctoonImplementSubClass(TimerFeature, GameFeature, "TimerFeature")
@@ -9,6 +11,10 @@ namespace octoon
 		: time_(0.0f)
 		, timeStep_(0.02f)
 		, timeInterval_(0.02f)
+		, delta_(0.0f)
+		, frameDelta_(0.0f)
+		, interpolation_(0.0f)
+		, maxFixedSteps_(4)
 	{
 	}
 
@@ -41,6 +47,36 @@ namespace octoon
 		return timeInterval_;
 	}
 
+	void
+	TimerFeature::setMaxFixedSteps(std::uint32_t count) noexcept
+	{
+		maxFixedSteps_ = count;
+	}
+
+	std::uint32_t
+	TimerFeature::getMaxFixedSteps() const noexcept
+	{
+		return maxFixedSteps_;
+	}
+
+	void
+	TimerFeature::setFrameDelta(float delta) noexcept
+	{
+		frameDelta_ = delta;
+	}
+
+	float
+	TimerFeature::getFrameDelta() const noexcept
+	{
+		return frameDelta_;
+	}
+
+	float
+	TimerFeature::interpolation() const noexcept
+	{
+		return interpolation_;
+	}
+
 	float
 	TimerFeature::fps() const noexcept
 	{
@@ -74,7 +110,7 @@ namespace octoon
 	float
 	TimerFeature::delta() const noexcept
 	{
-		return timeInterval_;
+		return delta_;
 	}
 
 	float
@@ -118,13 +154,31 @@ namespace octoon
 	{
 		timer_->update();
 
-		time_ += timer_->delta();
+		auto frameDelta = frameDelta_ > 0.0f ? frameDelta_ : timer_->delta();
 
-		while (time_ > timeStep_)
+		if (timeStep_ > 0.0f)
 		{
-			this->sendMessage("feature:timer:fixed", timeInterval_);
-			time_  -= timeStep_;
+			// With the frame time limited to maxFixedSteps_ steps and less than one step left over, the loop never runs more often.
+			auto elapsed = std::min(frameDelta, timeStep_ * maxFixedSteps_);
+
+			time_ += elapsed;
+
+			while (time_ >= timeStep_)
+			{
+				this->sendMessage("feature:timer:fixed", timeInterval_);
+				time_ -= timeStep_;
+			}
+
+			delta_ = elapsed * timeInterval_ / timeStep_;
+			interpolation_ = time_ / timeStep_;
 		}
+		else
+		{
+			delta_ = frameDelta;
+			interpolation_ = 0.0f;
+		}
+
+		this->sendMessage("feature:timer:interpolate", interpolation_);
 	}
 }
 #endif
\ No newline at end of file
@@ -404,13 +404,39 @@ namespace octoon
 			this->getGameObject()->onMoveAfter();
 	}
 
+	void
+	TransformComponent::setHierarchyTransform(const math::float3& localTranslate, const math::Quaternion& localRotation, const math::float3& localScale, const math::float4x4& local, const math::float4x4& world, const math::Quaternion& rotation, const math::float3& scale) const noexcept
+	{
+		local_translate_ = localTranslate;
+		local_rotation_ = localRotation;
+		local_scaling_ = localScale;
+		local_transform_ = local;
+		local_transform_inverse_ = math::transformInverse(local);
+		local_need_updates_ = false;
+
+		translate_ = world.getTranslate();
+		rotation_ = rotation;
+		scaling_ = scale;
+		transform_ = world;
+		transform_inverse_ = math::transformInverse(world);
+
+		// Children that belong to the same hierarchy are committed right after and clear the flag again.
+		this->updateLocalChildren();
+		world_need_updates_ = false;
+	}
+
 	void
 	TransformComponent::updateLocalChildren() const noexcept
 	{
 		world_need_updates_ = true;
 
+		// A node with a stale world always has stale descendants, so the walk stops at subtrees that are already flagged.
 		for (auto& it : this->getGameObject()->getChildren())
-			it->getComponent<TransformComponent>()->updateLocalChildren();
+		{
+			auto transform = it->getComponent<TransformComponent>();
+			if (!transform->world_need_updates_)
+				transform->updateLocalChildren();
+		}
 	}
 
 	void
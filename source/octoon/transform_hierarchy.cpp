@@ -0,0 +1,316 @@
+#include <octoon/transform_hierarchy.h>
+
+#include <numeric>
+#include <unordered_map>
+
+namespace octoon
+{
+	TransformHierarchy::TransformHierarchy() noexcept
+		: needUpdates_(false)
+	{
+	}
+
+	TransformHierarchy::TransformHierarchy(const GameObjects& objects) noexcept
+		: TransformHierarchy()
+	{
+		this->setObjects(objects);
+	}
+
+	TransformHierarchy::~TransformHierarchy() noexcept
+	{
+	}
+
+	void
+	TransformHierarchy::setObjects(const GameObjects& objects) noexcept
+	{
+		this->clear();
+
+		objects_ = objects;
+
+		std::unordered_map<const GameObject*, std::size_t> indices;
+		for (std::size_t i = 0; i < objects.size(); i++)
+			indices.emplace(objects[i].get(), i);
+
+		std::vector<std::size_t> depths(objects.size(), 0);
+		for (std::size_t i = 0; i < objects.size(); i++)
+		{
+			for (auto parent = objects[i]->getParent(); parent; parent = parent->getParent())
+				depths[i]++;
+		}
+
+		std::vector<std::size_t> order(objects.size());
+		std::iota(order.begin(), order.end(), 0);
+		std::stable_sort(order.begin(), order.end(), [&](std::size_t a, std::size_t b) { return depths[a] < depths[b]; });
+
+		auto count = objects.size();
+
+		slots_.resize(count);
+		for (std::size_t slot = 0; slot < count; slot++)
+			slots_[order[slot]] = slot;
+
+		transforms_.resize(count);
+		parentObjects_.resize(count);
+		parents_.resize(count, -1);
+		externals_.resize(count);
+		nested_.resize(count, false);
+		localTranslates_.resize(count);
+		localScales_.resize(count);
+		localRotations_.resize(count);
+		locals_.resize(count);
+		scales_.resize(count);
+		rotations_.resize(count);
+		worlds_.resize(count);
+		externalWorlds_.resize(count);
+		dirty_.resize(count, DirtyLocal | DirtyWorld);
+
+		for (std::size_t slot = 0; slot < count; slot++)
+		{
+			auto& object = objects[order[slot]];
+			auto transform = object->getComponent<TransformComponent>();
+
+			auto parent = object->getParent();
+			parentObjects_[slot] = parent;
+
+			if (parent && indices.find(parent) == indices.end())
+				externals_[slot] = parent->getComponent<TransformComponent>();
+
+			for (; parent; parent = parent->getParent())
+			{
+				auto it = indices.find(parent);
+				if (it != indices.end())
+				{
+					parents_[slot] = static_cast<std::int32_t>(slots_[it->second]);
+					break;
+				}
+			}
+
+			nested_[slot] = externals_[slot] && parents_[slot] >= 0;
+
+			localTranslates_[slot] = transform->getLocalTranslate();
+			localScales_[slot] = transform->getLocalScale();
+			localRotations_[slot] = transform->getLocalQuaternion();
+			transforms_[slot] = std::move(transform);
+		}
+
+		needUpdates_ = count > 0;
+	}
+
+	void
+	TransformHierarchy::clear() noexcept
+	{
+		objects_.clear();
+		slots_.clear();
+		transforms_.clear();
+		parentObjects_.clear();
+		parents_.clear();
+		externals_.clear();
+		nested_.clear();
+		localTranslates_.clear();
+		localScales_.clear();
+		localRotations_.clear();
+		locals_.clear();
+		scales_.clear();
+		rotations_.clear();
+		worlds_.clear();
+		externalWorlds_.clear();
+		dirty_.clear();
+		needUpdates_ = false;
+	}
+
+	bool
+	TransformHierarchy::empty() const noexcept
+	{
+		return slots_.empty();
+	}
+
+	std::size_t
+	TransformHierarchy::size() const noexcept
+	{
+		return slots_.size();
+	}
+
+	void
+	TransformHierarchy::setLocalTranslate(std::size_t index, const math::float3& v) noexcept
+	{
+		auto slot = slots_[index];
+		if (localTranslates_[slot] != v)
+		{
+			localTranslates_[slot] = v;
+			this->markLocal(slot);
+		}
+	}
+
+	const math::float3&
+	TransformHierarchy::getLocalTranslate(std::size_t index) const noexcept
+	{
+		return localTranslates_[slots_[index]];
+	}
+
+	void
+	TransformHierarchy::setLocalScale(std::size_t index, const math::float3& v) noexcept
+	{
+		auto slot = slots_[index];
+		if (localScales_[slot] != v)
+		{
+			localScales_[slot] = v;
+			this->markLocal(slot);
+		}
+	}
+
+	const math::float3&
+	TransformHierarchy::getLocalScale(std::size_t index) const noexcept
+	{
+		return localScales_[slots_[index]];
+	}
+
+	void
+	TransformHierarchy::setLocalQuaternion(std::size_t index, const math::Quaternion& quat) noexcept
+	{
+		assert(math::abs(math::length(quat) - 1) < 1e-2f);
+
+		auto slot = slots_[index];
+		if (localRotations_[slot] != quat)
+		{
+			localRotations_[slot] = quat;
+			this->markLocal(slot);
+		}
+	}
+
+	const math::Quaternion&
+	TransformHierarchy::getLocalQuaternion(std::size_t index) const noexcept
+	{
+		return localRotations_[slots_[index]];
+	}
+
+	const math::float4x4&
+	TransformHierarchy::getTransform(std::size_t index) const noexcept
+	{
+		return worlds_[slots_[index]];
+	}
+
+	void
+	TransformHierarchy::fetch() noexcept
+	{
+		for (std::size_t slot = 0; slot < transforms_.size(); slot++)
+		{
+			if (transforms_[slot]->getGameObject()->getParent() != parentObjects_[slot])
+			{
+				GameObjects objects = std::move(objects_);
+				this->setObjects(objects);
+				return;
+			}
+		}
+
+		for (std::size_t slot = 0; slot < transforms_.size(); slot++)
+		{
+			auto& transform = transforms_[slot];
+			auto& translate = transform->getLocalTranslate();
+			auto& scale = transform->getLocalScale();
+			auto& rotation = transform->getLocalQuaternion();
+
+			if (localTranslates_[slot] != translate || localScales_[slot] != scale || localRotations_[slot] != rotation)
+			{
+				localTranslates_[slot] = translate;
+				localScales_[slot] = scale;
+				localRotations_[slot] = rotation;
+				this->markLocal(slot);
+			}
+		}
+	}
+
+	void
+	TransformHierarchy::update() noexcept
+	{
+		auto count = transforms_.size();
+
+		// Parents outside of the store are compared against the world they had on the last update.
+		for (std::size_t slot = 0; slot < count; slot++)
+		{
+			if (externals_[slot])
+			{
+				auto& world = externals_[slot]->getTransform();
+				if (externalWorlds_[slot] != world)
+				{
+					externalWorlds_[slot] = world;
+					dirty_[slot] |= DirtyWorld;
+					needUpdates_ = true;
+				}
+			}
+		}
+
+		if (!needUpdates_)
+			return;
+
+		// Depth order puts every parent before its children, so one pass carries the flags down the whole tree.
+		for (std::size_t slot = 0; slot < count; slot++)
+		{
+			auto parent = parents_[slot];
+			if (parent >= 0 && dirty_[parent])
+				dirty_[slot] |= DirtyWorld;
+		}
+
+		for (std::size_t slot = 0; slot < count; slot++)
+		{
+			auto parent = parents_[slot];
+			if (dirty_[slot] && (parent < 0 || !dirty_[parent]))
+				transforms_[slot]->onMoveBefore();
+		}
+
+		for (std::size_t slot = 0; slot < count; slot++)
+		{
+			if (dirty_[slot] & DirtyLocal)
+				locals_[slot].makeTransform(localTranslates_[slot], localRotations_[slot], localScales_[slot]);
+		}
+
+		for (std::size_t slot = 0; slot < count; slot++)
+		{
+			if (!dirty_[slot])
+				continue;
+
+			auto parent = parents_[slot];
+
+			if (externals_[slot])
+			{
+				// Nested nodes read their parent only now, after the nodes of the store above it have been committed.
+				auto& world = externals_[slot]->getTransform();
+				if (nested_[slot])
+					externalWorlds_[slot] = world;
+
+				worlds_[slot] = math::transformMultiply(world, locals_[slot]);
+				rotations_[slot] = externals_[slot]->getQuaternion() * localRotations_[slot];
+				scales_[slot] = externals_[slot]->getScale() * localScales_[slot];
+			}
+			else if (parent >= 0)
+			{
+				worlds_[slot] = math::transformMultiply(worlds_[parent], locals_[slot]);
+				rotations_[slot] = rotations_[parent] * localRotations_[slot];
+				scales_[slot] = scales_[parent] * localScales_[slot];
+			}
+			else
+			{
+				worlds_[slot] = locals_[slot];
+				rotations_[slot] = localRotations_[slot];
+				scales_[slot] = localScales_[slot];
+			}
+
+			transforms_[slot]->setHierarchyTransform(localTranslates_[slot], localRotations_[slot], localScales_[slot], locals_[slot], worlds_[slot], rotations_[slot], scales_[slot]);
+		}
+
+		for (std::size_t slot = 0; slot < count; slot++)
+		{
+			auto parent = parents_[slot];
+			if (dirty_[slot] && (parent < 0 || !dirty_[parent]))
+				transforms_[slot]->onMoveAfter();
+		}
+
+		std::fill(dirty_.begin(), dirty_.end(), std::uint8_t(0));
+		needUpdates_ = false;
+	}
+
+	void
+	TransformHierarchy::markLocal(std::size_t slot) noexcept
+	{
+		dirty_[slot] |= DirtyLocal | DirtyWorld;
+		needUpdates_ = true;
+	}
+}
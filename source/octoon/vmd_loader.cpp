@@ -4,8 +4,11 @@
 #include <octoon/math/vector4.h>
 #include <octoon/math/quat.h>
 #include <octoon/runtime/except.h>
+#include <octoon/animation/path_interpolator.h>
 #include <iconv.h>
-#include <map>
+#include <cstring>
+#include <string_view>
+#include <unordered_map>
 
 namespace octoon
 {
@@ -94,72 +97,125 @@ namespace octoon
 		std::vector<VMDSelfShadow> SelfShadowLists;
 	};
 
-	std::string sjis2utf8(const std::string& sjis)
+	// Converts the fixed size names of a file between SJIS and UTF-8, the iconv descriptor is opened once per file rather than once per name.
+	class CharsetConverter final
 	{
-		std::size_t in_size = sjis.size();
-		std::size_t out_size = sjis.size() * 2;
-
-		auto inbuf = std::make_unique<char[]>(in_size);
-		auto outbuf = std::make_unique<char[]>(out_size);
-		char* in = inbuf.get();
-		char* out = outbuf.get();
-
-		std::memcpy(in, sjis.c_str(), in_size);
-
-		iconv_t ic = nullptr;
+	public:
+		CharsetConverter(const char* to, const char* from) noexcept
+			: ic_(iconv_open(to, from))
+		{
+		}
 
-		try
+		~CharsetConverter() noexcept
 		{
-			ic = iconv_open("utf-8", "SJIS");
-			iconv(ic, &in, &in_size, &out, &out_size);
-			iconv_close(ic);
+			if (ic_ != (iconv_t)-1)
+				iconv_close(ic_);
 		}
-		catch (const std::exception&)
+
+		std::string operator()(const char* str, std::size_t length) noexcept
 		{
-			iconv_close(ic);
+			length = strnlen(str, length);
+
+			if (ic_ == (iconv_t)-1)
+				return std::string(str, length);
+
+			buffer_.resize(length * 3 + 1);
+
+			auto in = const_cast<char*>(str);
+			auto inSize = length;
+			auto out = buffer_.data();
+			auto outSize = buffer_.size();
+
+			iconv(ic_, nullptr, nullptr, nullptr, nullptr);
+			iconv(ic_, &in, &inSize, &out, &outSize);
+
+			return std::string(buffer_.data(), out);
 		}
 
-		return std::string(outbuf.get());
-	}
+	private:
+		iconv_t ic_;
+		std::vector<char> buffer_;
+	};
 
-	VMDLoader::VMDLoader() noexcept
+	// Keys of a VMD section bucketed by name in a single pass, the order of the names is the order they first appear in.
+	struct VMDTrackTable
 	{
-	}
+		std::vector<std::string_view> names;
+		std::vector<std::uint32_t> offsets;
+		std::vector<std::uint32_t> indices;
+	};
 
-	VMDLoader::~VMDLoader() noexcept
+	template<typename T>
+	static VMDTrackTable groupByName(const std::vector<T>& keys) noexcept
 	{
+		VMDTrackTable table;
+
+		std::unordered_map<std::string_view, std::uint32_t> lookup;
+		std::vector<std::uint32_t> groups(keys.size());
+
+		for (std::size_t i = 0; i < keys.size(); i++)
+		{
+			std::string_view name(keys[i].name, strnlen(keys[i].name, sizeof(keys[i].name)));
+
+			auto it = lookup.emplace(name, static_cast<std::uint32_t>(table.names.size()));
+			if (it.second)
+				table.names.push_back(name);
+
+			groups[i] = it.first->second;
+		}
+
+		table.offsets.assign(table.names.size() + 1, 0);
+		for (auto group : groups)
+			table.offsets[group + 1]++;
+
+		for (std::size_t i = 1; i < table.offsets.size(); i++)
+			table.offsets[i] += table.offsets[i - 1];
+
+		auto cursor = table.offsets;
+
+		table.indices.resize(keys.size());
+		for (std::size_t i = 0; i < keys.size(); i++)
+			table.indices[cursor[groups[i]]++] = static_cast<std::uint32_t>(i);
+
+		return table;
 	}
 
-	bool
-	VMDLoader::doCanRead(io::istream& stream) noexcept
+	// Keys with the same handles share one interpolator.
+	class VMDInterpolatorCache final
 	{
-		static_assert(sizeof(VMDMotion) == 111, "");
-		static_assert(sizeof(VMDMorph) == 23, "");
-		static_assert(sizeof(VMDCamera) == 61, "");
-		static_assert(sizeof(VMDLight) == 28, "");
-		static_assert(sizeof(VMDSelfShadow) == 9, "");
+	public:
+		const std::shared_ptr<animation::PathInterpolator<float>>& get(std::uint8_t x1, std::uint8_t y1, std::uint8_t x2, std::uint8_t y2) noexcept
+		{
+			auto& interpolator = interpolators_[x1 | y1 << 8 | x2 << 16 | y2 << 24];
+			if (!interpolator)
+				interpolator = std::make_shared<animation::PathInterpolator<float>>(x1 / 127.0f, x2 / 127.0f, y1 / 127.0f, y2 / 127.0f);
 
-		VMD_Header hdr;
+			return interpolator;
+		}
 
-		if (stream.read((char*)&hdr, sizeof(hdr)))
+		// Row 0 of the 64 byte block of a bone key holds the X, Y, Z and rotation handles as x1[4], y1[4], x2[4], y2[4],
+		// the other rows repeat it for compatibility with older tools.
+		const std::shared_ptr<animation::PathInterpolator<float>>& getMotion(const VMD_uint8_t interpolation[], std::size_t channel) noexcept
 		{
-			if (std::strncmp(hdr.magic, "Vocaloid Motion Data 0002", 30) == 0)
-				return true;
+			return this->get(interpolation[channel], interpolation[channel + 4], interpolation[channel + 8], interpolation[channel + 12]);
 		}
 
-		return false;
-	}
+		// A camera key stores x1, x2, y1, y2 per channel for X, Y, Z, rotation, distance and viewing angle.
+		const std::shared_ptr<animation::PathInterpolator<float>>& getCamera(const VMD_uint8_t interpolation[], std::size_t channel) noexcept
+		{
+			auto handles = interpolation + channel * 4;
+			return this->get(handles[0], handles[2], handles[1], handles[3]);
+		}
 
-	bool
-	VMDLoader::doCanRead(const char* type) noexcept
-	{
-		return std::strncmp(type, "vmd", 3) == 0;
-	}
+	private:
+		std::unordered_map<std::uint32_t, std::shared_ptr<animation::PathInterpolator<float>>> interpolators_;
+	};
 
-	animation::Animation<float>
-	VMDLoader::load(io::istream& stream) noexcept(false)
+	constexpr float VMDFrameRate = 30.0f;
+
+	static void
+	readVMD(io::istream& stream, VMD& vmd) noexcept(false)
 	{
-		VMD vmd;
 		if (!stream.read((char*)&vmd.Header, sizeof(vmd.Header))) {
 			throw runtime::runtime_error::create(R"(Cannot read property "Header" from stream)");
 		}
@@ -228,38 +284,815 @@ namespace octoon
 				throw runtime::runtime_error::create(R"(Cannot read property "VMDSelfShadow" from stream)");
 			}
 		}
+	}
+
+	static animation::Animation<float>
+	buildMotion(const VMD& vmd, CharsetConverter& converter, VMDInterpolatorCache& interpolators) noexcept
+	{
+		auto tracks = groupByName(vmd.MotionLists);
+
+		animation::Animation animation;
+		animation.setName(converter(vmd.Header.name, sizeof(vmd.Header.name)));
+		animation.clips.reserve(tracks.names.size());
+
+		for (std::size_t i = 0; i < tracks.names.size(); i++)
+		{
+			auto count = tracks.offsets[i + 1] - tracks.offsets[i];
+
+			animation::Keyframes<float> translateX;
+			animation::Keyframes<float> translateY;
+			animation::Keyframes<float> translateZ;
+			animation::Keyframes<math::Quaternion> rotation;
+
+			translateX.reserve(count);
+			translateY.reserve(count);
+			translateZ.reserve(count);
+			rotation.reserve(count);
+
+			for (auto n = tracks.offsets[i]; n < tracks.offsets[i + 1]; n++)
+			{
+				auto& it = vmd.MotionLists[tracks.indices[n]];
+				auto time = it.frame / VMDFrameRate;
+
+				translateX.emplace_back(time, it.location.x, interpolators.getMotion(it.interpolation, 0));
+				translateY.emplace_back(time, it.location.y, interpolators.getMotion(it.interpolation, 1));
+				translateZ.emplace_back(time, it.location.z, interpolators.getMotion(it.interpolation, 2));
+				rotation.emplace_back(time, it.rotate, interpolators.getMotion(it.interpolation, 3));
+			}
+
+			animation::AnimationClip<float> clip(converter(tracks.names[i].data(), tracks.names[i].size()));
+			clip.setCurve("LocalPosition.x", animation::AnimationCurve(std::move(translateX)));
+			clip.setCurve("LocalPosition.y", animation::AnimationCurve(std::move(translateY)));
+			clip.setCurve("LocalPosition.z", animation::AnimationCurve(std::move(translateZ)));
+			clip.setCurve("LocalRotation", animation::AnimationCurve(std::move(rotation)));
+			animation.addClip(std::move(clip));
+		}
+
+		return animation;
+	}
+
+	static animation::Animation<float>
+	buildMorph(const VMD& vmd, CharsetConverter& converter) noexcept
+	{
+		auto tracks = groupByName(vmd.MorphLists);
+
+		animation::AnimationClip<float> clip("Morph");
+
+		for (std::size_t i = 0; i < tracks.names.size(); i++)
+		{
+			animation::Keyframes<float> weights;
+			weights.reserve(tracks.offsets[i + 1] - tracks.offsets[i]);
+
+			for (auto n = tracks.offsets[i]; n < tracks.offsets[i + 1]; n++)
+			{
+				auto& it = vmd.MorphLists[tracks.indices[n]];
+				weights.emplace_back(it.frame / VMDFrameRate, it.weight);
+			}
+
+			clip.setCurve(converter(tracks.names[i].data(), tracks.names[i].size()), animation::AnimationCurve(std::move(weights)));
+		}
+
+		animation::Animation animation;
+		animation.setName(converter(vmd.Header.name, sizeof(vmd.Header.name)));
+		if (!clip.empty())
+			animation.addClip(std::move(clip));
+
+		return animation;
+	}
+
+	static animation::Animation<float>
+	buildCamera(const VMD& vmd, VMDInterpolatorCache& interpolators) noexcept
+	{
+		animation::Keyframes<float> distance;
+		animation::Keyframes<float> eyeX;
+		animation::Keyframes<float> eyeY;
+		animation::Keyframes<float> eyeZ;
+		animation::Keyframes<float> rotationX;
+		animation::Keyframes<float> rotationY;
+		animation::Keyframes<float> rotationZ;
+		animation::Keyframes<float> fov;
+
+		distance.reserve(vmd.CameraLists.size());
+		eyeX.reserve(vmd.CameraLists.size());
+		eyeY.reserve(vmd.CameraLists.size());
+		eyeZ.reserve(vmd.CameraLists.size());
+		rotationX.reserve(vmd.CameraLists.size());
+		rotationY.reserve(vmd.CameraLists.size());
+		rotationZ.reserve(vmd.CameraLists.size());
+		fov.reserve(vmd.CameraLists.size());
+
+		for (auto& it : vmd.CameraLists)
+		{
+			auto time = it.frame / VMDFrameRate;
+
+			eyeX.emplace_back(time, it.location.x, interpolators.getCamera(it.interpolation, 0));
+			eyeY.emplace_back(time, it.location.y, interpolators.getCamera(it.interpolation, 1));
+			eyeZ.emplace_back(time, it.location.z, interpolators.getCamera(it.interpolation, 2));
+			rotationX.emplace_back(time, it.rotation.x, interpolators.getCamera(it.interpolation, 3));
+			rotationY.emplace_back(time, it.rotation.y, interpolators.getCamera(it.interpolation, 3));
+			rotationZ.emplace_back(time, it.rotation.z, interpolators.getCamera(it.interpolation, 3));
+			distance.emplace_back(time, it.length, interpolators.getCamera(it.interpolation, 4));
+			fov.emplace_back(time, (float)it.viewingAngle, interpolators.getCamera(it.interpolation, 5));
+		}
+
+		animation::Animation animation;
+		animation.setName("Camera");
+
+		if (!vmd.CameraLists.empty())
+		{
+			animation::AnimationClip<float> clip("Camera");
+			clip.setCurve("LocalPosition.x", animation::AnimationCurve(std::move(eyeX)));
+			clip.setCurve("LocalPosition.y", animation::AnimationCurve(std::move(eyeY)));
+			clip.setCurve("LocalPosition.z", animation::AnimationCurve(std::move(eyeZ)));
+			clip.setCurve("LocalEulerAnglesRaw.x", animation::AnimationCurve(std::move(rotationX)));
+			clip.setCurve("LocalEulerAnglesRaw.y", animation::AnimationCurve(std::move(rotationY)));
+			clip.setCurve("LocalEulerAnglesRaw.z", animation::AnimationCurve(std::move(rotationZ)));
+			clip.setCurve("Transform:move", animation::AnimationCurve(std::move(distance)));
+			clip.setCurve("Camera:fov", animation::AnimationCurve(std::move(fov)));
+			animation.addClip(std::move(clip));
+		}
+
+		return animation;
+	}
+
+	static animation::Animation<float>
+	buildLight(const VMD& vmd) noexcept
+	{
+		animation::Keyframes<float> colorR;
+		animation::Keyframes<float> colorG;
+		animation::Keyframes<float> colorB;
+		animation::Keyframes<float> directionX;
+		animation::Keyframes<float> directionY;
+		animation::Keyframes<float> directionZ;
 
-		std::map<std::string, animation::AnimationClip<float>> motions;
+		colorR.reserve(vmd.LightLists.size());
+		colorG.reserve(vmd.LightLists.size());
+		colorB.reserve(vmd.LightLists.size());
+		directionX.reserve(vmd.LightLists.size());
+		directionY.reserve(vmd.LightLists.size());
+		directionZ.reserve(vmd.LightLists.size());
 
-		for (auto& it : vmd.MotionLists)
+		for (auto& it : vmd.LightLists)
 		{
-			if (motions.find(it.name) == motions.end())
-				motions[it.name].setName(sjis2utf8(vmd.Header.name));
+			auto time = it.frame / VMDFrameRate;
 
-			auto& clip = motions[it.name];
-			clip.getCurve("Position.X").insert(animation::Keyframe<float, float>((float)it.frame, it.location.x));
-			clip.getCurve("Position.Y").insert(animation::Keyframe<float, float>((float)it.frame, it.location.y));
-			clip.getCurve("Position.Z").insert(animation::Keyframe<float, float>((float)it.frame, it.location.z));
-			clip.getCurve("Rotation.X").insert(animation::Keyframe<float, float>((float)it.frame, it.rotate.x));
-			clip.getCurve("Rotation.Y").insert(animation::Keyframe<float, float>((float)it.frame, it.rotate.y));
-			clip.getCurve("Rotation.Z").insert(animation::Keyframe<float, float>((float)it.frame, it.rotate.z));
-			clip.getCurve("Rotation.W").insert(animation::Keyframe<float, float>((float)it.frame, it.rotate.w));
+			colorR.emplace_back(time, it.rgb.x);
+			colorG.emplace_back(time, it.rgb.y);
+			colorB.emplace_back(time, it.rgb.z);
+			directionX.emplace_back(time, it.location.x);
+			directionY.emplace_back(time, it.location.y);
+			directionZ.emplace_back(time, it.location.z);
 		}
 
 		animation::Animation animation;
-		animation.setName(sjis2utf8(vmd.Header.name));
-		for (auto& it : motions)
-			animation.addClip(it.second);
+		animation.setName("Light");
+
+		if (!vmd.LightLists.empty())
+		{
+			animation::AnimationClip<float> clip("Light");
+			clip.setCurve("Light:color.r", animation::AnimationCurve(std::move(colorR)));
+			clip.setCurve("Light:color.g", animation::AnimationCurve(std::move(colorG)));
+			clip.setCurve("Light:color.b", animation::AnimationCurve(std::move(colorB)));
+			clip.setCurve("Light:direction.x", animation::AnimationCurve(std::move(directionX)));
+			clip.setCurve("Light:direction.y", animation::AnimationCurve(std::move(directionY)));
+			clip.setCurve("Light:direction.z", animation::AnimationCurve(std::move(directionZ)));
+			animation.addClip(std::move(clip));
+		}
+
 		return animation;
 	}
 
+	// Copies a UTF-8 name into a fixed size SJIS field, cutting it on a character boundary when it does not fit.
+	static void
+	encodeName(CharsetConverter& converter, const std::string& name, char* field, std::size_t size) noexcept
+	{
+		auto sjis = converter(name.data(), name.size());
+
+		std::size_t length = 0;
+		while (length < sjis.size())
+		{
+			auto c = static_cast<std::uint8_t>(sjis[length]);
+			auto width = ((c >= 0x81 && c <= 0x9F) || (c >= 0xE0 && c <= 0xFC)) ? 2 : 1;
+			if (length + width > size)
+				break;
+			length += width;
+		}
+
+		std::memset(field, 0, size);
+		std::memcpy(field, sjis.data(), length);
+	}
+
+	static VMD_uint32_t
+	toFrame(float time) noexcept
+	{
+		return static_cast<VMD_uint32_t>(std::lround(std::max(time, 0.0f) * VMDFrameRate));
+	}
+
+	template<typename T>
+	static const animation::AnimationCurve<T>*
+	findCurve(const std::unordered_map<std::string, animation::AnimationCurve<T>>& curves, const char* name) noexcept
+	{
+		auto it = curves.find(name);
+		return it != curves.end() && !it->second.empty() ? &it->second : nullptr;
+	}
+
+	// Frames where at least one of the curves has a key, every record of a track is written at one of these.
+	template<typename T>
+	static void
+	collectFrames(const animation::AnimationCurve<T>* curve, std::vector<VMD_uint32_t>& frames) noexcept
+	{
+		if (curve)
+		{
+			for (auto& key : curve->frames)
+				frames.push_back(toFrame(key.time));
+		}
+	}
+
+	static void
+	uniqueFrames(std::vector<VMD_uint32_t>& frames) noexcept
+	{
+		std::sort(frames.begin(), frames.end());
+		frames.erase(std::unique(frames.begin(), frames.end()), frames.end());
+	}
+
+	// Bezier handles x1, y1, x2, y2 of the segment that ends at the record on this frame, linear by default.
+	struct VMDHandles
+	{
+		VMD_uint8_t x1 = 20;
+		VMD_uint8_t y1 = 20;
+		VMD_uint8_t x2 = 107;
+		VMD_uint8_t y2 = 107;
+
+		bool linear() const noexcept
+		{
+			return x1 == y1 && x2 == y2;
+		}
+	};
+
+	// Polar form of the easing curve from 0 through the handles a and b to 1, blossom(t, t, t) is the curve itself.
+	static float
+	blossom(float a, float b, float t1, float t2, float t3) noexcept
+	{
+		auto p0 = a * t1;
+		auto p1 = a + (b - a) * t1;
+		auto p2 = b + (1.0f - b) * t1;
+
+		auto q0 = p0 + (p1 - p0) * t2;
+		auto q1 = p1 + (p2 - p1) * t2;
+
+		return q0 + (q1 - q0) * t3;
+	}
+
+	static float
+	solveBezier(float xa, float xb, float x) noexcept
+	{
+		float min = 0.0f;
+		float max = 1.0f;
+
+		for (std::size_t n = 0; n < 24; n++)
+		{
+			auto t = (min + max) * 0.5f;
+			if (animation::PathInterpolator<float>::eval(xa, xb, t) < x)
+				min = t;
+			else
+				max = t;
+		}
+
+		return (min + max) * 0.5f;
+	}
+
+	// Handles of the records on the frames prev and frame for one channel. Records are written on the frames of every
+	// channel, so a key segment of this channel may be cut by records of the others. Each piece then gets the handles of
+	// its part of the Bezier curve, so the channel keeps the shape it had rather than turning linear between the pieces.
+	template<typename T>
+	static VMDHandles
+	findHandles(const animation::AnimationCurve<T>* curve, VMD_uint32_t prev, VMD_uint32_t frame) noexcept
+	{
+		VMDHandles handles;
+		if (!curve)
+			return handles;
+
+		auto it = std::lower_bound(curve->frames.begin(), curve->frames.end(), frame, [](const animation::Keyframe<T>& key, VMD_uint32_t frame) { return toFrame(key.time) < frame; });
+		if (it == curve->frames.end())
+			return handles;
+
+		// The value holds before the first key and after the last.
+		auto end = toFrame(it->time);
+		if (it == curve->frames.begin() && end != frame)
+			return handles;
+
+		auto& interpolator = it->interpolator ? it->interpolator : curve->interpolator;
+		auto path = dynamic_cast<const animation::PathInterpolator<float>*>(interpolator.get());
+		if (!path)
+		{
+			// Only Bezier easing can be stored, keep anything else on its own key by marking it as non-linear.
+			if (interpolator)
+				handles.y1 = 0;
+			return handles;
+		}
+
+		float xa, xb, ya, yb;
+		path->getControlPoints(xa, xb, ya, yb);
+
+		auto start = it == curve->frames.begin() ? end : toFrame((it - 1)->time);
+		auto u0 = end > start ? std::clamp((static_cast<float>(prev) - start) / (end - start), 0.0f, 1.0f) : 0.0f;
+		auto u1 = end > start ? (static_cast<float>(frame) - start) / (end - start) : 1.0f;
+
+		if (u0 > 0.0f || u1 < 1.0f)
+		{
+			auto t0 = solveBezier(xa, xb, u0);
+			auto t1 = solveBezier(xa, xb, u1);
+
+			auto x0 = blossom(xa, xb, t0, t0, t0);
+			auto x3 = blossom(xa, xb, t1, t1, t1);
+			auto y0 = blossom(ya, yb, t0, t0, t0);
+			auto y3 = blossom(ya, yb, t1, t1, t1);
+
+			// A piece over which the value does not change is linear whatever its timing.
+			if (x3 - x0 <= 1e-6f || std::abs(y3 - y0) <= 1e-6f)
+				return handles;
+
+			auto pieceXa = (blossom(xa, xb, t0, t0, t1) - x0) / (x3 - x0);
+			auto pieceXb = (blossom(xa, xb, t0, t1, t1) - x0) / (x3 - x0);
+			auto pieceYa = (blossom(ya, yb, t0, t0, t1) - y0) / (y3 - y0);
+			auto pieceYb = (blossom(ya, yb, t0, t1, t1) - y0) / (y3 - y0);
+
+			xa = pieceXa;
+			xb = pieceXb;
+			ya = pieceYa;
+			yb = pieceYb;
+		}
+
+		auto quantize = [](float v) { return static_cast<VMD_uint8_t>(std::clamp(std::lround(v * 127.0f), 0L, 127L)); };
+		handles.x1 = quantize(xa);
+		handles.y1 = quantize(ya);
+		handles.x2 = quantize(xb);
+		handles.y2 = quantize(yb);
+
+		return handles;
+	}
+
+	template<typename T>
+	static T
+	sampleCurve(const animation::AnimationCurve<T>* curve, VMD_uint32_t frame, const T& fallback) noexcept
+	{
+		return curve ? curve->sample(frame / VMDFrameRate) : fallback;
+	}
+
+	// Greedy keyframe reduction. A record is dropped when both segments around it are linear and interpolating between
+	// the last kept record and the next one reproduces every record dropped since within the tolerance.
+	template<typename Record, typename Error>
+	static void
+	reduceRecords(std::vector<Record>& records, float tolerance, Error&& error) noexcept
+	{
+		if (tolerance < 0.0f || records.size() <= 2)
+			return;
+
+		std::vector<Record> reduced;
+		reduced.reserve(records.size());
+		reduced.push_back(records.front());
+
+		std::size_t anchor = 0;
+
+		for (std::size_t i = 1; i + 1 < records.size(); i++)
+		{
+			auto drop = records[i].linear && records[i + 1].linear;
+
+			for (std::size_t k = anchor + 1; drop && k <= i; k++)
+			{
+				auto t = static_cast<float>(records[k].frame - records[anchor].frame) / static_cast<float>(records[i + 1].frame - records[anchor].frame);
+				drop = error(records[anchor], records[i + 1], records[k], t) <= tolerance;
+			}
+
+			if (!drop)
+			{
+				reduced.push_back(records[i]);
+				anchor = i;
+			}
+		}
+
+		reduced.push_back(records.back());
+		records = std::move(reduced);
+	}
+
+	static float
+	angleBetween(const math::Quaternion& a, const math::Quaternion& b) noexcept
+	{
+		return 2.0f * std::acos(std::min(std::abs(math::dot(a, b)), 1.0f));
+	}
+
+	template<typename T>
+	static void
+	writeSection(io::ostream& stream, const std::vector<T>& records, const char* name) noexcept(false)
+	{
+		auto count = static_cast<VMD_uint32_t>(records.size());
+
+		if (!stream.write((char*)&count, sizeof(count)))
+			throw runtime::runtime_error::create(std::string("Cannot write the count of \"") + name + "\" to stream");
+
+		if (count > 0 && !stream.write((char*)records.data(), sizeof(T) * count))
+			throw runtime::runtime_error::create(std::string("Cannot write property \"") + name + "\" to stream");
+	}
+
+	static void
+	writeMotion(io::ostream& stream, const animation::Animation<float>& motion, CharsetConverter& converter, float tolerance) noexcept(false)
+	{
+		struct Record
+		{
+			VMD_uint32_t frame;
+			math::float3 position;
+			math::Quaternion rotation;
+			VMDHandles handles[4];
+			bool linear;
+		};
+
+		std::vector<VMDMotion> motions;
+		std::vector<VMD_uint32_t> frames;
+		std::vector<Record> records;
+
+		for (auto& clip : motion.clips)
+		{
+			const animation::AnimationCurve<float>* position[] = { findCurve(clip.curves, "LocalPosition.x"), findCurve(clip.curves, "LocalPosition.y"), findCurve(clip.curves, "LocalPosition.z") };
+			const animation::AnimationCurve<float>* euler[] = { findCurve(clip.curves, "LocalEulerAnglesRaw.x"), findCurve(clip.curves, "LocalEulerAnglesRaw.y"), findCurve(clip.curves, "LocalEulerAnglesRaw.z") };
+			auto rotation = findCurve(clip.rotations, "LocalRotation");
+
+			frames.clear();
+			for (auto curve : position)
+				collectFrames(curve, frames);
+			for (auto curve : euler)
+				collectFrames(curve, frames);
+			collectFrames(rotation, frames);
+
+			if (frames.empty())
+				continue;
+
+			uniqueFrames(frames);
+
+			records.resize(frames.size());
+
+			for (std::size_t i = 0; i < frames.size(); i++)
+			{
+				auto& record = records[i];
+				auto prev = i > 0 ? frames[i - 1] : frames[i];
+				record.frame = frames[i];
+				record.position = math::float3(sampleCurve(position[0], frames[i], 0.0f), sampleCurve(position[1], frames[i], 0.0f), sampleCurve(position[2], frames[i], 0.0f));
+
+				if (rotation)
+					record.rotation = rotation->sample(frames[i] / VMDFrameRate);
+				else if (euler[0] || euler[1] || euler[2])
+					record.rotation = math::Quaternion(math::float3(sampleCurve(euler[0], frames[i], 0.0f), sampleCurve(euler[1], frames[i], 0.0f), sampleCurve(euler[2], frames[i], 0.0f)));
+				else
+					record.rotation = math::Quaternion(0.0f, 0.0f, 0.0f, 1.0f);
+
+				record.handles[0] = findHandles(position[0], prev, frames[i]);
+				record.handles[1] = findHandles(position[1], prev, frames[i]);
+				record.handles[2] = findHandles(position[2], prev, frames[i]);
+				record.handles[3] = findHandles(rotation, prev, frames[i]);
+				record.linear = record.handles[0].linear() && record.handles[1].linear() && record.handles[2].linear() && record.handles[3].linear();
+			}
+
+			reduceRecords(records, tolerance, [](const Record& a, const Record& b, const Record& r, float t)
+			{
+				auto position = math::distance(math::lerp(a.position, b.position, t), r.position);
+				auto rotation = angleBetween(animation::interpolate(a.rotation, b.rotation, t), r.rotation);
+				return std::max(position, rotation);
+			});
+
+			VMDMotion key;
+			encodeName(converter, clip.name, key.name, sizeof(key.name));
+
+			for (auto& record : records)
+			{
+				key.frame = record.frame;
+				key.location = record.position;
+				key.rotate = record.rotation;
+
+				// Row 0 carries x1[4], y1[4], x2[4], y2[4] for X, Y, Z and rotation, rows 1-3 repeat it shifted by one byte each as MMD writes them.
+				VMD_uint8_t row[16];
+				for (std::size_t channel = 0; channel < 4; channel++)
+				{
+					row[channel] = record.handles[channel].x1;
+					row[channel + 4] = record.handles[channel].y1;
+					row[channel + 8] = record.handles[channel].x2;
+					row[channel + 12] = record.handles[channel].y2;
+				}
+
+				for (std::size_t r = 0; r < 4; r++)
+				{
+					for (std::size_t i = 0; i < 16; i++)
+						key.interpolation[r * 16 + i] = i + r < 16 ? row[i + r] : 0;
+				}
+
+				motions.push_back(key);
+			}
+		}
+
+		writeSection(stream, motions, "VMDMotion");
+	}
+
+	static void
+	writeMorph(io::ostream& stream, const animation::Animation<float>& morph, CharsetConverter& converter, float tolerance) noexcept(false)
+	{
+		struct Record
+		{
+			VMD_uint32_t frame;
+			float weight;
+			bool linear;
+		};
+
+		std::vector<VMDMorph> morphs;
+		std::vector<VMD_uint32_t> frames;
+		std::vector<Record> records;
+
+		for (auto& clip : morph.clips)
+		{
+			for (auto& it : clip.curves)
+			{
+				if (it.second.empty())
+					continue;
+
+				frames.clear();
+				collectFrames(&it.second, frames);
+				uniqueFrames(frames);
+
+				records.resize(frames.size());
+
+				for (std::size_t i = 0; i < frames.size(); i++)
+				{
+					records[i].frame = frames[i];
+					records[i].weight = it.second.sample(frames[i] / VMDFrameRate);
+					records[i].linear = true;
+				}
+
+				reduceRecords(records, tolerance, [](const Record& a, const Record& b, const Record& r, float t)
+				{
+					return std::abs(a.weight + (b.weight - a.weight) * t - r.weight);
+				});
+
+				VMDMorph key;
+				encodeName(converter, it.first, key.name, sizeof(key.name));
+
+				for (auto& record : records)
+				{
+					key.frame = record.frame;
+					key.weight = record.weight;
+					morphs.push_back(key);
+				}
+			}
+		}
+
+		writeSection(stream, morphs, "VMDMorph");
+	}
+
+	static void
+	writeCamera(io::ostream& stream, const animation::Animation<float>& camera, float tolerance) noexcept(false)
+	{
+		struct Record
+		{
+			VMD_uint32_t frame;
+			float distance;
+			math::float3 location;
+			math::float3 rotation;
+			float fov;
+			VMDHandles handles[6];
+			bool linear;
+		};
+
+		std::vector<VMDCamera> cameras;
+		std::vector<VMD_uint32_t> frames;
+		std::vector<Record> records;
+
+		for (auto& clip : camera.clips)
+		{
+			const animation::AnimationCurve<float>* location[] = { findCurve(clip.curves, "LocalPosition.x"), findCurve(clip.curves, "LocalPosition.y"), findCurve(clip.curves, "LocalPosition.z") };
+			const animation::AnimationCurve<float>* rotation[] = { findCurve(clip.curves, "LocalEulerAnglesRaw.x"), findCurve(clip.curves, "LocalEulerAnglesRaw.y"), findCurve(clip.curves, "LocalEulerAnglesRaw.z") };
+			auto distance = findCurve(clip.curves, "Transform:move");
+			auto fov = findCurve(clip.curves, "Camera:fov");
+
+			frames.clear();
+			for (std::size_t i = 0; i < 3; i++)
+			{
+				collectFrames(location[i], frames);
+				collectFrames(rotation[i], frames);
+			}
+			collectFrames(distance, frames);
+			collectFrames(fov, frames);
+
+			if (frames.empty())
+				continue;
+
+			uniqueFrames(frames);
+
+			records.resize(frames.size());
+
+			for (std::size_t i = 0; i < frames.size(); i++)
+			{
+				auto& record = records[i];
+				auto prev = i > 0 ? frames[i - 1] : frames[i];
+				record.frame = frames[i];
+				record.distance = sampleCurve(distance, frames[i], 0.0f);
+				record.location = math::float3(sampleCurve(location[0], frames[i], 0.0f), sampleCurve(location[1], frames[i], 0.0f), sampleCurve(location[2], frames[i], 0.0f));
+				record.rotation = math::float3(sampleCurve(rotation[0], frames[i], 0.0f), sampleCurve(rotation[1], frames[i], 0.0f), sampleCurve(rotation[2], frames[i], 0.0f));
+				record.fov = sampleCurve(fov, frames[i], 30.0f);
+
+				record.handles[0] = findHandles(location[0], prev, frames[i]);
+				record.handles[1] = findHandles(location[1], prev, frames[i]);
+				record.handles[2] = findHandles(location[2], prev, frames[i]);
+				record.handles[3] = findHandles(rotation[0], prev, frames[i]);
+				record.handles[4] = findHandles(distance, prev, frames[i]);
+				record.handles[5] = findHandles(fov, prev, frames[i]);
+
+				record.linear = true;
+				for (auto& handles : record.handles)
+					record.linear &= handles.linear();
+			}
+
+			reduceRecords(records, tolerance, [](const Record& a, const Record& b, const Record& r, float t)
+			{
+				auto error = std::abs(a.distance + (b.distance - a.distance) * t - r.distance);
+				error = std::max(error, std::abs(a.fov + (b.fov - a.fov) * t - r.fov));
+				error = std::max(error, math::distance(math::lerp(a.location, b.location, t), r.location));
+				error = std::max(error, math::distance(math::lerp(a.rotation, b.rotation, t), r.rotation));
+				return error;
+			});
+
+			for (auto& record : records)
+			{
+				VMDCamera key;
+				key.frame = record.frame;
+				key.length = record.distance;
+				key.location = record.location;
+				key.rotation = record.rotation;
+				key.viewingAngle = static_cast<VMD_uint32_t>(std::lround(std::max(record.fov, 0.0f)));
+				key.perspective = 0;
+
+				for (std::size_t channel = 0; channel < 6; channel++)
+				{
+					key.interpolation[channel * 4 + 0] = record.handles[channel].x1;
+					key.interpolation[channel * 4 + 1] = record.handles[channel].x2;
+					key.interpolation[channel * 4 + 2] = record.handles[channel].y1;
+					key.interpolation[channel * 4 + 3] = record.handles[channel].y2;
+				}
+
+				cameras.push_back(key);
+			}
+		}
+
+		writeSection(stream, cameras, "VMDCamera");
+	}
+
+	static void
+	writeLight(io::ostream& stream, const animation::Animation<float>& light, float tolerance) noexcept(false)
+	{
+		struct Record
+		{
+			VMD_uint32_t frame;
+			math::float3 color;
+			math::float3 direction;
+			bool linear;
+		};
+
+		std::vector<VMDLight> lights;
+		std::vector<VMD_uint32_t> frames;
+		std::vector<Record> records;
+
+		for (auto& clip : light.clips)
+		{
+			const animation::AnimationCurve<float>* color[] = { findCurve(clip.curves, "Light:color.r"), findCurve(clip.curves, "Light:color.g"), findCurve(clip.curves, "Light:color.b") };
+			const animation::AnimationCurve<float>* direction[] = { findCurve(clip.curves, "Light:direction.x"), findCurve(clip.curves, "Light:direction.y"), findCurve(clip.curves, "Light:direction.z") };
+
+			frames.clear();
+			for (std::size_t i = 0; i < 3; i++)
+			{
+				collectFrames(color[i], frames);
+				collectFrames(direction[i], frames);
+			}
+
+			if (frames.empty())
+				continue;
+
+			uniqueFrames(frames);
+
+			records.resize(frames.size());
+
+			for (std::size_t i = 0; i < frames.size(); i++)
+			{
+				auto& record = records[i];
+				record.frame = frames[i];
+				record.color = math::float3(sampleCurve(color[0], frames[i], 0.6f), sampleCurve(color[1], frames[i], 0.6f), sampleCurve(color[2], frames[i], 0.6f));
+				record.direction = math::float3(sampleCurve(direction[0], frames[i], -0.5f), sampleCurve(direction[1], frames[i], -1.0f), sampleCurve(direction[2], frames[i], 0.5f));
+				record.linear = true;
+			}
+
+			reduceRecords(records, tolerance, [](const Record& a, const Record& b, const Record& r, float t)
+			{
+				auto error = math::distance(math::lerp(a.color, b.color, t), r.color);
+				return std::max(error, math::distance(math::lerp(a.direction, b.direction, t), r.direction));
+			});
+
+			for (auto& record : records)
+			{
+				VMDLight key;
+				key.frame = record.frame;
+				key.rgb = record.color;
+				key.location = record.direction;
+				lights.push_back(key);
+			}
+		}
+
+		writeSection(stream, lights, "VMDLight");
+	}
+
+	VMDLoader::VMDLoader() noexcept
+	{
+	}
+
+	VMDLoader::~VMDLoader() noexcept
+	{
+	}
+
+	bool
+	VMDLoader::doCanRead(io::istream& stream) noexcept
+	{
+		static_assert(sizeof(VMDMotion) == 111, "");
+		static_assert(sizeof(VMDMorph) == 23, "");
+		static_assert(sizeof(VMDCamera) == 61, "");
+		static_assert(sizeof(VMDLight) == 28, "");
+		static_assert(sizeof(VMDSelfShadow) == 9, "");
+
+		VMD_Header hdr;
+
+		if (stream.read((char*)&hdr, sizeof(hdr)))
+		{
+			if (std::strncmp(hdr.magic, "Vocaloid Motion Data 0002", 30) == 0)
+				return true;
+		}
+
+		return false;
+	}
+
+	bool
+	VMDLoader::doCanRead(const char* type) noexcept
+	{
+		return std::strncmp(type, "vmd", 3) == 0;
+	}
+
+	animation::Animation<float>
+	VMDLoader::load(io::istream& stream) noexcept(false)
+	{
+		VMD vmd;
+		readVMD(stream, vmd);
+
+		CharsetConverter converter("utf-8", "SJIS");
+		VMDInterpolatorCache interpolators;
+
+		return buildMotion(vmd, converter, interpolators);
+	}
+
 	void
-	VMDLoader::save(io::ostream& stream, const animation::Animation<float>& animation) noexcept(false)
+	VMDLoader::load(io::istream& stream, animation::Animation<float>& motion, animation::Animation<float>& morph, animation::Animation<float>& camera, animation::Animation<float>& light) noexcept(false)
 	{
 		VMD vmd;
-		std::memset(&vmd.Header, 0, sizeof(vmd.Header));
-		std::memcpy(vmd.Header.magic, "Vocaloid Motion Data 0002", 15);
+		readVMD(stream, vmd);
+
+		CharsetConverter converter("utf-8", "SJIS");
+		VMDInterpolatorCache interpolators;
+
+		motion = buildMotion(vmd, converter, interpolators);
+		morph = buildMorph(vmd, converter);
+		camera = buildCamera(vmd, interpolators);
+		light = buildLight(vmd);
+	}
+
+	void
+	VMDLoader::save(io::ostream& stream, const animation::Animation<float>& animation) noexcept(false)
+	{
+		animation::Animation<float> empty;
+		save(stream, animation, empty, empty, empty);
+	}
+
+	void
+	VMDLoader::save(io::ostream& stream, const animation::Animation<float>& motion, const animation::Animation<float>& morph, const animation::Animation<float>& camera, const animation::Animation<float>& light, float tolerance) noexcept(false)
+	{
+		CharsetConverter converter("SJIS", "utf-8");
+
+		VMD_Header header;
+		std::memset(&header, 0, sizeof(header));
+		std::memcpy(header.magic, "Vocaloid Motion Data 0002", 25);
+
+		// MMD expects this model name for files that only carry camera and light keys.
+		if (motion.clips.empty() && morph.clips.empty())
+			std::memcpy(header.name, "\x83\x4a\x83\x81\x83\x89\x81\x45\x8f\xc6\x96\xbe", 12);
+		else
+			encodeName(converter, motion.name, header.name, sizeof(header.name));
+
+		if (!stream.write((char*)&header, sizeof(header)))
+			throw runtime::runtime_error::create(R"(Cannot write property "Header" to stream)");
 
-		stream.write((char*)&vmd.Header, sizeof(vmd.Header));
+		writeMotion(stream, motion, converter, tolerance);
+		writeMorph(stream, morph, converter, tolerance);
+		writeCamera(stream, camera, tolerance);
+		writeLight(stream, light, tolerance);
+		writeSection(stream, std::vector<VMDSelfShadow>(), "VMDSelfShadow");
 	}
-}
\ No newline at end of file
+}